@@ -0,0 +1,44 @@
+/**
+ * @file CoalescerPairCheck.cpp
+ * @author Gabriel Nicolás González Ferreira (gabrielinuz@fi.mdp.edu.ar)
+ * @brief Comprobación de regresión de CcCoalescer: un LSB suelto que pasa a un par de 14 bits, en JSON.
+ * @details Secuencia: CC 1 = 11 y CC 33 = 21 sueltos (el LSB reserva su propio lugar, como cuando
+ * filterChanged() envía un LSB cuyo MSB no cambió) y luego pushPair(CC 1 = 12, CC 33 = 22) antes
+ * del siguiente pop(). Debe salir exactamente "CC 1 = 12, CC 33 = 22"; antes de la corrección el
+ * lugar sobrante del LSB emitía además CC 33 = 127 (NO_VALUE). Termina con 1 si falla.
+ *
+ * Uso: coalescer-pair-check > resultados.json
+ * @version 2.8
+ * @date 2026-10-16
+ * @copyright Copyright (c) 2025. This project is released under the Apache License.
+ * @link http://www.apache.org/licenses/LICENSE-2.0
+ */
+#include "CcCoalescer.hpp"
+#include <cstdio>
+
+int main()
+{
+    CcCoalescer coalescer;
+    coalescer.push(MidiMessage::controlChange(0, 1, 11), false);
+    coalescer.push(MidiMessage::controlChange(0, 33, 21), false);
+    coalescer.pushPair(MidiMessage::controlChange(0, 1, 12), MidiMessage::controlChange(0, 33, 22), false);
+
+    const unsigned char expected[][2] = {{1, 12}, {33, 22}};
+    const std::size_t expectedCount = sizeof(expected) / sizeof(expected[0]);
+
+    std::printf("{\n  \"check\": \"coalescer_lsb_joins_pair\",\n  \"output\": [");
+    MidiMessage out[CcCoalescer::MAX_POP];
+    std::size_t total = 0;
+    bool ok = true;
+    for (std::size_t count = coalescer.pop(out); count > 0; count = coalescer.pop(out))
+    {
+        for (std::size_t i = 0; i < count; ++i, ++total)
+        {
+            std::printf("%s{\"cc\": %u, \"value\": %u}", total ? ", " : "", out[i].bytes[1], out[i].bytes[2]);
+            ok = ok && total < expectedCount && out[i].bytes[1] == expected[total][0] && out[i].bytes[2] == expected[total][1];
+        }
+    }
+    ok = ok && total == expectedCount && !coalescer.hasPending();
+    std::printf("],\n  \"ok\": %s\n}\n", ok ? "true" : "false");
+    return ok ? 0 : 1;
+}
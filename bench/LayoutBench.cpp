@@ -0,0 +1,284 @@
+/**
+ * @file LayoutBench.cpp
+ * @author Gabriel Nicolás González Ferreira (gabrielinuz@fi.mdp.edu.ar)
+ * @brief Benchmark de carga de layouts y presets: tiempo, pico de memoria y reservas, en JSON.
+ * @details Genera layouts sintéticos de 100, 1000 y 10000 filas (con BOM en la cabecera,
+ * como el layout de gs-music-apollo) y un preset por layout. Mide:
+ *  - layout_parse:    MidiLayoutParser::parse()
+ *  - preset_load:     MidiPresetParser::load()
+ *  - preset_save:     MidiPresetParser::save()
+ *  - widgets_eager:   la construcción de widgets de loadMidiLayoutFromFile() con Fl_Scroll
+ *  - widgets_virtual: la misma carga con VirtualControlList
+ *
+ * Los widgets se construyen sin mostrarse nunca, así que FLTK no abre conexión con el
+ * servidor gráfico y el benchmark corre sin display. Cada caso se ejecuta en un proceso
+ * hijo (fork) para que el pico de RSS sea el de ese caso y no el de los anteriores.
+ *
+ * Uso: layout-bench [repeticiones] [directorio-temporal] > resultados.json
+ * @version 1.6
+ * @date 2026-10-16
+ * @copyright Copyright (c) 2025. This project is released under the Apache License.
+ * @link http://www.apache.org/licenses/LICENSE-2.0
+ */
+#include "MidiLayoutParser.hpp"
+#include "MidiPresetParser.hpp"
+#include "ParameterStore.hpp"
+#include "SliderControl.hpp"
+#include "VirtualControlList.hpp"
+#include <FL/Fl_Group.H>
+#include <FL/Fl_Scroll.H>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <memory>
+#include <new>
+#include <string>
+#include <vector>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+// --- Contador global de reservas: se reemplaza operator new para contar cada malloc. ---
+// GCC ve el malloc/free de estos reemplazos al inlinearlos y los toma por un new/free mezclado.
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+static std::atomic<unsigned long> g_allocations{0};
+static std::atomic<unsigned long> g_allocatedBytes{0};
+
+void* operator new(std::size_t size)
+{
+    g_allocations.fetch_add(1, std::memory_order_relaxed);
+    g_allocatedBytes.fetch_add(size, std::memory_order_relaxed);
+    if (void* p = std::malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+
+/** @brief Resultado de un caso, acumulado sobre todas las repeticiones. */
+struct CaseResult
+{
+    double minMs = 0.0;
+    double meanMs = 0.0;
+    unsigned long allocations = 0;    ///< Por repetición.
+    unsigned long allocatedBytes = 0; ///< Por repetición.
+};
+
+/** @brief Escribe un layout sintético: cabecera con BOM y @p rows filas válidas. */
+static void writeLayout(const std::string& path, std::size_t rows)
+{
+    std::ofstream file(path, std::ios::binary);
+    file << "\xEF\xBB\xBF" << "Description;CC#;Range\r\n";
+    for (std::size_t i = 0; i < rows; ++i)
+    {
+        file << "Parameter " << i << ";" << (i % 128) << ";0-" << (64 + i % 64) << "\r\n";
+    }
+}
+
+/** @brief Escribe un preset sintético con una fila por CC. */
+static void writePreset(const std::string& path, std::size_t rows)
+{
+    std::ofstream file(path, std::ios::binary);
+    file << "CC#;Value;Active\n";
+    for (std::size_t i = 0; i < rows; ++i)
+    {
+        file << (i % 128) << ";" << (i * 7 % 128) << ";" << (i % 5 != 0 ? 1 : 0) << "\n";
+    }
+}
+
+/**
+ * @brief Ejecuta @p body @p repetitions veces y mide tiempo y reservas.
+ * @details @p body devuelve los milisegundos de su zona medida; las reservas se cuentan
+ * sobre toda la repetición, incluida la liberación de lo construido.
+ */
+static CaseResult runCase(unsigned repetitions, const std::function<double()>& body)
+{
+    CaseResult result;
+    double totalMs = 0.0;
+    for (unsigned r = 0; r < repetitions; ++r)
+    {
+        const unsigned long allocsBefore = g_allocations.load();
+        const unsigned long bytesBefore = g_allocatedBytes.load();
+        const double ms = body();
+        result.allocations = g_allocations.load() - allocsBefore;
+        result.allocatedBytes = g_allocatedBytes.load() - bytesBefore;
+        totalMs += ms;
+        result.minMs = (r == 0 || ms < result.minMs) ? ms : result.minMs;
+    }
+    result.meanMs = totalMs / repetitions;
+    return result;
+}
+
+/** @brief Milisegundos transcurridos desde @p start. */
+static double elapsedMs(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+/** @brief Llena un almacén a partir del layout, como lo hace loadMidiLayoutFromFile(). */
+static std::shared_ptr<ParameterStore> loadStore(const std::string& layoutPath)
+{
+    std::vector<SliderConfig> configs;
+    MidiLayoutParser::parse(layoutPath, configs);
+    auto store = std::make_shared<ParameterStore>();
+    for (const auto& config : configs)
+    {
+        store->add(config);
+    }
+    return store;
+}
+
+/** @brief Ejecuta el caso @p name; corre en el proceso hijo. */
+static CaseResult runNamedCase(const std::string& name, unsigned repetitions,
+                               const std::string& layoutPath, const std::string& presetPath,
+                               const std::string& savePath)
+{
+    unsigned char channel = 0;
+
+    if (name == "layout_parse")
+    {
+        return runCase(repetitions, [&]() {
+            std::vector<SliderConfig> configs;
+            const auto start = std::chrono::steady_clock::now();
+            MidiLayoutParser::parse(layoutPath, configs);
+            return elapsedMs(start);
+        });
+    }
+    if (name == "preset_load")
+    {
+        return runCase(repetitions, [&]() {
+            PresetImage preset;
+            const auto start = std::chrono::steady_clock::now();
+            MidiPresetParser::load(presetPath, preset);
+            return elapsedMs(start);
+        });
+    }
+    if (name == "preset_save")
+    {
+        auto store = loadStore(layoutPath);
+        return runCase(repetitions, [&]() {
+            const auto start = std::chrono::steady_clock::now();
+            MidiPresetParser::save(savePath, *store);
+            return elapsedMs(start);
+        });
+    }
+    if (name == "widgets_eager")
+    {
+        auto store = loadStore(layoutPath);
+        return runCase(repetitions, [&]() {
+            // Mismo camino que loadMidiLayoutFromFile() para layouts chicos.
+            std::vector<std::unique_ptr<SliderControl>> controls;
+            const auto start = std::chrono::steady_clock::now();
+            auto* scroll = new Fl_Scroll(10, 150, 580, 600);
+            scroll->type(Fl_Scroll::VERTICAL);
+            int y = 0;
+            for (std::size_t i = 0; i < store->size(); ++i)
+            {
+                auto control = std::make_unique<SliderControl>(store, i, nullptr);
+                control->createWidgets(10, y, scroll->w() - 20, 45, &channel);
+                controls.push_back(std::move(control));
+                y += 50;
+            }
+            scroll->end();
+            scroll->init_sizes();
+            const double ms = elapsedMs(start);
+            delete scroll;
+            return ms;
+        });
+    }
+    if (name == "widgets_virtual")
+    {
+        auto store = loadStore(layoutPath);
+        return runCase(repetitions, [&]() {
+            const auto start = std::chrono::steady_clock::now();
+            auto* list = new VirtualControlList(10, 150, 580, 600, store, nullptr, &channel);
+            list->reload();
+            const double ms = elapsedMs(start);
+            delete list;
+            return ms;
+        });
+    }
+    return CaseResult{};
+}
+
+int main(int argc, char** argv)
+{
+    unsigned repetitions = (argc > 1) ? static_cast<unsigned>(std::strtoul(argv[1], nullptr, 10)) : 5;
+    if (repetitions == 0) repetitions = 1;
+    const std::string dir = (argc > 2) ? argv[2] : "/tmp";
+
+    const std::size_t sizes[] = {100, 1000, 10000};
+    const char* cases[] = {"layout_parse", "preset_load", "preset_save", "widgets_eager", "widgets_virtual"};
+
+    std::printf("{\n  \"benchmark\": \"layout\",\n  \"repetitions\": %u,\n  \"results\": [", repetitions);
+    bool first = true;
+
+    for (std::size_t rows : sizes)
+    {
+        const std::string tag = dir + "/mccc-bench-" + std::to_string(rows);
+        const std::string layoutPath = tag + "-layout.csv";
+        const std::string presetPath = tag + "-preset.csv";
+        const std::string savePath = tag + "-saved.csv";
+        writeLayout(layoutPath, rows);
+        writePreset(presetPath, rows);
+
+        for (const char* name : cases)
+        {
+            int fds[2];
+            if (pipe(fds) != 0)
+            {
+                std::perror("pipe");
+                return 1;
+            }
+            std::fflush(stdout);
+            const pid_t pid = fork();
+            if (pid == 0)
+            {
+                close(fds[0]);
+                if (!std::freopen("/dev/null", "w", stderr)) // Las advertencias de los parsers no interesan aquí.
+                {
+                    _exit(1);
+                }
+                const CaseResult r = runNamedCase(name, repetitions, layoutPath, presetPath, savePath);
+                struct rusage usage;
+                getrusage(RUSAGE_SELF, &usage);
+                char line[512];
+                const int length = std::snprintf(line, sizeof(line),
+                    "{\"case\": \"%s\", \"rows\": %zu, \"wall_ms_min\": %.4f, \"wall_ms_mean\": %.4f, "
+                    "\"allocations\": %lu, \"allocated_bytes\": %lu, \"peak_rss_kb\": %ld}",
+                    name, rows, r.minMs, r.meanMs, r.allocations, r.allocatedBytes, usage.ru_maxrss);
+                const ssize_t written = write(fds[1], line, static_cast<std::size_t>(length));
+                _exit(written == length ? 0 : 1);
+            }
+            close(fds[1]);
+
+            std::string json;
+            char buffer[512];
+            ssize_t n;
+            while ((n = read(fds[0], buffer, sizeof(buffer))) > 0)
+            {
+                json.append(buffer, static_cast<std::size_t>(n));
+            }
+            close(fds[0]);
+            int status = 0;
+            waitpid(pid, &status, 0);
+            if (!WIFEXITED(status) || WEXITSTATUS(status) != 0 || json.empty())
+            {
+                std::fprintf(stderr, "layout-bench: case %s (%zu rows) failed\n", name, rows);
+                continue;
+            }
+            std::printf("%s\n    %s", first ? "" : ",", json.c_str());
+            first = false;
+        }
+
+        std::remove(layoutPath.c_str());
+        std::remove(presetPath.c_str());
+        std::remove(savePath.c_str());
+    }
+
+    std::printf("\n  ]\n}\n");
+    return 0;
+}
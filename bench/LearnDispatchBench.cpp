@@ -0,0 +1,138 @@
+/**
+ * @file LearnDispatchBench.cpp
+ * @author Gabriel Nicolás González Ferreira (gabrielinuz@fi.mdp.edu.ar)
+ * @brief Benchmark del despacho de MIDI Learn: tabla 16x128 vs búsqueda lineal, en JSON.
+ * @details Para layouts de 100, 1000 y 10000 filas asocia una perilla (canal, CC) a cada
+ * fila (hasta las 2048 combinaciones posibles) y despacha un millón de CC recibidos:
+ *  - table:  ParameterSync::apply() con MidiLearnMap (un acceso a arreglo por evento).
+ *  - linear: recorrer la lista de bindings hasta encontrar el (canal, CC), como haría
+ *            un despacho que pregunta a cada control si la perilla es suya.
+ * Los dos casos escriben el valor en el ParameterStore y marcan la fila; el de la tabla
+ * corre sin MidiService, así que no se mide el envío.
+ *
+ * Uso: learn-dispatch-bench [repeticiones] > resultados.json
+ * @version 2.4
+ * @date 2026-10-16
+ * @copyright Copyright (c) 2025. This project is released under the Apache License.
+ * @link http://www.apache.org/licenses/LICENSE-2.0
+ */
+#include "MidiLearnMap.hpp"
+#include "ParameterStore.hpp"
+#include "ParameterSync.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <string>
+#include <vector>
+
+/// @brief Eventos despachados por repetición.
+static constexpr std::size_t EVENTS = 1000000;
+
+/// @brief Un binding tal como lo guardaría cada control en un despacho sin tabla.
+struct LinearBinding
+{
+    unsigned char channel;
+    unsigned char cc;
+    std::size_t row;
+};
+
+/** @brief Nanosegundos por evento de la mejor repetición de @p body. */
+template <typename Body>
+static double bestNsPerEvent(unsigned repetitions, Body body)
+{
+    double best = 0.0;
+    for (unsigned r = 0; r < repetitions; ++r)
+    {
+        const auto start = std::chrono::steady_clock::now();
+        body();
+        const double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / EVENTS;
+        best = (r == 0 || ns < best) ? ns : best;
+    }
+    return best;
+}
+
+int main(int argc, char** argv)
+{
+    unsigned repetitions = (argc > 1) ? static_cast<unsigned>(std::strtoul(argv[1], nullptr, 10)) : 5;
+    if (repetitions == 0) repetitions = 1;
+
+    const std::size_t sizes[] = {100, 1000, 10000};
+
+    std::printf("{\n  \"benchmark\": \"learn_dispatch\",\n  \"events\": %zu,\n  \"repetitions\": %u,\n  \"results\": [",
+                EVENTS, repetitions);
+    bool first = true;
+
+    for (std::size_t rows : sizes)
+    {
+        auto store = std::make_shared<ParameterStore>();
+        for (std::size_t i = 0; i < rows; ++i)
+        {
+            SliderConfig config;
+            config.description = "Parameter " + std::to_string(i);
+            config.cc_number = static_cast<int>(i % 128);
+            config.min_value = 0;
+            config.max_value = 127;
+            store->add(config);
+        }
+
+        auto learnMap = std::make_shared<MidiLearnMap>();
+        std::vector<LinearBinding> linear;
+        const std::size_t bound = std::min(rows, MidiLearnMap::KEYS);
+        for (std::size_t i = 0; i < bound; ++i)
+        {
+            const auto channel = static_cast<unsigned char>(i / 128);
+            const auto cc = static_cast<unsigned char>(i % 128);
+            learnMap->bind(channel, cc, i);
+            linear.push_back({channel, cc, i});
+        }
+
+        // Perillas pseudoaleatorias entre las asociadas: el mismo flujo para los dos casos.
+        std::vector<MidiInputEvent> events(EVENTS);
+        unsigned seed = 12345;
+        for (std::size_t i = 0; i < EVENTS; ++i)
+        {
+            seed = seed * 1103515245u + 12345u;
+            const std::size_t key = (seed >> 8) % bound;
+            events[i].timestampNs = static_cast<std::int64_t>(i);
+            events[i].message = MidiMessage::controlChange(static_cast<unsigned char>(key / 128),
+                                                           static_cast<unsigned char>(key % 128),
+                                                           static_cast<unsigned char>(i & 0x7F));
+        }
+
+        ParameterSync sync(store, nullptr);
+        sync.setLearnMap(learnMap);
+        std::vector<std::size_t> dirtyRows;
+        const double tableNs = bestNsPerEvent(repetitions, [&]() {
+            sync.apply(events.data(), events.size(), 0);
+            sync.takeDirtyRows(dirtyRows);
+        });
+
+        std::vector<unsigned char> dirty(rows, 0);
+        const double linearNs = bestNsPerEvent(repetitions, [&]() {
+            for (const MidiInputEvent& event : events)
+            {
+                const unsigned char channel = event.message.status() & 0x0F;
+                const unsigned char cc = event.message.bytes[1];
+                for (const LinearBinding& binding : linear)
+                {
+                    if (binding.channel == channel && binding.cc == cc)
+                    {
+                        store->setValue(binding.row, event.message.bytes[2]);
+                        dirty[binding.row] = 1;
+                        break;
+                    }
+                }
+            }
+        });
+
+        std::printf("%s\n    {\"rows\": %zu, \"bindings\": %zu, \"table_ns_per_event\": %.2f, "
+                    "\"linear_ns_per_event\": %.2f, \"speedup\": %.1f}",
+                    first ? "" : ",", rows, bound, tableNs, linearNs, linearNs / tableNs);
+        first = false;
+    }
+
+    std::printf("\n  ]\n}\n");
+    return 0;
+}
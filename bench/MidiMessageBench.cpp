@@ -0,0 +1,84 @@
+/**
+ * @file MidiMessageBench.cpp
+ * @author Gabriel Nicolás González Ferreira (gabrielinuz@fi.mdp.edu.ar)
+ * @brief Micro-benchmark de reservas de memoria por mensaje CC: std::vector vs MidiMessage.
+ * @version 0.8
+ * @date 2026-10-16
+ * @copyright Copyright (c) 2025. This project is released under the Apache License.
+ * @link http://www.apache.org/licenses/LICENSE-2.0
+ */
+#include "MidiMessage.hpp"
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <vector>
+
+// --- Contador global de reservas: se reemplaza operator new para contar cada malloc. ---
+static std::atomic<unsigned long> g_allocations{0};
+
+void* operator new(std::size_t size)
+{
+    g_allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+
+// Sumidero con la misma firma que RtMidiOut::sendMessage(const unsigned char*, size_t).
+// Es volatile para que el compilador no elimine el trabajo del bucle.
+static volatile unsigned long g_sink = 0;
+
+static void sink(const unsigned char* message, std::size_t size)
+{
+    for (std::size_t i = 0; i < size; ++i) g_sink = g_sink + message[i];
+}
+
+/** @brief Camino anterior: un std::vector en el heap por cada Control Change. */
+static void sendWithVector(unsigned char channel, unsigned char cc, unsigned char value)
+{
+    std::vector<unsigned char> message;
+    message.push_back(0xB0 | channel);
+    message.push_back(cc);
+    message.push_back(value);
+    sink(&message[0], message.size());
+}
+
+/** @brief Camino nuevo: MidiMessage en la pila. */
+static void sendWithMidiMessage(unsigned char channel, unsigned char cc, unsigned char value)
+{
+    const MidiMessage message = MidiMessage::controlChange(channel, cc, value);
+    sink(message.data(), message.size());
+}
+
+template <typename SendFn>
+static void run(const char* name, SendFn send, unsigned long iterations)
+{
+    unsigned long before = g_allocations.load();
+    auto start = std::chrono::steady_clock::now();
+
+    // Simula un arrastre de slider sobre 16 CCs en todos los canales.
+    for (unsigned long i = 0; i < iterations; ++i)
+    {
+        send(static_cast<unsigned char>(i & 0x0F), static_cast<unsigned char>((i >> 4) & 0x0F), static_cast<unsigned char>(i & 0x7F));
+    }
+
+    auto elapsed = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+    unsigned long allocations = g_allocations.load() - before;
+
+    std::printf("%-14s %10lu msgs  %8.3f allocs/msg  %8.2f ns/msg\n",
+                name, iterations, double(allocations) / iterations, elapsed / iterations);
+}
+
+int main(int argc, char** argv)
+{
+    unsigned long iterations = (argc > 1) ? std::strtoul(argv[1], nullptr, 10) : 1000000UL;
+    if (iterations == 0) iterations = 1;
+
+    run("std::vector", sendWithVector, iterations);
+    run("MidiMessage", sendWithMidiMessage, iterations);
+    return 0;
+}
@@ -0,0 +1,89 @@
+/**
+ * @file NrpnBench.cpp
+ * @author Gabriel Nicolás González Ferreira (gabrielinuz@fi.mdp.edu.ar)
+ * @brief Benchmark de bytes en el cable al arrastrar un NRPN: dirección siempre vs dirección recordada, en JSON.
+ * @details Simula el arrastre de un slider NRPN (un valor por cuadro) y lo codifica como lo hace
+ * el hilo de salida de MidiService (NrpnEncoder + OutputScheduler, con running status):
+ *  - full:   la dirección (CC 99/98) se repite en cada valor, como un envío sin estado.
+ *  - cached: NrpnEncoder omite la dirección mientras el parámetro siga seleccionado.
+ * Cada caso se mide con una ráfaga por valor (arrastre lento, cada valor sale solo) y con todos
+ * los valores en una sola ráfaga (el límite de running status), para datos de 7 y de 14 bits.
+ *
+ * Uso: nrpn-bench [valores] > resultados.json
+ * @version 2.9
+ * @date 2026-10-16
+ * @copyright Copyright (c) 2025. This project is released under the Apache License.
+ * @link http://www.apache.org/licenses/LICENSE-2.0
+ */
+#include "NrpnEncoder.hpp"
+#include "OutputScheduler.hpp"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+
+/**
+ * @brief Bytes que ocupa en el cable el arrastre de @p values valores de un mismo NRPN.
+ * @param values Cantidad de valores enviados.
+ * @param highResolution true para datos de 14 bits (CC 6 y 38).
+ * @param cached false para olvidar la dirección antes de cada valor.
+ * @param burstPerValue true para abrir una ráfaga (y reiniciar el running status) por valor.
+ */
+static std::size_t dragBytes(std::size_t values, bool highResolution, bool cached, bool burstPerValue)
+{
+    NrpnEncoder encoder;
+    OutputScheduler scheduler;
+    scheduler.setByteRate(0); // Solo se cuentan bytes; sin límite de tasa.
+    scheduler.beginBurst(OutputScheduler::Clock::now());
+
+    NrpnMessage message;
+    message.number = 1234;
+    message.highResolution = highResolution;
+
+    unsigned char buffer[NrpnEncoder::MAX_MESSAGES * MidiMessage::MAX_SIZE];
+    std::size_t bytes = 0;
+    for (std::size_t i = 0; i < values; ++i)
+    {
+        if (!cached)
+        {
+            encoder.reset();
+        }
+        if (burstPerValue)
+        {
+            scheduler.beginBurst(OutputScheduler::Clock::now());
+        }
+        message.value = static_cast<std::uint16_t>(highResolution ? (i * 37) & 0x3FFF : i & 0x7F);
+
+        MidiMessage encoded[NrpnEncoder::MAX_MESSAGES];
+        const std::size_t count = encoder.encode(message, encoded);
+        for (std::size_t m = 0; m < count; ++m)
+        {
+            bytes += scheduler.encode(encoded[m], buffer);
+        }
+    }
+    return bytes;
+}
+
+int main(int argc, char** argv)
+{
+    std::size_t values = (argc > 1) ? static_cast<std::size_t>(std::strtoul(argv[1], nullptr, 10)) : 1000;
+    if (values == 0) values = 1;
+
+    std::printf("{\n  \"benchmark\": \"nrpn_address_cache\",\n  \"values\": %zu,\n  \"results\": [", values);
+    bool first = true;
+    for (bool highResolution : {false, true})
+    {
+        for (bool burstPerValue : {true, false})
+        {
+            const std::size_t full = dragBytes(values, highResolution, false, burstPerValue);
+            const std::size_t cached = dragBytes(values, highResolution, true, burstPerValue);
+            std::printf("%s\n    {\"data_bits\": %d, \"bursts\": \"%s\", \"full_bytes\": %zu, \"cached_bytes\": %zu, "
+                        "\"bytes_per_value_full\": %.2f, \"bytes_per_value_cached\": %.2f, \"saved_percent\": %.1f}",
+                        first ? "" : ",", highResolution ? 14 : 7, burstPerValue ? "per_value" : "single",
+                        full, cached, static_cast<double>(full) / values, static_cast<double>(cached) / values,
+                        100.0 * (1.0 - static_cast<double>(cached) / full));
+            first = false;
+        }
+    }
+    std::printf("\n  ]\n}\n");
+    return 0;
+}
@@ -0,0 +1,97 @@
+#!/bin/bash
+
+# Compila los micro-benchmarks de ./bench en ./bin/bench/ (con -O2, igual que build.sh).
+mkdir -p ./bin/bench
+
+g++ \
+-std=c++17 \
+-O2 \
+-Wall \
+-I./include \
+./bench/MidiMessageBench.cpp \
+-o ./bin/bench/midi-message-bench
+
+# @version 1.6: Benchmark de carga de layouts/presets (salida JSON). Enlaza como build.sh.
+g++ \
+-std=c++17 \
+-O2 \
+-Wall \
+-ldl \
+-I./include \
+-I./include/vendors/fltk/include \
+-I./include/vendors/rtmidi/include \
+-L./include/vendors/fltk/lib/ \
+-L./include/vendors/rtmidi/lib/ \
+./bench/LayoutBench.cpp \
+./src/CcCoalescer.cpp \
+./src/MappedFile.cpp \
+./src/MidiLayoutParser.cpp \
+./src/MidiLearnMap.cpp \
+./src/MidiPresetParser.cpp \
+./src/MidiService.cpp \
+./src/NrpnEncoder.cpp \
+./src/OutputScheduler.cpp \
+./src/ParameterStore.cpp \
+./src/SliderControl.cpp \
+./src/Utils.cpp \
+./src/VirtualControlList.cpp \
+./include/vendors/rtmidi/src/RtMidi.cpp \
+-o ./bin/bench/layout-bench \
+-D__LINUX_ALSA__ \
+-DRTMIDI_API_ALSA=ON \
+-DRTMIDI_API_JACK=OFF \
+-DRTMIDI_API_PULSE=OFF \
+-lfltk \
+-lrtmidi \
+-lasound \
+-lpthread
+
+# @version 2.4: Despacho de MIDI Learn, tabla 16x128 vs búsqueda lineal (salida JSON).
+g++ \
+-std=c++17 \
+-O2 \
+-Wall \
+-ldl \
+-I./include \
+-I./include/vendors/rtmidi/include \
+-L./include/vendors/rtmidi/lib/ \
+./bench/LearnDispatchBench.cpp \
+./src/CcCoalescer.cpp \
+./src/MappedFile.cpp \
+./src/MidiLearnMap.cpp \
+./src/MidiService.cpp \
+./src/NrpnEncoder.cpp \
+./src/OutputScheduler.cpp \
+./src/ParameterStore.cpp \
+./src/ParameterSync.cpp \
+./src/Utils.cpp \
+./include/vendors/rtmidi/src/RtMidi.cpp \
+-o ./bin/bench/learn-dispatch-bench \
+-D__LINUX_ALSA__ \
+-DRTMIDI_API_ALSA=ON \
+-DRTMIDI_API_JACK=OFF \
+-DRTMIDI_API_PULSE=OFF \
+-lrtmidi \
+-lasound \
+-lpthread
+
+# @version 2.9: Bytes por valor al arrastrar un NRPN, con y sin la dirección recordada (salida JSON).
+g++ \
+-std=c++17 \
+-O2 \
+-Wall \
+-I./include \
+./bench/NrpnBench.cpp \
+./src/NrpnEncoder.cpp \
+./src/OutputScheduler.cpp \
+-o ./bin/bench/nrpn-bench
+
+# Comprobación de regresión de CcCoalescer (LSB suelto que pasa a un par de 14 bits); sale con 1 si falla.
+g++ \
+-std=c++17 \
+-O2 \
+-Wall \
+-I./include \
+./bench/CoalescerPairCheck.cpp \
+./src/CcCoalescer.cpp \
+-o ./bin/bench/coalescer-pair-check
@@ -2,6 +2,7 @@
 
 g++ \
 -std=c++17 \
+-O2 \
 -Wall \
 -ldl \
 -I./include \
@@ -11,11 +12,30 @@ g++ \
 -L./include/vendors/fltk/lib/ \
 -L./include/vendors/rtmidi/lib/ \
 ./src/Application.cpp \
+./src/CcCoalescer.cpp \
+./src/HeadlessRunner.cpp \
+./src/DumpRequestEngine.cpp \
+./src/LatencyHistogram.cpp \
+./src/MappedFile.cpp \
 ./src/MidiLayoutParser.cpp \
 ./src/MidiPresetParser.cpp \
+./src/MidiSessionParser.cpp \
 ./src/MainWindow.cpp \
+./src/MidiInputService.cpp \
+./src/MidiLearnMap.cpp \
+./src/MidiThruRouter.cpp \
 ./src/MidiService.cpp \
+./src/MorphEngine.cpp \
+./src/NrpnEncoder.cpp \
+./src/ParameterStore.cpp \
+./src/ParameterSync.cpp \
+./src/PresetBank.cpp \
+./src/VirtualControlList.cpp \
+./src/XYPadControl.cpp \
+./src/OutputScheduler.cpp \
 ./src/SliderControl.cpp \
+./src/SysExDumpTemplate.cpp \
+./src/SysExQueue.cpp \
 ./src/Utils.cpp \
 ./src/main.cpp \
 ./include/vendors/rtmidi/src/RtMidi.cpp \
@@ -28,3 +48,34 @@ g++ \
 -lrtmidi \
 -lasound \
 -lpthread
+
+# @version 3.2: mccc-headless: el modo --headless sin la GUI, para servidores sin X (no enlaza FLTK).
+g++ \
+-std=c++17 \
+-O2 \
+-Wall \
+-ldl \
+-I./include \
+-I./include/vendors/rtmidi/include \
+-L./include/vendors/rtmidi/lib/ \
+./src/CcCoalescer.cpp \
+./src/HeadlessRunner.cpp \
+./src/MappedFile.cpp \
+./src/MidiLayoutParser.cpp \
+./src/MidiPresetParser.cpp \
+./src/MidiService.cpp \
+./src/NrpnEncoder.cpp \
+./src/OutputScheduler.cpp \
+./src/ParameterStore.cpp \
+./src/Utils.cpp \
+./src/main.cpp \
+./include/vendors/rtmidi/src/RtMidi.cpp \
+-o ./bin/mccc-headless \
+-DMCCC_HEADLESS_ONLY \
+-D__LINUX_ALSA__ \
+-DRTMIDI_API_ALSA=ON \
+-DRTMIDI_API_JACK=OFF \
+-DRTMIDI_API_PULSE=OFF \
+-lrtmidi \
+-lasound \
+-lpthread
@@ -11,7 +11,10 @@
 
 #include "MainWindow.hpp"
 #include "MidiService.hpp"
+#include "MidiInputService.hpp"
+#include "ISessionHost.hpp" // @version 2.6: Sesiones de varios dispositivos
 #include <memory>
+#include <vector>
 
 /**
  * @class Application
@@ -19,8 +22,12 @@
  * @details Su responsabilidad es crear y conectar los componentes principales
  * (como el MidiService y la MainWindow) y iniciar el bucle de eventos.
  * Esto mantiene la función `main()` extremadamente simple.
+ * @version 2.6: Sesiones multi-dispositivo. Cada ventana de dispositivo adicional tiene su propio
+ * MidiService, es decir su propio RtMidiOut, su cola, su coalescer, su OutputScheduler (la tasa
+ * del cable es de cada puerto) y su hilo de salida: los puertos transmiten en paralelo y un
+ * puerto lento solo frena su propia cola. La entrada MIDI queda en la ventana principal.
  */
-class Application 
+class Application : public ISessionHost
 {
     public:
         /**
@@ -37,10 +44,31 @@ class Application
         */
         int run(int argc, char** argv);
 
+        /// --- @version 2.6: ISessionHost ---
+        void addDeviceWindow() override;
+        int openSession(const std::string& filename) override;
+        int saveSession(const std::string& filename) override;
+
     private:
         /// @brief Puntero compartido al servicio MIDI, que será inyectado en otras clases.
         std::shared_ptr<MidiService> m_midiService;
 
+        /// @brief @version 2.2: Servicio de entrada MIDI, compartido con la ventana.
+        std::shared_ptr<MidiInputService> m_midiInput;
+
         /// @brief Puntero único a la ventana principal. La aplicación es dueña de la ventana.
         std::unique_ptr<MainWindow> m_mainWindow;
+
+        /// @brief @version 2.6: Una ventana de dispositivo adicional y su servicio de salida propio.
+        struct DeviceWindow
+        {
+            std::shared_ptr<MidiService> midiService;
+            std::unique_ptr<MainWindow> window;
+        };
+
+        /// @brief @version 2.6: Dispositivos 2..N de la sesión, en orden de creación.
+        std::vector<DeviceWindow> m_deviceWindows;
+
+        /** @brief @version 2.6: Crea y muestra la ventana del dispositivo número @p number (desde 2). */
+        MainWindow& createDeviceWindow(std::size_t number);
 };
\ No newline at end of file
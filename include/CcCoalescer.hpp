@@ -0,0 +1,131 @@
+/**
+ * @file CcCoalescer.hpp
+ * @author Gabriel Nicolás González Ferreira (gabrielinuz@fi.mdp.edu.ar)
+ * @brief Etapa de coalescencia de mensajes Control Change por (canal, CC).
+ * @version 2.8
+ * @date 2026-10-16
+ * @copyright Copyright (c) 2025. This project is released under the Apache License.
+ * @link http://www.apache.org/licenses/LICENSE-2.0
+ */
+#pragma once
+
+#include "MidiMessage.hpp"
+#include <array>
+#include <atomic>
+#include <cstddef>
+
+/**
+ * @class CcCoalescer
+ * @brief Conserva solo el valor pendiente más reciente de cada (canal, CC).
+ * @details Al arrastrar un slider, FLTK dispara un callback por cada movimiento del mouse.
+ * Si los mensajes llegan más rápido de lo que el puerto puede transmitirlos, esta etapa
+ * descarta los valores intermedios (solo importa el último) y omite los envíos cuyo
+ * valor coincide con el último transmitido. El orden de salida respeta el orden en que
+ * cada (canal, CC) quedó pendiente por primera vez.
+ *
+ * @version 2.8: Los controles de 14 bits entran como par (pushPair()) y salen juntos de pop():
+ * el MSB solo se transmite si cambió (o se fuerza), y el LSB siempre va inmediatamente después
+ * de un MSB transmitido, porque el receptor pone el LSB en 0 al recibir el MSB. Si solo cambió
+ * el LSB, sale solo el LSB: la mitad de los bytes durante un barrido fino.
+ *
+ * Toda la memoria es fija (16 x 128 entradas). La clase no es thread-safe: la usa
+ * exclusivamente el hilo de salida de MidiService.
+ */
+class CcCoalescer
+{
+    public:
+        CcCoalescer();
+
+        /**
+         * @brief Registra un mensaje en la etapa de coalescencia.
+         * @param message El mensaje recibido de la cola de salida.
+         * @param force true para transmitirlo aunque su valor sea igual al último enviado
+         * (ej. "Send All", que debe reenviar todo el estado al dispositivo).
+         * @return true Si el mensaje es un CC y quedó pendiente.
+         * @return false Si no es un CC; el llamador debe transmitirlo directamente.
+         */
+        bool push(const MidiMessage& message, bool force);
+
+        /**
+         * @brief @version 2.8: Registra el par MSB/LSB de un control de 14 bits.
+         * @details Ocupa un solo lugar en el orden de salida (el del MSB); el LSB no se transmite
+         * antes que su MSB aunque haya quedado pendiente por separado.
+         * @param msb El CC n (0-31).
+         * @param lsb El CC n+32 por el mismo canal (ver MidiMessage::isHighResolutionPair()).
+         * @param force true para transmitir los dos aunque no cambien.
+         */
+        void pushPair(const MidiMessage& msb, const MidiMessage& lsb, bool force);
+
+        /**
+         * @brief Extrae el siguiente CC pendiente que realmente deba transmitirse.
+         * @details Los valores iguales al último transmitido (y no forzados) se descartan aquí.
+         * Se asume que los mensajes devueltos serán transmitidos y se registran como últimos enviados.
+         * @version 2.8: Un par de 14 bits sale completo (MSB y LSB), o solo su LSB si el MSB no cambió;
+         * el llamador debe transmitir los mensajes juntos y en orden.
+         * @param[out] out Destino; debe tener lugar para MAX_POP mensajes.
+         * @return std::size_t La cantidad de mensajes a transmitir (0 si no quedaba nada).
+         */
+        std::size_t pop(MidiMessage* out);
+
+        /// @brief @version 2.8: Máximo de mensajes que devuelve pop() (un par de 14 bits).
+        static constexpr std::size_t MAX_POP = 2;
+
+        /**
+         * @brief @version 2.3: Registra un valor que el dispositivo ya tiene (lo informó por su salida).
+         * @details Un envío no forzado posterior con el mismo valor se omite, así los ecos de la
+         * entrada no vuelven al dispositivo.
+         * @version 2.8: Un CC 0-31 también deja en 0 el CC + 32: el receptor pone el LSB en 0 al
+         * recibir el MSB (si después llega el LSB, se registra encima).
+         * @param message El CC recibido; los demás mensajes se ignoran.
+         */
+        void noteDeviceValue(const MidiMessage& message);
+
+        /** @brief Indica si quedan CCs pendientes. */
+        bool hasPending() const { return m_orderHead != m_orderTail; }
+
+        /**
+         * @brief Olvida los últimos valores transmitidos (ej. al cambiar de puerto,
+         * el nuevo dispositivo tiene un estado desconocido).
+         */
+        void reset();
+
+        /**
+         * @brief Cantidad de mensajes no transmitidos por haber sido reemplazados o por no cambiar el valor.
+         * @details Puede leerse desde cualquier hilo.
+         */
+        unsigned long getCoalescedCount() const { return m_coalescedCount.load(std::memory_order_relaxed); }
+
+    private:
+        static constexpr std::size_t CHANNELS = 16;
+        static constexpr std::size_t CONTROLLERS = 128;
+        static constexpr std::size_t KEYS = CHANNELS * CONTROLLERS;
+        static constexpr short NO_VALUE = -1;
+
+        /// @brief Valor pendiente por clave (canal * 128 + CC), o NO_VALUE.
+        std::array<short, KEYS> m_pending;
+
+        /// @brief Último valor transmitido por clave, o NO_VALUE si se desconoce.
+        std::array<short, KEYS> m_lastSent;
+
+        /// @brief Marca las claves pendientes que deben enviarse aunque no cambien.
+        std::array<bool, KEYS> m_forced;
+
+        /// @brief @version 2.8: Marca las claves MSB pendientes como par: su LSB (clave + 32) sale con ellas.
+        std::array<bool, KEYS> m_paired;
+
+        /// @brief Marca las claves que tienen su lugar en m_order. Un LSB suelto que después pasa a
+        /// un par conserva su lugar sin valor (lo consumió el MSB); pop() lo saltea y push() no lo
+        /// duplica, así cada clave sigue apareciendo a lo sumo una vez.
+        std::array<bool, KEYS> m_queued;
+
+        /** @brief Registra como pendiente el valor de un CC, sin tocar el orden de salida. */
+        void setPending(std::size_t key, unsigned char value, bool force);
+
+        /// @brief FIFO circular de claves pendientes; cada clave aparece a lo sumo una vez,
+        /// por lo que KEYS posiciones siempre alcanzan.
+        std::array<unsigned short, KEYS> m_order;
+        std::size_t m_orderHead;
+        std::size_t m_orderTail;
+
+        std::atomic<unsigned long> m_coalescedCount{0};
+};
@@ -0,0 +1,105 @@
+/**
+ * @file DumpRequestEngine.hpp
+ * @author Gabriel Nicolás González Ferreira (gabrielinuz@fi.mdp.edu.ar)
+ * @brief Pedido/respuesta de volcados SysEx con timeout y reintentos, sin bloquear el hilo que lo usa.
+ * @version 3.1
+ * @date 2026-10-16
+ * @copyright Copyright (c) 2025. This project is released under the Apache License.
+ * @link http://www.apache.org/licenses/LICENSE-2.0
+ */
+#pragma once
+
+#include "MidiService.hpp"
+#include "SysExDumpTemplate.hpp"
+#include <chrono>
+#include <memory>
+#include <vector>
+
+/**
+ * @class DumpRequestEngine
+ * @brief Envía el pedido de una SysExDumpTemplate y espera la respuesta, reintentando si no llega.
+ * @details Es una máquina de estados sin hilos propios: start() encola el pedido en
+ * MidiService::sendSysEx() y vuelve enseguida; el dueño le pasa cada SysEx recibido con
+ * offer() y llama a poll() periódicamente (MainWindow lo hace con un timeout de FLTK) para
+ * vencer el plazo y reintentar. Nada espera en un bucle: un volcado de varios KB llega entero
+ * por MidiInputService::popSysEx() mientras la GUI sigue respondiendo.
+ *
+ * El plazo de cada intento es el timeout de la plantilla más lo que tarda la respuesta en
+ * pasar por el cable (Size a la tasa de bytes de MidiService), y corre desde que el pedido
+ * salió: mientras otro volcado ocupa la salida el reloj no avanza.
+ */
+class DumpRequestEngine
+{
+    public:
+        using Clock = std::chrono::steady_clock;
+
+        /// @brief Estado del pedido en curso.
+        enum class State
+        {
+            Idle,     ///< Sin pedido.
+            Waiting,  ///< Pedido enviado, esperando la respuesta.
+            Received, ///< Llegó la respuesta (getResponse()).
+            Failed    ///< Se agotaron los reintentos, o no hay puerto de salida.
+        };
+
+        explicit DumpRequestEngine(std::shared_ptr<MidiService> midiService);
+
+        /**
+         * @brief Envía el pedido de @p dumpTemplate y empieza a esperar; cancela el anterior.
+         * @param dumpTemplate La plantilla (se copia: el layout puede cambiar mientras se espera).
+         * @param channel El canal MIDI de la ventana, para los "CH" del pedido.
+         * @param now El instante actual.
+         * @return true Si el pedido se encoló (estado Waiting).
+         */
+        bool start(const SysExDumpTemplate& dumpTemplate, unsigned char channel, Clock::time_point now);
+
+        /**
+         * @brief Ofrece un SysEx recibido; si es la respuesta esperada la guarda y pasa a Received.
+         * @param message El mensaje completo; si es la respuesta, su contenido se mueve al motor.
+         * @return true Si era la respuesta.
+         */
+        bool offer(std::vector<unsigned char>& message);
+
+        /**
+         * @brief Vence el plazo del intento en curso: reintenta o pasa a Failed.
+         * @param now El instante actual.
+         * @return State El estado después de la comprobación.
+         */
+        State poll(Clock::time_point now);
+
+        /** @brief Abandona el pedido en curso y vuelve a Idle. */
+        void cancel();
+
+        /** @brief Estado actual. */
+        State getState() const { return m_state; }
+
+        /** @brief Indica si hay un pedido esperando respuesta. */
+        bool isWaiting() const { return m_state == State::Waiting; }
+
+        /** @brief La respuesta recibida (válida en Received). */
+        const std::vector<unsigned char>& getResponse() const { return m_response; }
+
+        /** @brief La plantilla del último pedido, para decodificar la respuesta. */
+        const SysExDumpTemplate& getTemplate() const { return m_template; }
+
+        /** @brief Pedidos enviados en la última operación (1 + reintentos usados). */
+        unsigned int getAttempts() const { return m_attempts; }
+
+        /** @brief Tiempo desde el primer pedido hasta la respuesta (o hasta ahora). */
+        Clock::duration getElapsed(Clock::time_point now) const;
+
+    private:
+        /** @brief Encola un intento y reinicia su plazo; false si MidiService lo rechazó. */
+        bool sendRequest(Clock::time_point now);
+
+        std::shared_ptr<MidiService> m_midiService;
+        SysExDumpTemplate m_template;
+        std::shared_ptr<const std::vector<unsigned char>> m_request; ///< Compartido con el hilo de salida.
+        std::vector<unsigned char> m_response;
+        State m_state;
+        unsigned int m_attempts;
+        Clock::time_point m_started;   ///< Primer pedido.
+        Clock::time_point m_finished;  ///< Respuesta o fallo.
+        Clock::time_point m_deadline;  ///< Fin del intento en curso.
+        Clock::duration m_budget;      ///< Timeout + transmisión de la respuesta.
+};
@@ -0,0 +1,46 @@
+/**
+ * @file HeadlessRunner.hpp
+ * @author Gabriel Nicolás González Ferreira (gabrielinuz@fi.mdp.edu.ar)
+ * @brief Modo sin ventana: envía un preset a un puerto MIDI desde la línea de comandos y termina.
+ * @version 3.2
+ * @date 2026-10-16
+ * @copyright Copyright (c) 2025. This project is released under the Apache License.
+ * @link http://www.apache.org/licenses/LICENSE-2.0
+ */
+#pragma once
+
+/**
+ * @namespace HeadlessRunner
+ * @brief Recall de presets desde scripts y cron, sin FLTK.
+ * @details Uso:
+ *
+ *     mccc --headless --port N --channel C --layout L --preset P [--rate B]
+ *     mccc --headless --list
+ *
+ * --port acepta el índice de --list o parte del nombre del puerto (los índices cambian al
+ * conectar dispositivos; el nombre no). --channel va de 1 a 16 y --rate es la tasa de bytes
+ * del cable (0 = sin límite, para puertos USB; por defecto la de DIN, como la ventana).
+ *
+ * Reutiliza MidiLayoutParser, MidiPresetParser, ParameterStore y MidiService: el lote es el
+ * mismo que arma la ventana al cargar un preset (CC agrupados por canal y luego los NRPN/RPN)
+ * y sale por el mismo hilo de salida. run() vuelve cuando el último byte pasó a RtMidi.
+ * No incluye nada de FLTK, así se puede enlazar un binario sin GUI (ver build.sh).
+ *
+ * Códigos de salida: 0 enviado, 1 argumentos inválidos, 2 error de layout o preset,
+ * 3 error del puerto MIDI, 4 la salida no terminó a tiempo, 5 el preset no entró entero en la
+ * cola de salida (se informa cuánto se envió).
+ */
+namespace HeadlessRunner
+{
+    /** @brief Indica si la línea de comandos pide el modo sin ventana (--headless). */
+    bool isRequested(int argc, char** argv);
+
+    /**
+     * @brief Carga el layout y el preset, los envía y espera a que la salida termine.
+     * @param argc El contador de argumentos de la línea de comandos.
+     * @param argv El array de argumentos de la línea de comandos.
+     * @return int El código de salida del proceso.
+     */
+    int run(int argc, char** argv);
+
+} // namespace HeadlessRunner
@@ -22,6 +22,8 @@
  * @version 0.4: Se añadieron métodos virtuales puros para gestionar el estado
  * del control (valor, CC#, etc.), permitiendo la funcionalidad de guardar/cargar patches.
  * @version 0.6: Se añaden métodos para gestionar el estado de activación del control.
+ * @version 1.4: El estado vive en un ParameterStore; el control es una vista sobre él.
+ * Se añade refresh() para redibujar los widgets cuando el almacén cambia por fuera del control.
  */
 class IMidiControl 
 {
@@ -67,6 +69,7 @@ class IMidiControl
          * @brief Obtiene el número de CC asociado a este control.
          * @pure
          * @return int El número de Control Change (0-127).
+         * @version 2.9: -1 si el control es un parámetro NRPN/RPN.
          */
         virtual int getCcNumber() const = 0;
 
@@ -115,4 +118,14 @@ class IMidiControl
         * @return true si el control está activo, false en caso contrario.
         */
         virtual bool isActive() const = 0;
+
+        // --- @version 1.4: Sincronización con el ParameterStore ---
+
+        /**
+        * @brief Vuelve a leer el estado del ParameterStore y actualiza los widgets.
+        * @details Se usa después de operaciones masivas sobre el almacén (reset, carga de
+        * presets) que no pasan por el control. No debe disparar el envío de mensajes MIDI.
+        * @pure
+        */
+        virtual void refresh() = 0;
 };
\ No newline at end of file
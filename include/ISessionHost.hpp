@@ -0,0 +1,50 @@
+/**
+ * @file ISessionHost.hpp
+ * @author Gabriel Nicolás González Ferreira (gabrielinuz@fi.mdp.edu.ar)
+ * @brief Define la interfaz de quien administra las ventanas de una sesión multi-dispositivo.
+ * @version 2.6
+ * @date 2026-10-16
+ * @copyright Copyright (c) 2025. This project is released under the Apache License.
+ * @link http://www.apache.org/licenses/LICENSE-2.0
+ */
+#pragma once
+
+#include <string>
+
+/**
+ * @class ISessionHost
+ * @brief Interfaz (clase base abstracta) para crear ventanas de dispositivo y abrir/guardar sesiones.
+ * @details MainWindow edita un solo dispositivo; las acciones que afectan a toda la sesión
+ * (otra ventana, otro archivo de sesión) las delega en quien es dueño de todas las ventanas
+ * (Application), sin depender de esa clase.
+ */
+class ISessionHost
+{
+    public:
+        /**
+        * @brief Destructor virtual por defecto. Esencial en clases base con funciones virtuales.
+        */
+        virtual ~ISessionHost() = default;
+
+        /**
+        * @brief Abre una ventana nueva para otro dispositivo, con su propio puerto de salida.
+        * @pure
+        */
+        virtual void addDeviceWindow() = 0;
+
+        /**
+        * @brief Aplica un archivo de sesión: un dispositivo por ventana, creando las que falten.
+        * @pure
+        * @param filename La ruta del archivo de sesión.
+        * @return int La cantidad de dispositivos aplicados, o -1 si no se pudo leer el archivo.
+        */
+        virtual int openSession(const std::string& filename) = 0;
+
+        /**
+        * @brief Guarda el puerto, el canal y el layout de cada ventana visible.
+        * @pure
+        * @param filename La ruta del archivo de sesión.
+        * @return int La cantidad de dispositivos guardados, o -1 si no se pudo escribir.
+        */
+        virtual int saveSession(const std::string& filename) = 0;
+};
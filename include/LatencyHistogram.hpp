@@ -0,0 +1,86 @@
+/**
+ * @file LatencyHistogram.hpp
+ * @author Gabriel Nicolás González Ferreira (gabrielinuz@fi.mdp.edu.ar)
+ * @brief Histograma de latencias sin bloqueos, para publicar percentiles desde otro hilo.
+ * @version 2.5
+ * @date 2026-10-16
+ * @copyright Copyright (c) 2025. This project is released under the Apache License.
+ * @link http://www.apache.org/licenses/LICENSE-2.0
+ */
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @class LatencyHistogram
+ * @brief Cuenta latencias en nanosegundos en cubetas log-lineales (16 por potencia de 2).
+ * @details record() es una carga y un almacenamiento atómicos relajados, sin reservas ni bloqueos:
+ * puede llamarse desde un callback de tiempo real. El error relativo de un percentil es
+ * a lo sumo 1/16 (6,25 %); los valores menores a 32 ns son exactos.
+ *
+ * Un solo hilo escribe (record()); cualquier otro puede tomar una instantánea
+ * (snapshot()) y restarle una anterior para ver un intervalo.
+ */
+class LatencyHistogram
+{
+    public:
+        /// @brief Cubetas por potencia de 2.
+        static constexpr unsigned SUB_BUCKETS = 16;
+
+        /// @brief Mayor valor representable (~18 minutos); los mayores se cuentan en la última cubeta.
+        static constexpr std::int64_t MAX_VALUE_NS = (std::int64_t{1} << 40) - 1;
+
+        /// @brief Cantidad de cubetas: 32 exactas y 16 por cada potencia de 2 entre 2^5 y 2^39.
+        static constexpr std::size_t BUCKETS = 2 * SUB_BUCKETS + (40 - 5) * SUB_BUCKETS;
+
+        /** @brief Copia de los contadores en un instante dado. */
+        struct Snapshot
+        {
+            std::array<std::uint32_t, BUCKETS> counts{};
+            std::uint64_t total = 0;
+
+            /**
+             * @brief Latencia por debajo de la cual cae la fracción @p quantile de las muestras.
+             * @param quantile Entre 0 y 1 (ej. 0.99 para p99).
+             * @return std::int64_t El borde superior de la cubeta, en ns; 0 si no hay muestras.
+             */
+            std::int64_t percentile(double quantile) const;
+
+            /** @brief Borde superior de la cubeta más alta con muestras (0 si no hay). */
+            std::int64_t max() const;
+
+            /** @brief Diferencia con una instantánea anterior (las muestras de ese intervalo). */
+            Snapshot since(const Snapshot& earlier) const;
+        };
+
+        /** @brief Registra una muestra (solo desde el hilo escritor). Los negativos cuentan como 0. */
+        void record(std::int64_t ns)
+        {
+            std::atomic<std::uint32_t>& bucket = m_counts[bucketFor(ns)];
+            bucket.store(bucket.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed); // Un solo escritor.
+        }
+
+        /** @brief Toma una instantánea de los contadores (desde cualquier hilo). */
+        Snapshot snapshot() const;
+
+        /** @brief Índice de la cubeta de un valor. */
+        static std::size_t bucketFor(std::int64_t ns)
+        {
+            const std::uint64_t value = static_cast<std::uint64_t>(ns < 0 ? 0 : (ns > MAX_VALUE_NS ? MAX_VALUE_NS : ns));
+            if (value < 2 * SUB_BUCKETS)
+            {
+                return static_cast<std::size_t>(value);
+            }
+            const unsigned shift = 63u - static_cast<unsigned>(__builtin_clzll(value)) - 4u;
+            return (shift + 1) * SUB_BUCKETS + static_cast<std::size_t>((value >> shift) - SUB_BUCKETS);
+        }
+
+        /** @brief Mayor valor que cae en la cubeta @p index. */
+        static std::int64_t bucketUpperBound(std::size_t index);
+
+    private:
+        std::array<std::atomic<std::uint32_t>, BUCKETS> m_counts{};
+};
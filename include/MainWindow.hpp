@@ -15,13 +15,29 @@
 #include <FL/Fl_Choice.H>
 #include <FL/Fl_Scroll.H>
 #include <FL/Fl_Button.H> // Necesario para Fl_Button
+#include <FL/Fl_Check_Button.H> // @version 1.3: Modo de recall incremental
+#include <FL/Fl_Menu_Button.H> // @version 2.6: Menú de sesión
+#include <array>
 #include <memory>
 #include <vector>
 #include <string>
+#include <chrono>
 
 #include "MidiService.hpp"
+#include "MidiInputService.hpp" // @version 2.2: Entrada MIDI
 #include "IMidiControl.hpp"
 #include "SliderConfig.hpp" // Para recibir la configuración del layout
+#include "ParameterStore.hpp" // @version 1.4: Estado de los parámetros, independiente de los widgets
+#include "VirtualControlList.hpp" // @version 1.5: Lista virtualizada para layouts grandes
+#include "PresetBank.hpp" // @version 1.9: Bancos de presets binarios mapeados en memoria
+#include "MorphEngine.hpp" // @version 2.0: Transiciones temporizadas entre presets
+#include "XYPadControl.hpp" // @version 2.1: Pad XY que mezcla cuatro presets
+#include "ParameterSync.hpp" // @version 2.3: Los CC recibidos se reflejan en los sliders
+#include "MidiLearnMap.hpp" // @version 2.4: MIDI Learn
+#include "MidiThruRouter.hpp" // @version 2.5: MIDI thru con medición de latencia
+#include "DumpRequestEngine.hpp" // @version 3.1: Lectura del estado del dispositivo por SysEx
+#include "ISessionHost.hpp" // @version 2.6: Sesiones de varios dispositivos
+#include "SessionDevice.hpp"
 
 /**
  * @class MainWindow
@@ -41,8 +57,10 @@ class MainWindow
         * @param height La altura inicial de la ventana.
         * @param title El título de la ventana.
         * @param midiService Un puntero compartido al servicio MIDI.
+        * @param midiInput @version 2.2: El servicio de entrada MIDI (puede ser nullptr).
         */
-        MainWindow(int width, int height, const char* title, std::shared_ptr<MidiService> midiService);
+        MainWindow(int width, int height, const char* title, std::shared_ptr<MidiService> midiService,
+                   std::shared_ptr<MidiInputService> midiInput = nullptr);
 
         /**
          * @brief Destruye el objeto MainWindow.
@@ -65,6 +83,27 @@ class MainWindow
          */
         void show(int argc, char** argv);
 
+        /** @brief @version 2.6: Muestra una ventana de dispositivo adicional (sin argumentos de línea de comandos). */
+        void show();
+
+        /** @brief @version 2.6: Indica si la ventana está visible (las cerradas no entran en la sesión guardada). */
+        bool isShown() const { return m_window->shown() != 0; }
+
+        /**
+         * @brief @version 2.6: Registra quién crea ventanas y abre/guarda sesiones; activa el menú "Session".
+         * @param host El dueño de las ventanas (Application); nullptr desactiva el menú.
+         */
+        void setSessionHost(ISessionHost* host);
+
+        /** @brief @version 2.6: Puerto, canal y layout que edita esta ventana. */
+        SessionDevice getSessionDevice() const;
+
+        /**
+         * @brief @version 2.6: Abre el puerto (por nombre), elige el canal y carga el layout de un dispositivo.
+         * @return true Si el puerto existe en este sistema.
+         */
+        bool applySessionDevice(const SessionDevice& device);
+
         /** @brief Actualiza el texto de la barra de estado. */
         void updateStatus(const std::string& message);
 
@@ -72,21 +111,125 @@ class MainWindow
         // --- Callbacks estáticos de FLTK (trampolines) ---
         static void onPortSelected_static(Fl_Widget* w, void* userdata);
         static void onChannelSelected_static(Fl_Widget* w, void* userdata);
+        static void onRateSelected_static(Fl_Widget* w, void* userdata);
+        static void onWireRateSelected_static(Fl_Widget* w, void* userdata);
+        static void onBatchReport_static(void* userdata); ///< @version 1.2: Timeout de FLTK, no callback de widget.
         static void onLoadLayout_static(Fl_Widget* w, void* userdata);
         static void onLoadPreset_static(Fl_Widget* w, void* userdata);
         static void onSavePreset_static(Fl_Widget* w, void* userdata);
+        static void onMorphTick_static(void* userdata); ///< @version 2.0: Timeout de FLTK.
+        static void onShowXYPad_static(Fl_Widget* w, void* userdata);
+        static void onInputPortSelected_static(Fl_Widget* w, void* userdata);
+        static void onMidiInputNotify(void* userdata);       ///< @version 2.2: Hilo de RtMidi; solo hace Fl::awake().
+        static void onMidiInputDrain_static(void* userdata);
+        static void onSyncRefresh_static(void* userdata); ///< @version 2.3: Timeout de FLTK.
+        static void onLearnToggled_static(Fl_Widget* w, void* userdata);
+        static void onLearnArmed_static(void* userdata); ///< @version 2.4: Lo llama MidiLearnMap::arm().
+        static void onThruToggled_static(Fl_Widget* w, void* userdata);
+        static void onThruReport_static(void* userdata); ///< @version 2.5: Timeout de FLTK.
+        static void onSessionMenu_static(Fl_Widget* w, void* userdata); ///< @version 2.6
+        static void onSysExMenu_static(Fl_Widget* w, void* userdata);   ///< @version 3.0
+        static void onSysExReport_static(void* userdata);               ///< @version 3.0: Timeout de FLTK.
+        static void onDumpTick_static(void* userdata);                  ///< @version 3.1: Timeout de FLTK.
+        static void onXYPadMoved_static(Fl_Widget* w, void* userdata);
+        static void onBankPresetSelected_static(Fl_Widget* w, void* userdata);
+        static void onOpenBank_static(Fl_Widget* w, void* userdata);
+        static void onImportBank_static(Fl_Widget* w, void* userdata);
+        static void onExportBank_static(Fl_Widget* w, void* userdata);
         static void onResetAll_static(Fl_Widget* w, void* userdata);
         static void onSendAll_static(Fl_Widget* w, void* userdata);
 
         // --- Métodos de instancia para la lógica de los callbacks ---
         void onPortSelected();
         void onChannelSelected();
+        void onRateSelected();
+        void onWireRateSelected();
+        void onBatchReport();
         void onLoadLayout();
         void onLoadPreset();
         void onSavePreset();
+        void onMorphTick();
+        void onShowXYPad();
+        void onInputPortSelected();
+        void onMidiInputDrain();
+        void onSyncRefresh();
+        void onLearnToggled();
+        void onLearnArmed();
+        void onThruToggled();
+        void onThruReport();
+        void onSessionMenu();
+        void onSysExMenu();
+        void onSysExReport();
+
+        /** @brief @version 3.0: Transmite un archivo .syx en partes (MidiService::sendSysEx()). */
+        void sendSysExFile();
+
+        /** @brief @version 3.0: Guarda en un .syx los SysEx recibidos desde el último guardado. */
+        void saveReceivedSysEx();
+
+        /** @brief @version 3.1: Envía el pedido de volcado del layout (m_dumpTemplate) y espera sin bloquear. */
+        void requestDeviceState();
+        void onDumpTick();
+
+        /** @brief @version 3.1: Aplica la respuesta del dispositivo al almacén en un solo lote. */
+        void applyDeviceState();
+
+        /** @brief @version 2.4: Completa un MIDI Learn con el (canal, CC) recibido y guarda los bindings. */
+        void learnBinding(unsigned char channel, unsigned char cc);
+
+        /** @brief @version 2.2: Llena el selector de puertos de entrada ("None" primero). */
+        void populateMidiInputPorts();
+
+        /**
+         * @brief @version 2.2: Procesa un lote de eventos de entrada en el hilo de FLTK.
+         * @param events Los eventos, en orden de llegada.
+         * @param count La cantidad de eventos (mayor que cero).
+         */
+        void handleMidiInput(const MidiInputEvent* events, std::size_t count);
+        void onXYPadMoved();
+        void onBankPresetSelected();
+        void onOpenBank();
+        void onImportBank();
+        void onExportBank();
         void onResetAll();
         void onSendAll();
 
+        /**
+         * @brief Arma un lote con el valor actual de los controles activos.
+         * @return std::vector<MidiMessage> Un mensaje CC por control activo, en el canal actual.
+         */
+        std::vector<MidiMessage> buildActiveControlsBatch() const;
+
+        /**
+         * @brief Envía un lote por MidiService::sendBatch() y programa el informe de tiempos.
+         * @details La transmisión ocurre en el hilo de salida; cuando termina, onBatchReport()
+         * muestra en la barra de estado las llamadas a RtMidi y el tiempo real empleado.
+         * @param messages Los mensajes del lote.
+         * @param label Nombre de la operación para la barra de estado (ej. "Send All").
+         * @param includeParameters @version 2.9: true en los envíos completos (Send All, Reset All,
+         * recall sin diff) para mandar también los NRPN/RPN activos; el recall incremental solo
+         * manda los CC que cambiaron.
+         */
+        void sendBatchWithReport(const std::vector<MidiMessage>& messages, const std::string& label, bool includeParameters);
+
+        /**
+         * @brief @version 1.9: Aplica un preset al almacén, refresca la GUI y lo envía.
+         * @details Lo comparten la carga de presets CSV y la selección en un banco.
+         * @param preset La imagen del preset.
+         * @param display_name Nombre del preset para la barra de estado.
+         */
+        void recallPreset(const PresetImage& preset, const std::string& display_name);
+
+        /** @brief @version 2.0: Cancela la transición en curso y deja los sliders donde llegaron. */
+        void stopMorph();
+
+        /**
+         * @brief @version 1.9: Abre un banco de presets y llena el selector con sus nombres.
+         * @param filename La ruta del banco (.mccbank).
+         * @return true Si el banco se pudo abrir.
+         */
+        bool openPresetBank(const std::string& filename);
+
         /** @brief Llena el menú desplegable de puertos MIDI. */
         void populateMidiPorts();
 
@@ -98,17 +241,36 @@ class MainWindow
 
         /**
          * @brief Crea y añade un nuevo control deslizante a la interfaz.
-         * @param config La configuración del slider.
+         * @version 1.4: El slider es una vista sobre una fila del ParameterStore.
+         * @param index La fila del almacén de parámetros que representa el slider.
          * @param y_position La posición Y donde se debe dibujar el slider.
          */
-        void addSliderControl(const SliderConfig& config, int y_position);
+        void addSliderControl(std::size_t index, int y_position);
+
+        /** @brief @version 1.4: Actualiza todos los widgets desde el almacén tras una operación masiva. */
+        void refreshControls();
+
+        /// @brief @version 1.5: A partir de esta cantidad de filas el layout se muestra en la
+        /// lista virtualizada (widgets solo para las filas visibles) en lugar de Fl_Scroll.
+        static constexpr std::size_t VIRTUAL_LIST_THRESHOLD = 64;
 
         // --- Widgets de FLTK ---
         Fl_Window* m_window;
         Fl_Box* m_statusBox;
         Fl_Choice* m_portChoice;
+        Fl_Choice* m_inputPortChoice; ///< @version 2.2
+        Fl_Box* m_inputActivityBox;   ///< @version 2.2: Contador y último mensaje recibido.
+        Fl_Button* m_learnButton = nullptr; ///< @version 2.4: Modo MIDI Learn (toggle).
+        Fl_Button* m_thruButton = nullptr;  ///< @version 2.5: MIDI thru (toggle).
+        Fl_Menu_Button* m_sessionMenu;      ///< @version 2.6: Nueva ventana, abrir y guardar sesión.
+        Fl_Menu_Button* m_sysExMenu;        ///< @version 3.0: Enviar un .syx, guardar lo recibido, cancelar.
+        ISessionHost* m_sessionHost = nullptr; ///< @version 2.6: No es dueño; lo es Application.
         Fl_Choice* m_channelChoice;
+        Fl_Choice* m_rateChoice; ///< @version 1.0: Límite de mensajes por milisegundo del puerto.
+        Fl_Choice* m_wireRateChoice; ///< @version 1.1: Tasa de bytes del cable (DIN, USB, etc.).
+        Fl_Check_Button* m_diffRecallCheck; ///< @version 1.3: Al cargar un preset, enviar solo lo que cambió.
         Fl_Scroll* m_scrollGroup;
+        VirtualControlList* m_virtualList; ///< @version 1.5: Ocupa el lugar de m_scrollGroup en layouts grandes.
 
         // Botones para la gestión de layout/presets
         Fl_Button* m_loadLayoutButton;
@@ -116,16 +278,80 @@ class MainWindow
         Fl_Button* m_savePresetButton;
         Fl_Button* m_resetAllButton;
         Fl_Button* m_sendAllButton;
+        Fl_Button* m_xyPadButton; ///< @version 2.1
+
+        /// @version 1.9: Banco de presets
+        Fl_Choice* m_bankChoice;
+        Fl_Button* m_openBankButton;
+        Fl_Button* m_importBankButton;
+        Fl_Button* m_exportBankButton;
+        Fl_Choice* m_morphChoice; ///< @version 2.0: Salto o transición al recuperar un preset.
 
         // --- Dependencias y Estado ---
         std::shared_ptr<MidiService> m_midiService;
+        std::shared_ptr<MidiInputService> m_midiInput; ///< @version 2.2
+
+        /// @brief @version 2.2: Tamaño máximo de un lote de entrada procesado de una vez.
+        static constexpr std::size_t MIDI_INPUT_BATCH = 256;
+        std::array<MidiInputEvent, MIDI_INPUT_BATCH> m_inputEvents;
+
+        /// @brief @version 3.0: SysEx recibidos desde el último "Save Received SysEx..." y el último leído.
+        std::vector<unsigned char> m_receivedSysEx;
+        std::vector<unsigned char> m_sysExMessage;
+        std::size_t m_sysExSendSize = 0;                       ///< Bytes del último .syx enviado.
+        std::chrono::steady_clock::time_point m_sysExSendStart; ///< Cuándo se encoló.
         unsigned char m_currentMidiChannel = 0; // Canal MIDI seleccionado actualmente (0-15)
 
+        /// @brief @version 1.4: Estado de todos los parámetros del layout (struct-of-arrays).
+        /// Es compartido con los controles, que son vistas sobre sus filas.
+        std::shared_ptr<ParameterStore> m_parameters;
+
+        /// @brief @version 2.0: Motor de transiciones; envía desde su propio hilo temporizador.
+        std::unique_ptr<MorphEngine> m_morphEngine;
+
+        /// @brief @version 2.3: Aplica la entrada MIDI al almacén; m_syncRows se reutiliza en cada cuadro.
+        std::unique_ptr<ParameterSync> m_sync;
+        std::vector<std::size_t> m_syncRows;
+
+        /// @brief @version 2.4: Bindings de MIDI Learn del layout cargado (m_layoutFile).
+        std::shared_ptr<MidiLearnMap> m_learnMap;
+        std::string m_layoutFile;
+
+        /// @brief @version 2.5: Reenvío de la entrada a la salida (corre en el hilo de RtMidiIn).
+        std::unique_ptr<MidiThruRouter> m_thruRouter;
+        LatencyHistogram::Snapshot m_thruBaseline;   ///< Instantánea al activar el thru.
+        unsigned long m_thruReportedCount = 0;       ///< Reenvíos vistos en el último informe.
+
+        /// @brief @version 3.1: Pedido de volcado del layout (synth.dump.csv) y su pedido en curso.
+        SysExDumpTemplate m_dumpTemplate;
+        std::unique_ptr<DumpRequestEngine> m_dumpEngine;
+        std::string m_morphLabel;
+        unsigned long m_morphEmittedBefore = 0;
+
+        /// @brief @version 2.1: Pad XY y su ventana (se crean al abrirlo por primera vez).
+        Fl_Window* m_xyPadWindow = nullptr;
+        std::unique_ptr<XYPadControl> m_xyPad;
+
         /// @brief Vector de punteros únicos a las interfaces de control MIDI dinámicas.
         /// La ventana es dueña de estos controles.
         std::vector<std::unique_ptr<IMidiControl>> m_controls;
 
+        /// @version 1.2: Datos del último lote enviado, para el informe de tiempos.
+        std::string m_batchLabel;
+        std::size_t m_batchSize = 0;
+        MidiService::TransmitStats m_batchStatsBefore{};
+        std::chrono::steady_clock::time_point m_batchStart;
+
+        /// @version 1.3: Mensajes ahorrados por el recall incremental frente a volcados completos.
+        std::string m_batchNote;
+        unsigned long m_diffSavedTotal = 0;
+
+        /// @version 1.9: Banco de presets abierto (mapeado en memoria).
+        PresetBank m_presetBank;
+
         /// @version 0.7: Variables atributos miembro para recordar las rutas ---
         std::string m_lastLayoutPath;
         std::string m_lastPresetPath;
+        std::string m_lastBankPath; ///< @version 1.9
+        std::string m_lastSysExPath; ///< @version 3.0
 };
\ No newline at end of file
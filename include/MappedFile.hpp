@@ -0,0 +1,48 @@
+/**
+ * @file MappedFile.hpp
+ * @author Gabriel Nicolás González Ferreira (gabrielinuz@fi.mdp.edu.ar)
+ * @brief Archivo de solo lectura mapeado en memoria (mmap), para parsear sin copiar.
+ * @version 1.7
+ * @date 2026-10-16
+ * @copyright Copyright (c) 2025. This project is released under the Apache License.
+ * @link http://www.apache.org/licenses/LICENSE-2.0
+ */
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+/**
+ * @class MappedFile
+ * @brief Mapea un archivo completo en memoria y lo expone como std::string_view.
+ * @details Los parsers recorren el contenido directamente sobre las páginas del archivo,
+ * sin ifstream, sin getline y sin una copia por línea. El mapeo se libera en el destructor.
+ * Un archivo vacío se abre correctamente y su vista es vacía.
+ */
+class MappedFile
+{
+    public:
+        /**
+         * @brief Abre y mapea el archivo. Si falla, isOpen() devuelve false.
+         * @param filename La ruta del archivo.
+         */
+        explicit MappedFile(const std::string& filename);
+
+        /** @brief Libera el mapeo. */
+        ~MappedFile();
+
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+
+        /** @brief Indica si el archivo pudo abrirse. */
+        bool isOpen() const { return m_open; }
+
+        /** @brief El contenido del archivo; válido mientras viva el objeto. */
+        std::string_view view() const { return std::string_view(m_data, m_size); }
+
+    private:
+        const char* m_data; ///< Inicio del mapeo (nullptr si el archivo está vacío).
+        std::size_t m_size; ///< Tamaño del archivo en bytes.
+        bool m_open;        ///< true si el archivo se abrió correctamente.
+};
@@ -0,0 +1,31 @@
+/**
+ * @file MidiInputEvent.hpp
+ * @author Gabriel Nicolás González Ferreira (gabrielinuz@fi.mdp.edu.ar)
+ * @brief Evento MIDI recibido, con la marca de tiempo del momento en que llegó.
+ * @version 2.2
+ * @date 2026-10-16
+ * @copyright Copyright (c) 2025. This project is released under the Apache License.
+ * @link http://www.apache.org/licenses/LICENSE-2.0
+ */
+#pragma once
+
+#include "MidiMessage.hpp"
+#include <cstdint>
+#include <type_traits>
+
+/**
+ * @struct MidiInputEvent
+ * @brief Un mensaje de canal recibido y el instante en que RtMidi lo entregó.
+ * @details Es trivialmente copiable para poder viajar por un SpscRingBuffer desde el hilo
+ * del handler de RtMidi sin reservar memoria.
+ */
+struct MidiInputEvent
+{
+    /// @brief Instante de llegada: nanosegundos de std::chrono::steady_clock desde su época.
+    std::int64_t timestampNs = 0;
+
+    /// @brief El mensaje recibido (hasta 3 bytes).
+    MidiMessage message;
+};
+
+static_assert(std::is_trivially_copyable<MidiInputEvent>::value, "MidiInputEvent must stay trivially copyable");
@@ -0,0 +1,165 @@
+/**
+ * @file MidiInputService.hpp
+ * @author Gabriel Nicolás González Ferreira (gabrielinuz@fi.mdp.edu.ar)
+ * @brief Entrada MIDI: recibe con RtMidiIn y entrega los eventos al hilo de la GUI por una cola sin bloqueos.
+ * @version 3.0
+ * @date 2026-10-16
+ * @copyright Copyright (c) 2025. This project is released under the Apache License.
+ * @link http://www.apache.org/licenses/LICENSE-2.0
+ */
+#pragma once
+
+#include "RtMidi.h"
+#include "MidiInputEvent.hpp"
+#include "SpscRingBuffer.hpp"
+#include "SysExQueue.hpp"
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+
+/**
+ * @class MidiInputService
+ * @brief Gestiona la comunicación MIDI de entrada (lo que envían el sintetizador o un controlador).
+ * @details Es la contraparte de MidiService. El callback de RtMidiIn corre en el hilo del
+ * handler de ALSA de RtMidi; ahí solo se toma la marca de tiempo y se encola el evento en un
+ * SpscRingBuffer, sin bloquear ni reservar memoria. Si la cola está llena el evento se
+ * descarta y se cuenta en getDroppedCount(): el hilo de entrada nunca espera a la GUI.
+ *
+ * Cuando la cola pasa de vacía a tener eventos se llama una sola vez al notificador
+ * registrado (MainWindow lo usa para hacer Fl::awake()); no se vuelve a llamar hasta que
+ * el consumidor llame a drain(). El consumidor vacía la cola en lotes acotados con drain(),
+ * así una ráfaga de un controlador no puede acaparar el hilo de la GUI.
+ *
+ * La clase no depende de FLTK. Se ignoran MIDI clock y active sensing.
+ *
+ * @version 2.5: Un forwarder opcional recibe cada evento en el hilo de RtMidi, antes de
+ * encolarlo (lo usa MidiThruRouter para el MIDI thru).
+ *
+ * @version 3.0: Se reciben SysEx. RtMidi entrega cada uno completo (F0 ... F7); se copia en
+ * una SysExQueue reservada de antemano y se lee con popSysEx(). Avisan al consumidor igual
+ * que los eventos de canal. No pasan por el forwarder (el thru solo reenvía mensajes cortos).
+ */
+class MidiInputService
+{
+    public:
+        /// @brief Función que avisa al consumidor que hay eventos (se llama desde el hilo de RtMidi).
+        using Notifier = void (*)(void* userdata);
+
+        /// @brief @version 2.5: Función que recibe cada evento en el hilo de RtMidi; no debe bloquear por mucho.
+        using Forwarder = void (*)(const MidiInputEvent& event, void* userdata);
+
+        /// @brief Capacidad de la cola de entrada; varios segundos de tráfico DIN continuo.
+        static constexpr std::size_t INPUT_QUEUE_CAPACITY = 4096;
+
+        /**
+        * @brief Construye el servicio e intenta inicializar RtMidiIn.
+        * @details Si falla, el error se recupera con getInitializationError().
+        */
+        MidiInputService();
+
+        /** @brief Cierra el puerto (y con él, el hilo del handler de RtMidi). */
+        ~MidiInputService();
+
+        MidiInputService(const MidiInputService&) = delete;
+        MidiInputService& operator=(const MidiInputService&) = delete;
+
+        /**
+        * @brief Registra el notificador. Llamar antes de abrir un puerto.
+        * @param notifier La función a llamar; nullptr para no notificar (el consumidor sondea).
+        * @param userdata El argumento que recibe @p notifier.
+        */
+        void setNotifier(Notifier notifier, void* userdata);
+
+        /**
+        * @brief @version 2.5: Registra el forwarder. Llamar antes de abrir un puerto.
+        * @param forwarder La función a llamar por cada evento; nullptr para ninguno.
+        * @param userdata El argumento que recibe @p forwarder.
+        */
+        void setForwarder(Forwarder forwarder, void* userdata);
+
+        /**
+        * @brief Abre un puerto MIDI de entrada.
+        * @param portNumber El índice del puerto, según getPortName().
+        * @return true Si el puerto se abrió con éxito.
+        */
+        bool openPort(unsigned int portNumber);
+
+        /** @brief Cierra el puerto de entrada si está abierto. */
+        void closePort();
+
+        /** @brief Comprueba si hay un puerto de entrada abierto. */
+        bool isPortOpen() const;
+
+        /** @brief Obtiene el número de puertos MIDI de entrada disponibles. */
+        unsigned int getPortCount() const;
+
+        /** @brief Obtiene el nombre de un puerto MIDI de entrada. */
+        std::string getPortName(unsigned int portNumber) const;
+
+        /**
+        * @brief Extrae hasta @p maxEvents eventos de la cola (solo desde el hilo consumidor).
+        * @details Rearma el notificador: el próximo evento que llegue volverá a avisar.
+        * @param[out] out Destino de los eventos.
+        * @param maxEvents Tamaño de @p out; acota el trabajo de una sola llamada.
+        * @return std::size_t La cantidad de eventos extraídos.
+        */
+        std::size_t drain(MidiInputEvent* out, std::size_t maxEvents);
+
+        /** @brief Indica si quedan eventos en la cola. @version 3.0: O SysEx sin leer. */
+        bool hasPending() const { return !m_queue.empty() || !m_sysEx.empty(); }
+
+        /**
+        * @brief @version 3.0: Extrae el SysEx recibido más antiguo (solo desde el hilo consumidor).
+        * @param[out] out Recibe el mensaje completo, F0 y F7 incluidos; conserva su capacidad.
+        * @param[out] timestampNs Si no es nullptr, recibe el instante de llegada.
+        * @return true Si había un SysEx.
+        */
+        bool popSysEx(std::vector<unsigned char>& out, std::int64_t* timestampNs = nullptr) { return m_sysEx.tryPop(out, timestampNs); }
+
+        /** @brief @version 3.0: Cantidad de SysEx descartados porque no entraban en la SysExQueue. */
+        unsigned long getSysExDroppedCount() const { return m_sysExDroppedCount.load(std::memory_order_relaxed); }
+
+        /** @brief Cantidad de eventos recibidos desde la creación del servicio. */
+        unsigned long getReceivedCount() const { return m_receivedCount.load(std::memory_order_relaxed); }
+
+        /** @brief Cantidad de eventos descartados porque la cola estaba llena. */
+        unsigned long getDroppedCount() const { return m_droppedCount.load(std::memory_order_relaxed); }
+
+        /** @brief Devuelve el error de inicialización de RtMidi, o una cadena vacía. */
+        std::string getInitializationError() const { return m_errorString; }
+
+    private:
+        /** @brief Callback de RtMidiIn (hilo del handler de RtMidi). */
+        static void onMessage_static(double deltaTime, std::vector<unsigned char>* message, void* userdata);
+
+        /** @brief Encola un mensaje recibido y avisa al consumidor si hace falta. */
+        void onMessage(const std::vector<unsigned char>& message);
+
+        /** @brief Avisa al consumidor, una vez por tanda (hilo de RtMidi). */
+        void notify();
+
+        std::unique_ptr<RtMidiIn> m_midiIn;
+        std::string m_errorString;
+        std::atomic<bool> m_portOpen{false};
+
+        /// @brief Cola SPSC: produce el hilo de RtMidi, consume el hilo de la GUI.
+        SpscRingBuffer<MidiInputEvent, INPUT_QUEUE_CAPACITY> m_queue;
+
+        /// @brief @version 3.0: SysEx recibidos; mismo productor y consumidor que m_queue.
+        SysExQueue m_sysEx;
+        std::atomic<unsigned long> m_sysExDroppedCount{0};
+
+        Notifier m_notifier = nullptr;
+        void* m_notifierData = nullptr;
+
+        Forwarder m_forwarder = nullptr; ///< @version 2.5
+        void* m_forwarderData = nullptr;
+
+        /// @brief true desde que se avisó al consumidor hasta su próximo drain().
+        std::atomic<bool> m_notifyPending{false};
+
+        std::atomic<unsigned long> m_receivedCount{0};
+        std::atomic<unsigned long> m_droppedCount{0};
+};
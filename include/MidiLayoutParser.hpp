@@ -2,8 +2,8 @@
  * @file MidiLayoutParser.hpp
  * @author Gabriel Nicolás González Ferreira (gabrielinuz@fi.mdp.edu.ar)
  * @brief Provee una función para parsear archivos de diseño (layout) de controladores MIDI en formato CSV.
- * @version 0.5
- * @date 2025-06-14
+ * @version 1.7
+ * @date 2026-10-16
  * @copyright Copyright (c) 2025. This project is released under the Apache License.
  * @link http://www.apache.org/licenses/LICENSE-2.0
  */
@@ -12,6 +12,7 @@
 #include "SliderConfig.hpp"
 #include <vector>
 #include <string>
+#include <string_view>
 
 /**
  * @namespace MidiLayoutParser
@@ -24,6 +25,12 @@ namespace MidiLayoutParser
 {
     /**
      * @brief Parsea un archivo de configuración de diseño en formato CSV y lo carga en un vector de SliderConfig.
+     * @details Formato: "Description;CC#;Range[;Channel]". @version 2.7: La cuarta columna, opcional,
+     * fija el canal (1-16) de ese control; sin ella el control usa el canal elegido en la ventana.
+     * @version 2.8: Un rango cuyo máximo pasa de 127 (hasta 16383, ej. "0-16383") declara un control
+     * de 14 bits: el CC# (0-31) lleva el MSB y el CC# + 32 el LSB.
+     * @version 2.9: En lugar del CC#, "NRPN:n" o "RPN:n" (n en 0-16383) declara un parámetro
+     * NRPN/RPN; con un máximo mayor que 127 su dato es de 14 bits (CC 6 y 38).
      * @param filename La ruta del archivo a parsear (ej: "synth_layout.csv").
      * @param[out] configs El vector donde se almacenarán las configuraciones de slider leídas.
      * @return true Si el archivo pudo ser abierto y parseado exitosamente.
@@ -31,4 +38,15 @@ namespace MidiLayoutParser
      */
     bool parse(const std::string& filename, std::vector<SliderConfig>& configs);
 
+    /**
+     * @brief @version 1.7: Parsea el contenido de un layout que ya está en memoria.
+     * @details Es lo que usa parse() sobre el archivo mapeado con MappedFile. La primera
+     * línea (cabecera, con o sin BOM UTF-8) se descarta y las líneas inválidas se saltan
+     * con un aviso por std::cerr, igual que antes. No lanza excepciones.
+     * @param content El texto completo del archivo.
+     * @param[out] configs El vector donde se almacenarán las configuraciones leídas.
+     * @return true Siempre; un contenido vacío simplemente no agrega configuraciones.
+     */
+    bool parseBuffer(std::string_view content, std::vector<SliderConfig>& configs);
+
 } // namespace MidiLayoutParser
\ No newline at end of file
@@ -0,0 +1,126 @@
+/**
+ * @file MidiLearnMap.hpp
+ * @author Gabriel Nicolás González Ferreira (gabrielinuz@fi.mdp.edu.ar)
+ * @brief MIDI Learn: tabla de ruteo 16x128 de (canal, CC) de entrada a filas del layout.
+ * @version 2.4
+ * @date 2026-10-16
+ * @copyright Copyright (c) 2025. This project is released under the Apache License.
+ * @link http://www.apache.org/licenses/LICENSE-2.0
+ */
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+/**
+ * @class MidiLearnMap
+ * @brief Asocia perillas físicas (canal y CC de entrada) con filas del ParameterStore.
+ * @details El ruteo es una tabla precalculada de 16 x 128 entradas indexada por
+ * (canal * 128 + CC): despachar un evento es un acceso a arreglo, sin buscar en los
+ * controles. Cada fila acepta una sola perilla; volver a aprender una fila mueve su binding.
+ *
+ * Modo Learn: con setLearning(true), tocar un slider lo "arma" (arm()) y el próximo CC
+ * recibido queda asociado a esa fila (capture()).
+ *
+ * Los bindings se guardan junto al layout en un CSV "Channel;CC#;Row" (canal 1-16),
+ * ver bindingsPathFor(). Se usa desde el hilo de FLTK.
+ */
+class MidiLearnMap
+{
+    public:
+        /// @brief Valor de route() para un (canal, CC) sin binding.
+        static constexpr int NO_ROW = -1;
+
+        /// @brief Cantidad de entradas de la tabla: 16 canales x 128 CC.
+        static constexpr std::size_t KEYS = 16 * 128;
+
+        MidiLearnMap();
+
+        /**
+         * @brief Fila asociada a un (canal, CC) de entrada, en O(1).
+         * @param channel El canal de entrada (0-15).
+         * @param cc El CC de entrada (0-127).
+         * @return int La fila del almacén, o NO_ROW.
+         */
+        int route(unsigned char channel, unsigned char cc) const { return m_routes[(channel & 0x0F) * 128 + (cc & 0x7F)]; }
+
+        /**
+         * @brief Asocia un (canal, CC) de entrada a una fila; la fila pierde su binding anterior.
+         * @param channel El canal de entrada (0-15).
+         * @param cc El CC de entrada (0-127).
+         * @param row La fila del almacén.
+         */
+        void bind(unsigned char channel, unsigned char cc, std::size_t row);
+
+        /** @brief Elimina todos los bindings y sale del modo Learn. */
+        void clear();
+
+        /** @brief Cantidad de bindings. */
+        std::size_t size() const { return m_count; }
+
+        // --- Modo Learn ---
+
+        /** @brief Activa o desactiva el modo Learn; al desactivarlo se desarma la fila. */
+        void setLearning(bool learning);
+
+        /** @brief Indica si el modo Learn está activo. */
+        bool isLearning() const { return m_learning; }
+
+        /// @brief Aviso de que se armó una fila (para redibujar y mostrar qué se espera).
+        using ArmListener = void (*)(void* userdata);
+
+        /** @brief Registra la función a llamar cada vez que se arma una fila. */
+        void setArmListener(ArmListener listener, void* userdata);
+
+        /** @brief Elige la fila que recibirá el próximo CC (la llama el slider tocado). */
+        void arm(std::size_t row);
+
+        /** @brief Fila armada, o NO_ROW. */
+        int getArmedRow() const { return m_armedRow; }
+
+        /**
+         * @brief Si hay una fila armada, la asocia al (canal, CC) recibido y la desarma.
+         * @return true Si se creó un binding.
+         */
+        bool capture(unsigned char channel, unsigned char cc);
+
+        // --- Persistencia ---
+
+        /**
+         * @brief Ruta del archivo de bindings de un layout ("synth.csv" -> "synth.learn.csv").
+         * @param layoutPath La ruta del layout CSV.
+         */
+        static std::string bindingsPathFor(const std::string& layoutPath);
+
+        /**
+         * @brief Carga bindings desde un archivo; reemplaza los actuales.
+         * @param filename La ruta del archivo de bindings.
+         * @param rowCount Cantidad de filas del layout; se descartan las filas fuera de rango.
+         * @return true Si el archivo existía y se leyó.
+         */
+        bool load(const std::string& filename, std::size_t rowCount);
+
+        /**
+         * @brief Interpreta el contenido de un archivo de bindings ya en memoria.
+         * @param content El contenido completo del archivo.
+         * @param rowCount Cantidad de filas del layout.
+         */
+        void parseBuffer(std::string_view content, std::size_t rowCount);
+
+        /**
+         * @brief Guarda los bindings en un archivo (una línea por binding).
+         * @return true Si el archivo se pudo escribir.
+         */
+        bool save(const std::string& filename) const;
+
+    private:
+        /// @brief Fila por (canal * 128 + CC), o NO_ROW.
+        std::array<int, KEYS> m_routes;
+        std::size_t m_count;
+        bool m_learning;
+        int m_armedRow;
+        ArmListener m_armListener = nullptr;
+        void* m_armListenerData = nullptr;
+};
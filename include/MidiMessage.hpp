@@ -0,0 +1,104 @@
+/**
+ * @file MidiMessage.hpp
+ * @author Gabriel Nicolás González Ferreira (gabrielinuz@fi.mdp.edu.ar)
+ * @brief Define un tipo valor de tamaño fijo para mensajes MIDI de canal.
+ * @version 2.8
+ * @date 2026-10-16
+ * @copyright Copyright (c) 2025. This project is released under the Apache License.
+ * @link http://www.apache.org/licenses/LICENSE-2.0
+ */
+#pragma once
+
+#include <array>
+#include <cstddef>
+
+/**
+ * @struct MidiMessage
+ * @brief Mensaje MIDI de canal (hasta 3 bytes) almacenado íntegramente en la pila.
+ * @details Reemplaza al std::vector<unsigned char> que se construía en cada envío.
+ * Es trivialmente copiable, así que puede pasarse por valor y guardarse en buffers
+ * sin reservar memoria dinámica. Se envía con RtMidiOut::sendMessage(const unsigned char*, size_t).
+ */
+struct MidiMessage
+{
+    /// @brief Tamaño máximo de un mensaje de canal (status + 2 bytes de datos).
+    static constexpr std::size_t MAX_SIZE = 3;
+
+    std::array<unsigned char, MAX_SIZE> bytes{}; ///< Bytes crudos del mensaje.
+    unsigned char length = 0;                    ///< Cantidad de bytes válidos en @c bytes.
+
+    /**
+     * @brief Construye un mensaje de Control Change.
+     * @param channel El canal MIDI (0-15).
+     * @param cc El número de Control Change (0-127).
+     * @param value El valor del Control Change (0-127).
+     * @return MidiMessage El mensaje listo para enviar.
+     */
+    static constexpr MidiMessage controlChange(unsigned char channel, unsigned char cc, unsigned char value)
+    {
+        return MidiMessage{{static_cast<unsigned char>(0xB0 | (channel & 0x0F)),
+                            static_cast<unsigned char>(cc & 0x7F),
+                            static_cast<unsigned char>(value & 0x7F)}, 3};
+    }
+
+    // --- @version 2.8: Controles de 14 bits (pares MSB/LSB) ---
+
+    /// @brief Los CC 0-31 son MSB; su LSB es el CC + 32 (especificación MIDI 1.0).
+    static constexpr unsigned char HIGH_RESOLUTION_LSB_OFFSET = 32;
+
+    /// @brief Mayor CC que puede ser MSB de un par.
+    static constexpr int HIGH_RESOLUTION_MAX_CC = 31;
+
+    /// @brief Mayor valor de 14 bits.
+    static constexpr int HIGH_RESOLUTION_MAX_VALUE = 16383;
+
+    /**
+     * @brief Escribe el par MSB (CC n) / LSB (CC n+32) de un valor de 14 bits.
+     * @param channel El canal MIDI (0-15).
+     * @param cc El CC del MSB (0-31).
+     * @param value El valor (0-16383).
+     * @param[out] out Destino; debe tener lugar para dos mensajes.
+     * @return std::size_t Siempre 2.
+     */
+    static std::size_t controlChange14(unsigned char channel, unsigned char cc, unsigned int value, MidiMessage* out)
+    {
+        out[0] = controlChange(channel, cc, static_cast<unsigned char>(value >> 7));
+        out[1] = controlChange(channel, static_cast<unsigned char>(cc + HIGH_RESOLUTION_LSB_OFFSET), static_cast<unsigned char>(value));
+        return 2;
+    }
+
+    /**
+     * @brief Indica si @p msb y @p lsb forman un par de 14 bits: CC n (0-31) y CC n+32, por el mismo canal.
+     */
+    static bool isHighResolutionPair(const MidiMessage& msb, const MidiMessage& lsb)
+    {
+        return msb.size() == 3 && lsb.size() == 3 && (msb.status() & 0xF0) == 0xB0 && msb.status() == lsb.status() &&
+               msb.bytes[1] <= HIGH_RESOLUTION_MAX_CC && lsb.bytes[1] == msb.bytes[1] + HIGH_RESOLUTION_LSB_OFFSET;
+    }
+
+    /**
+     * @brief @version 2.2: Construye un mensaje a partir de bytes crudos (ej. recibidos por RtMidiIn).
+     * @param data Los bytes del mensaje.
+     * @param size La cantidad de bytes; se truncan a MAX_SIZE.
+     * @return MidiMessage El mensaje, con una copia de los bytes.
+     */
+    static MidiMessage fromBytes(const unsigned char* data, std::size_t size)
+    {
+        MidiMessage message;
+        message.length = static_cast<unsigned char>(size < MAX_SIZE ? size : MAX_SIZE);
+        for (std::size_t i = 0; i < message.length; ++i)
+        {
+            message.bytes[i] = data[i];
+        }
+        return message;
+    }
+
+    /** @brief Puntero al primer byte del mensaje. */
+    const unsigned char* data() const { return bytes.data(); }
+
+    /** @brief Cantidad de bytes válidos del mensaje. */
+    std::size_t size() const { return length; }
+
+    /** @brief Byte de estado (status) del mensaje. */
+    unsigned char status() const { return bytes[0]; }
+};
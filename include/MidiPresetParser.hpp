@@ -2,25 +2,17 @@
  * @file MidiPresetParser.hpp
  * @author Gabriel Nicolás González Ferreira (gabrielinuz@fi.mdp.edu.ar)
  * @brief Provee funciones para parsear y guardar archivos de presets MIDI en formato CSV.
- * @version 0.6
- * @date 2025-06-17
+ * @version 2.8
+ * @date 2026-10-16
  * @copyright Copyright (c) 2025. This project is released under the Apache License.
  * @link http://www.apache.org/licenses/LICENSE-2.0
  */
 #pragma once
 
-#include "IMidiControl.hpp" // Necesario para acceder a getCurrentValue, getCcNumber, etc.
+#include "ParameterStore.hpp" // @version 1.4: Los presets se guardan desde el almacén, no desde los widgets.
+#include "PresetImage.hpp" // @version 1.8: Reemplaza al std::map<int, PresetValue>.
 #include <string>
-#include <map>
-#include <vector>
-#include <memory> // Para std::unique_ptr en save
-
-
-/** @version 0.6: Estructura para almacenar los datos de un preset. Esto nos permite cargar tanto el valor como el estado de activación.*/
-struct PresetValue {
-    int value;
-    bool active;
-};
+#include <string_view>
 
 /**
  * @namespace MidiPresetParser
@@ -32,26 +24,47 @@ struct PresetValue {
 namespace MidiPresetParser
 {
     /**
-     * @brief Parsea un archivo de preset en formato CSV y carga los datos en un mapa.
+     * @brief Parsea un archivo de preset en formato CSV y carga los datos en una PresetImage.
      * @details El formato esperado es: CC#;Value;Active (donde Active es 1 o 0).
      * El parser mantiene compatibilidad con el formato antiguo (CC#;Value), asumiendo
      * que en ese caso el control está activo.
+     * @version 2.8: En los controles de 14 bits (CC 0-31) Value es el valor completo, 0-16383.
+     * @version 1.8: El resultado es una PresetImage (arreglo fijo por CC#) en lugar de un
+     * std::map, y el archivo se lee mapeado en memoria.
      * @param filename La ruta del archivo de preset a parsear.
-     * @param[out] presetData El mapa donde se almacenarán los pares (CC#, Valor).
+     * @param[out] preset La imagen donde se almacenarán los valores leídos.
      * @return true Si el archivo pudo ser abierto y parseado exitosamente.
      * @return false Si el archivo no pudo ser abierto o si hubo un error de formato.
      */
-    bool load(const std::string& filename, std::map<int, PresetValue>& presetData);/** @version 0.6: map<int, PresetValue>*/
+    bool load(const std::string& filename, PresetImage& preset);
+
+    /**
+     * @brief @version 1.8: Parsea el contenido de un preset que ya está en memoria.
+     * @param content El texto completo del archivo.
+     * @param[out] preset La imagen donde se almacenarán los valores leídos.
+     * @return true Siempre; las líneas inválidas se saltan con un aviso.
+     */
+    bool parseBuffer(std::string_view content, PresetImage& preset);
 
     /**
-     * @brief Guarda el estado actual de un conjunto de controles MIDI en un archivo CSV.
-     * @details El formato de guardado es: CC#;Value.
-     * Solo los valores actuales de los controles se guardan.
+     * @brief Guarda el estado actual de los parámetros en un archivo CSV.
+     * @details El formato de guardado es: CC#;Value;Active.
+     * @version 1.4: Recorre el ParameterStore en lugar de los controles de la GUI.
      * @param filename La ruta del archivo donde se guardará el preset.
-     * @param controls Un vector de punteros a IMidiControl, desde donde se obtendrán los datos.
+     * @param store El almacén de parámetros, desde donde se obtendrán los datos.
      * @return true Si el preset fue guardado exitosamente.
      * @return false Si no se pudo crear o escribir en el archivo.
      */
-    bool save(const std::string& filename, const std::vector<std::unique_ptr<IMidiControl>>& controls);
+    bool save(const std::string& filename, const ParameterStore& store);
+
+    /**
+     * @brief @version 1.9: Guarda una PresetImage en un archivo CSV (CC#;Value;Active).
+     * @details Se escribe una línea por cada CC presente, en orden de CC#. La usa la
+     * exportación de bancos de presets (PresetBank::exportCsv()).
+     * @param filename La ruta del archivo donde se guardará el preset.
+     * @param preset La imagen del preset.
+     * @return true Si el preset fue guardado exitosamente.
+     */
+    bool save(const std::string& filename, const PresetImage& preset);
 
 } // namespace MidiPresetParser
\ No newline at end of file
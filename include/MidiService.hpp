@@ -10,9 +10,23 @@
 #pragma once
 
 #include "RtMidi.h"
+#include "MidiMessage.hpp"
+#include "SpscRingBuffer.hpp"
+#include "CcCoalescer.hpp"
+#include "OutputScheduler.hpp"
+#include "NrpnMessage.hpp"
+#include "NrpnEncoder.hpp"
 #include <string>
 #include <vector>
 #include <memory>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <condition_variable>
+#include <deque>
 
 /**
  * @class MidiService
@@ -21,10 +35,47 @@
  * Su propósito es aislar el resto de la aplicación de los detalles de bajo
  * nivel de la API de RtMidi. Sigue el Principio de Responsabilidad Única (SRP),
  * enfocándose exclusivamente en la lógica MIDI.
+ * @version 0.9: Los mensajes ya no se envían en el hilo de FLTK. sendMessage() solo los
+ * encola en un ring buffer SPSC sin bloqueos y un hilo de salida propio los transmite,
+ * de modo que un secuenciador lento o congestionado no frena el redibujado de la GUI.
+ * @version 1.0: El hilo de salida pasa los CC por un CcCoalescer (último valor por canal/CC)
+ * y transmite como máximo N mensajes por milisegundo.
+ * @version 1.1: Un OutputScheduler regula la salida a una tasa de bytes (por defecto la de
+ * MIDI DIN) y cada ráfaga se entrega a RtMidi en un solo buffer codificado con running status.
+ * @version 1.2: sendBatch() publica un lote completo de una vez, así el hilo de salida lo
+ * transmite en la menor cantidad posible de llamadas a RtMidi (y de drains del secuenciador).
+ * @version 1.3: Se mantiene una copia (shadow) del último valor enviado por (canal, CC) para
+ * poder enviar solo las diferencias al recuperar un preset.
+ * @version 2.0: Una segunda cola SPSC permite que un hilo de trabajo (ej. MorphEngine) envíe
+ * lotes sin pasar por el hilo de FLTK. Cada productor tiene su propia cola; el shadow pasa a
+ * ser atómico porque ahora lo escriben los dos.
+ * @version 2.3: noteReceived() registra los valores que informa el dispositivo, para no
+ * reenviárselos (supresión de realimentación), y se guarda cuándo se encoló cada CC.
+ * @version 2.5: sendThru() transmite un mensaje en el hilo que llama (el de entrada MIDI, para
+ * el thru), sin pasar por las colas. La mezcla con el hilo de salida es por buffers completos
+ * bajo m_portMutex, así que los mensajes de varios bytes nunca se intercalan.
+ * @version 2.8: Controles de 14 bits: en un lote, un CC n (0-31) seguido del CC n+32 por el mismo
+ * canal es un par MSB/LSB (MidiMessage::isHighResolutionPair()). El par viaja junto hasta la
+ * ráfaga (nunca queda partido entre dos) y, si no es forzado, se omite el MSB cuando no cambió.
+ * @version 2.9: sendParameters() envía parámetros NRPN/RPN. El hilo de salida los coalesce por
+ * dirección y los codifica con un NrpnEncoder, que omite CC 99/98 (101/100) cuando el dispositivo
+ * ya tiene seleccionado ese parámetro en el canal.
+ * @version 3.0: sendSysEx() transmite volcados SysEx en partes, con una pausa entre partes,
+ * directamente desde el buffer del llamador (ver sendSysEx()).
  */
 class MidiService 
 {
     public:
+        /**
+        * @brief @version 2.0: Origen de un envío. Cada origen tiene su propia cola SPSC y
+        * debe usarse siempre desde un único hilo.
+        */
+        enum class Producer
+        {
+            Gui = 0,    ///< El hilo de FLTK (sliders, Send All, presets).
+            Engine = 1  ///< Un único hilo de trabajo (ej. el temporizador de MorphEngine).
+        };
+
         /**
         * @brief Construye un nuevo objeto MidiService.
         * @details Intenta inicializar una instancia de RtMidiOut. Si falla, almacena el
@@ -83,6 +134,245 @@ class MidiService
         */
         void sendCcMessage(unsigned char channel, unsigned char cc, unsigned char value);
 
+        /**
+        * @brief Envía un mensaje MIDI de tamaño fijo sin reservar memoria dinámica.
+        * @version 0.8: Usa RtMidiOut::sendMessage(const unsigned char*, size_t) en lugar
+        * de construir un std::vector por cada mensaje.
+        * @version 0.9: Solo encola el mensaje; lo transmite el hilo de salida.
+        * Debe llamarse siempre desde el mismo hilo (el de FLTK), ya que la cola es SPSC.
+        * Si la cola está llena el mensaje se descarta y se contabiliza en getDroppedCount().
+        * @version 1.0: Los CC se coalescen: si llega un valor más nuevo para el mismo (canal, CC)
+        * antes de transmitirse, solo se envía el último, y se omiten los valores que el
+        * dispositivo ya tiene.
+        * @param message El mensaje a enviar.
+        * @param force true para transmitirlo aunque el valor no haya cambiado (Send All, Reset All).
+        */
+        void sendMessage(const MidiMessage& message, bool force = false);
+
+        /**
+        * @brief Envía un lote de mensajes (ej. "Send All") con una única publicación en la cola.
+        * @details El hilo de salida ve el lote completo y lo codifica en un solo buffer; con la
+        * tasa sin límite eso es una sola llamada a snd_seq_drain_output() en lugar de una por
+        * mensaje. Con la tasa de DIN el lote se reparte en ráfagas, una por ventana.
+        * Los mensajes que no entran en la cola se descartan y se contabilizan en getDroppedCount().
+        * @version 2.0: @p producer elige la cola; Producer::Engine permite enviar desde un hilo
+        * de trabajo, en paralelo con el hilo de FLTK.
+        * @param messages Puntero al primer mensaje del lote.
+        * @param count Cantidad de mensajes.
+        * @param force true (por defecto) para transmitirlos aunque el dispositivo ya tenga esos valores.
+        * @param producer El hilo que llama (Producer::Gui por defecto).
+        * @version 2.8: Los pares MSB/LSB consecutivos del lote se transmiten como una unidad.
+        */
+        void sendBatch(const MidiMessage* messages, std::size_t count, bool force = true, Producer producer = Producer::Gui);
+
+        /** @brief Sobrecarga de sendBatch() para un std::vector. */
+        void sendBatch(const std::vector<MidiMessage>& messages, bool force = true, Producer producer = Producer::Gui) { sendBatch(messages.data(), messages.size(), force, producer); }
+
+        /**
+        * @brief @version 2.9: Envía valores de parámetros NRPN/RPN (ej. el arrastre de un slider NRPN).
+        * @details Viajan por la misma cola que sendBatch(). En el hilo de salida, un valor más nuevo
+        * para el mismo (canal, tipo, número) reemplaza al que esperaba, y la dirección solo se
+        * transmite si el dispositivo tiene otro parámetro seleccionado en ese canal: arrastrar un
+        * NRPN de 7 bits cuesta 3 bytes por valor en lugar de 7 (2 en lugar de 6 dentro de una ráfaga).
+        * No hay shadow por parámetro, así que siempre se transmiten.
+        * Los que no entran en la cola se cuentan en getDroppedCount().
+        * @param messages Puntero al primer parámetro.
+        * @param count Cantidad de parámetros.
+        * @param producer El hilo que llama (Producer::Gui por defecto).
+        */
+        void sendParameters(const NrpnMessage* messages, std::size_t count, Producer producer = Producer::Gui);
+
+        /** @brief Sobrecarga de sendParameters() para un solo parámetro, desde el hilo de FLTK. */
+        void sendParameter(const NrpnMessage& message) { sendParameters(&message, 1); }
+
+        /** @brief Sobrecarga de sendParameters() para un std::vector. */
+        void sendParameters(const std::vector<NrpnMessage>& messages, Producer producer = Producer::Gui) { sendParameters(messages.data(), messages.size(), producer); }
+
+        /**
+        * @brief @version 2.9: Cantidad de NRPN/RPN transmitidos sin su dirección (CC 99/98 o 101/100).
+        * @return unsigned long El total acumulado; cada uno ahorró dos CC en el cable.
+        */
+        unsigned long getOmittedAddressCount() const { return m_nrpnEncoder.getOmittedAddressCount(); }
+
+        /**
+        * @brief @version 3.0: Encola uno o más SysEx (F0 ... F7, uno detrás de otro) para transmitirlos en partes.
+        * @details El hilo de salida los toma cuando no le quedan CC pendientes y, mientras dura el
+        * volcado, el puerto es solo del SysEx: las colas siguen aceptando envíos, que salen al
+        * terminar, y sendThru() solo deja pasar mensajes de tiempo real (0xF8-0xFF).
+        *
+        * Cada parte se entrega a RtMidi directamente desde @p data, así que RtMidi nunca copia el
+        * volcado entero en su buffer (MidiOutAlsa::sendMessage() lo agranda al tamaño de cada
+        * llamada). La parte siguiente sale cuando la anterior terminó de pasar por el cable (según
+        * la tasa de bytes) más la pausa de setSysExChunking().
+        *
+        * El codificador ALSA de RtMidi emite un evento SysEx cada vez que se llena su buffer, que
+        * mide lo que la llamada más grande hasta ese momento, y retiene el resto hasta la llamada
+        * siguiente. Para que ninguna parte quede a medio entregar, las partes se cortan donde el
+        * codificador emite: al final de un mensaje o cada max(tamaño de parte, buffer de RtMidi)
+        * bytes. Los mensajes cortos consecutivos se agrupan en una parte.
+        * @param data Los bytes; se comparten (no se copian) hasta que termina la transmisión.
+        * @param size Cantidad de bytes.
+        * @return true Si se encoló; false si no hay puerto abierto o @p data no es una secuencia de
+        * SysEx válida (cada mensaje F0, bytes de datos 0x00-0x7F y F7).
+        */
+        bool sendSysEx(std::shared_ptr<const unsigned char> data, std::size_t size);
+
+        /** @brief @version 3.0: Sobrecarga de sendSysEx() que comparte un std::vector completo. */
+        bool sendSysEx(std::shared_ptr<const std::vector<unsigned char>> data)
+        {
+            const std::size_t size = data ? data->size() : 0;
+            return data && sendSysEx(std::shared_ptr<const unsigned char>(data, data->data()), size);
+        }
+
+        /**
+        * @brief @version 3.0: Descarta los SysEx encolados y corta el que se está transmitiendo.
+        * @details Si el corte queda a mitad de un mensaje se envía F7, para que el dispositivo no
+        * quede esperando el resto. Desde cualquier hilo.
+        */
+        void cancelSysEx();
+
+        /**
+        * @brief @version 3.0: Configura el tamaño de las partes de SysEx y la pausa entre ellas.
+        * @param chunkBytes Bytes por parte (al menos 1; ver sendSysEx() sobre el mínimo efectivo).
+        * @param delay Pausa después de que cada parte terminó de salir por el cable.
+        */
+        void setSysExChunking(std::size_t chunkBytes, std::chrono::milliseconds delay);
+
+        /** @brief @version 3.0: Bytes por parte de SysEx configurados. */
+        std::size_t getSysExChunkBytes() const { return m_sysExChunkBytes.load(std::memory_order_relaxed); }
+
+        /** @brief @version 3.0: Pausa entre partes de SysEx. */
+        std::chrono::milliseconds getSysExChunkDelay() const { return std::chrono::milliseconds(m_sysExChunkDelayMs.load(std::memory_order_relaxed)); }
+
+        /** @brief @version 3.0: Indica si hay SysEx encolados o transmitiéndose. */
+        bool isSysExBusy() const { return m_sysExBusy.load(std::memory_order_acquire); }
+
+        /** @brief @version 3.0: Bytes de SysEx entregados a RtMidi desde la creación del servicio. */
+        unsigned long getSysExSentBytes() const { return m_sysExSentBytes.load(std::memory_order_relaxed); }
+
+        /**
+        * @brief @version 3.0: Indica si @p data es una secuencia de SysEx completos (F0, datos 0x00-0x7F, F7).
+        */
+        static bool isValidSysEx(const unsigned char* data, std::size_t size);
+
+        /**
+        * @brief @version 2.5: Transmite un mensaje ya, en el hilo que llama (MIDI thru).
+        * @details No pasa por las colas, el coalescer ni el planificador: el flujo reenviado ya
+        * viene al ritmo del cable de entrada, y encolarlo sumaría la latencia de despertar al hilo
+        * de salida. Toma m_portMutex, el mismo que el hilo de salida mantiene mientras entrega una
+        * ráfaga; cada ráfaga empieza con su byte de estado (OutputScheduler::beginBurst()), así que
+        * el running status tampoco se mezcla. Como mucho espera a que termine la ráfaga en curso.
+        * No actualiza el shadow ni las estadísticas de transmisión de los lotes.
+        * @version 2.9: Un CC 98-101 reenviado cambia el parámetro seleccionado en el dispositivo: el
+        * hilo de salida vuelve a enviar la dirección del próximo NRPN/RPN de ese canal.
+        * @version 3.0: Mientras se transmite un SysEx solo pasan los mensajes de tiempo real; los
+        * demás devuelven false (el thru los cuenta como no reenviados).
+        * @param message El mensaje a transmitir.
+        * @return true Si se entregó a RtMidi; false si no hay puerto abierto o RtMidi falló.
+        */
+        bool sendThru(const MidiMessage& message);
+
+        /**
+        * @brief Devuelve el último valor enviado a este puerto para un (canal, CC).
+        * @details Es la copia "shadow" del estado del dispositivo. Se olvida al abrir un puerto,
+        * porque el estado del dispositivo nuevo es desconocido.
+        * @param channel El canal MIDI (0-15).
+        * @param cc El número de Control Change (0-127).
+        * @return int El valor (0-127), o -1 si todavía no se envió nada.
+        */
+        int getLastSentValue(unsigned char channel, unsigned char cc) const { return m_shadow[(channel & 0x0F) * 128 + (cc & 0x7F)].load(std::memory_order_relaxed); }
+
+        /**
+        * @brief @version 2.3: Instante en que se encoló el último envío local de un (canal, CC).
+        * @return std::int64_t Nanosegundos de steady_clock desde su época, o 0 si nunca se envió.
+        */
+        std::int64_t getLastSentTime(unsigned char channel, unsigned char cc) const { return m_shadowTime[(channel & 0x0F) * 128 + (cc & 0x7F)].load(std::memory_order_relaxed); }
+
+        /**
+        * @brief @version 2.3: Registra un CC que informó el dispositivo (entrada MIDI).
+        * @details El dispositivo ya tiene ese valor: se actualiza el shadow y se avisa al hilo de
+        * salida (por la cola de la GUI, respetando el orden con los envíos anteriores) para que
+        * un envío no forzado del mismo valor se omita. No transmite nada ni cambia getLastSentTime().
+        * Solo desde el hilo de FLTK.
+        * @param message El mensaje recibido; los que no son CC se ignoran.
+        */
+        void noteReceived(const MidiMessage& message);
+
+        /**
+        * @brief Filtra un lote dejando solo los CC cuyo valor difiere del shadow.
+        * @details Los mensajes que no son CC se conservan siempre.
+        * @version 2.8: El LSB de un par de 14 bits se conserva si se conserva su MSB.
+        * @param messages Puntero al primer mensaje del lote.
+        * @param count Cantidad de mensajes.
+        * @return std::vector<MidiMessage> Los mensajes que realmente cambian el estado del dispositivo.
+        */
+        std::vector<MidiMessage> filterChanged(const MidiMessage* messages, std::size_t count) const;
+
+        /**
+        * @brief Estadísticas acumuladas del hilo de salida, para medir el costo real de los envíos.
+        */
+        struct TransmitStats
+        {
+            unsigned long calls;            ///< Llamadas a RtMidiOut::sendMessage (= drains del secuenciador en ALSA).
+            unsigned long bytes;            ///< Bytes entregados a RtMidi.
+            std::chrono::nanoseconds busy;  ///< Tiempo total dentro de RtMidiOut::sendMessage.
+        };
+
+        /** @brief Devuelve una instantánea de las estadísticas de transmisión. */
+        TransmitStats getTransmitStats() const;
+
+        /**
+        * @brief Indica si el hilo de salida terminó todo el trabajo encolado y está en reposo.
+        */
+        bool isOutputIdle() const { return m_outputSleeping.load(std::memory_order_acquire) && queuesEmpty() && !isSysExBusy(); }
+
+        /**
+        * @brief Limita la cantidad de mensajes transmitidos por milisegundo en este puerto.
+        * @details Mientras un mensaje espera su turno, los valores nuevos del mismo CC se coalescen.
+        * @param maxMessages Máximo de mensajes por milisegundo; 0 desactiva el límite.
+        */
+        void setMaxMessagesPerMs(unsigned int maxMessages) { m_maxMessagesPerMs.store(maxMessages, std::memory_order_relaxed); }
+
+        /** @brief Devuelve el límite de mensajes por milisegundo (0 = sin límite). */
+        unsigned int getMaxMessagesPerMs() const { return m_maxMessagesPerMs.load(std::memory_order_relaxed); }
+
+        /**
+        * @brief Regula la salida a una tasa de bytes por segundo.
+        * @param bytesPerSecond Bytes por segundo (OutputScheduler::DIN_BYTES_PER_SECOND para
+        * MIDI DIN); 0 desactiva el límite (ej. dispositivos USB class-compliant).
+        */
+        void setByteRate(unsigned int bytesPerSecond) { m_bytesPerSecond.store(bytesPerSecond, std::memory_order_relaxed); }
+
+        /** @brief Devuelve la tasa de bytes por segundo (0 = sin límite). */
+        unsigned int getByteRate() const { return m_bytesPerSecond.load(std::memory_order_relaxed); }
+
+        /**
+        * @brief Estima cuánto tardará en transmitirse una secuencia de mensajes con los límites actuales.
+        * @details Permite informar la duración de un volcado completo antes de empezarlo.
+        * @param messages Puntero al primer mensaje.
+        * @param count Cantidad de mensajes.
+        * @return std::chrono::microseconds El tiempo estimado (0 si no hay límites).
+        */
+        std::chrono::microseconds estimateTransmitTime(const MidiMessage* messages, std::size_t count) const;
+
+        /**
+        * @brief Cantidad de mensajes CC que no se transmitieron por ser reemplazados o repetidos.
+        * @return unsigned long El total acumulado desde la creación del servicio.
+        */
+        unsigned long getCoalescedCount() const { return m_coalescer.getCoalescedCount(); }
+
+        /**
+        * @brief Cantidad de mensajes que esperan en la cola de salida.
+        * @return std::size_t La profundidad actual de la cola.
+        */
+        std::size_t getQueueDepth() const;
+
+        /**
+        * @brief Cantidad de mensajes descartados porque la cola de salida estaba llena.
+        * @return unsigned long El total acumulado desde la creación del servicio.
+        */
+        unsigned long getDroppedCount() const { return m_droppedCount.load(std::memory_order_relaxed); }
+
         /**
         * @brief Devuelve un mensaje de error si la inicialización de RtMidi falló.
         * * @return std::string El mensaje de error, o una cadena vacía si no hubo error.
@@ -90,9 +380,170 @@ class MidiService
         std::string getInitializationError() const { return m_errorString; }
 
     private:
+        /** @brief Bucle del hilo de salida: desencola mensajes y los entrega a RtMidi. */
+        void outputLoop();
+
+        /** @brief Transmite un buffer (una o más mensajes) por el puerto abierto con una sola llamada a RtMidi. */
+        void transmit(const unsigned char* bytes, std::size_t size);
+
+        /// @brief Elemento de la cola de salida: el mensaje y si debe enviarse aunque no cambie.
+        struct OutputEvent
+        {
+            MidiMessage message;
+            bool force;
+            bool received = false; ///< @version 2.3: No se transmite; informa el valor que ya tiene el dispositivo.
+            bool pairedWithNext = false; ///< @version 2.8: MSB de un par de 14 bits; el evento siguiente es su LSB.
+            bool parameter = false; ///< @version 2.9: El evento es un NRPN/RPN (nrpn); message no se usa.
+            NrpnMessage nrpn{};
+        };
+
+        /// @brief Capacidad de cada cola de salida; alcanza para un volcado completo de varios layouts.
+        static constexpr std::size_t OUTPUT_QUEUE_CAPACITY = 1024;
+
+        /// @brief @version 2.0: Una cola por valor de Producer.
+        static constexpr std::size_t PRODUCER_COUNT = 2;
+
+        /** @brief Indica si todas las colas de salida están vacías. */
+        bool queuesEmpty() const;
+
         /// @brief Puntero inteligente a la instancia de RtMidiOut. La propiedad es única de esta clase.
         std::unique_ptr<RtMidiOut> m_midiOut;
         
         /// @brief Almacena un mensaje de error si la construcción falla.
         std::string m_errorString;
+
+        // --- @version 0.9: Salida asíncrona ---
+
+        /// @brief Colas SPSC: cada Producer produce en la suya, el hilo de salida las consume todas.
+        /// @version 2.0: Antes había una sola cola, solo para el hilo de FLTK.
+        std::array<SpscRingBuffer<OutputEvent, OUTPUT_QUEUE_CAPACITY>, PRODUCER_COUNT> m_outputQueues;
+
+        // --- @version 1.0: Coalescencia y límite de tasa ---
+
+        /// @brief Último valor pendiente por (canal, CC). Solo lo usa el hilo de salida.
+        CcCoalescer m_coalescer;
+
+        /// @brief Máximo de mensajes por milisegundo (0 = sin límite). @version 1.1: La tasa de bytes manda por defecto.
+        std::atomic<unsigned int> m_maxMessagesPerMs{0};
+
+        /// @brief Pide al hilo de salida que olvide los últimos valores enviados (puerto nuevo).
+        std::atomic<bool> m_resetCoalescer{false};
+
+        // --- @version 1.1: Planificación por tasa de bytes ---
+
+        /// @brief Tasa de bytes pedida desde la GUI; el hilo de salida la aplica a m_scheduler.
+        std::atomic<unsigned int> m_bytesPerSecond{OutputScheduler::DIN_BYTES_PER_SECOND};
+
+        /// @brief Regula la salida y codifica con running status. Solo lo usa el hilo de salida.
+        OutputScheduler m_scheduler;
+
+        // --- @version 2.9: NRPN/RPN ---
+
+        /// @brief Máximo de parámetros NRPN/RPN distintos esperando su turno: dos colas completas.
+        static constexpr std::size_t PARAMETER_CAPACITY = PRODUCER_COUNT * OUTPUT_QUEUE_CAPACITY;
+
+        /** @brief Agrega un parámetro a los pendientes, reemplazando al de la misma dirección (hilo de salida). */
+        void queueParameter(const NrpnMessage& message);
+
+        /**
+        * @brief Pasa un evento sin par a la etapa que le corresponde (hilo de salida).
+        * @param event El evento desencolado.
+        * @param[in,out] length Bytes ya escritos en m_burstBuffer (lo que no es CC va directo a la ráfaga).
+        */
+        void processOutputEvent(const OutputEvent& event, std::size_t& length);
+
+        /// @brief Parámetros pendientes en orden de llegada, desde m_parameterHead. Solo los usa el hilo de salida.
+        std::vector<NrpnMessage> m_pendingParameters;
+        std::size_t m_parameterHead = 0;
+
+        /// @brief Dirección seleccionada por canal en el dispositivo. Solo la usa el hilo de salida.
+        NrpnEncoder m_nrpnEncoder;
+
+        /// @brief Canales (un bit cada uno) cuya selección cambió por el thru; el hilo de salida los invalida.
+        std::atomic<unsigned int> m_thruSelectionChanged{0};
+
+        // --- @version 3.0: SysEx ---
+
+        /// @brief Un volcado encolado con sendSysEx() y hasta dónde se transmitió.
+        struct SysExJob
+        {
+            std::shared_ptr<const unsigned char> data;
+            std::size_t size = 0;
+            std::size_t offset = 0;
+        };
+
+        /// @brief Tamaño inicial del buffer del codificador ALSA de RtMidi (MidiOutAlsa::initialize()).
+        static constexpr std::size_t RTMIDI_ENCODER_INITIAL_SIZE = 32;
+
+        /**
+        * @brief Transmite la próxima parte del SysEx en curso, si ya es su momento (hilo de salida).
+        * @return true Mientras haya un SysEx en curso (el hilo no debe transmitir otra cosa).
+        */
+        bool streamSysEx();
+
+        /** @brief Bytes de la próxima parte de @p job (ver sendSysEx()). */
+        std::size_t nextSysExChunk(const SysExJob& job) const;
+
+        std::mutex m_sysExMutex;              ///< Protege m_sysExJobs (productores y hilo de salida).
+        std::deque<SysExJob> m_sysExJobs;     ///< Volcados esperando su turno.
+        SysExJob m_sysExCurrent;              ///< El volcado en curso; solo lo usa el hilo de salida.
+        std::chrono::steady_clock::time_point m_sysExNextChunk; ///< Cuándo sale la próxima parte.
+        std::atomic<bool> m_sysExBusy{false};
+        std::atomic<bool> m_sysExStreaming{false}; ///< Hay un volcado a medio transmitir; sendThru() lo lee bajo m_portMutex.
+        std::atomic<bool> m_sysExCancel{false};
+        std::atomic<std::size_t> m_sysExChunkBytes{256};
+        std::atomic<unsigned int> m_sysExChunkDelayMs{20};
+        std::atomic<unsigned long> m_sysExSentBytes{0};
+
+        /// @brief Tamaño del buffer del codificador de RtMidi: la llamada más grande a sendMessage().
+        /// Solo lo actualiza transmit() (hilo de salida); sendThru() nunca pasa de 3 bytes.
+        std::size_t m_encoderSize = RTMIDI_ENCODER_INITIAL_SIZE;
+
+        /// @brief Peor caso de una ráfaga: todas las colas completas más todos los (canal, CC) pendientes.
+        /// @version 2.9: Más todos los parámetros pendientes, cada uno con su dirección y su dato.
+        static constexpr std::size_t BURST_BUFFER_SIZE = (PRODUCER_COUNT * OUTPUT_QUEUE_CAPACITY + 16 * 128 + 1 +
+                                                          PARAMETER_CAPACITY * NrpnEncoder::MAX_MESSAGES) * MidiMessage::MAX_SIZE;
+
+        /// @brief Buffer donde se arma cada ráfaga antes de entregarla a RtMidi.
+        std::array<unsigned char, BURST_BUFFER_SIZE> m_burstBuffer;
+
+        // --- @version 1.2: Estadísticas de transmisión ---
+        std::atomic<unsigned long> m_transmitCalls{0};
+        std::atomic<unsigned long> m_transmitBytes{0};
+        std::atomic<long long> m_transmitNanos{0};
+
+        /// @brief Protege m_midiOut entre el hilo de FLTK (abrir/cerrar) y el hilo de salida (enviar).
+        mutable std::mutex m_portMutex;
+
+        /// @brief Copia atómica del estado del puerto para consultarlo sin tomar m_portMutex.
+        std::atomic<bool> m_portOpen{false};
+
+        /// @brief Mensajes descartados por cola llena.
+        std::atomic<unsigned long> m_droppedCount{0};
+
+        /** @brief Registra en el shadow un mensaje que fue aceptado por la cola de salida. */
+        void updateShadow(const MidiMessage& message, std::int64_t nowNs);
+
+        /// @brief @version 1.3: Último valor enviado por (canal * 128 + CC), -1 = desconocido.
+        /// @version 2.0: Atómico (relaxed): lo escriben los dos productores.
+        std::array<std::atomic<short>, 16 * 128> m_shadow;
+
+        /// @brief @version 2.3: Cuándo se encoló el valor del shadow (ns de steady_clock), 0 = nunca.
+        std::array<std::atomic<std::int64_t>, 16 * 128> m_shadowTime;
+
+        /** @brief Marca todo el shadow como desconocido. */
+        void clearShadow();
+
+        /** @brief Despierta al hilo de salida si está dormido (llamar después de encolar). */
+        void wakeOutputThread();
+
+        /// @brief Mientras sea true, el hilo de salida sigue corriendo.
+        std::atomic<bool> m_running{false};
+
+        /// @brief true mientras el hilo de salida duerme esperando mensajes.
+        std::atomic<bool> m_outputSleeping{false};
+
+        std::mutex m_wakeMutex;                     ///< Solo se usa para dormir/despertar el hilo de salida.
+        std::condition_variable m_wakeCondition;    ///< Despierta al hilo de salida cuando hay mensajes.
+        std::thread m_outputThread;                 ///< Hilo que transmite los mensajes encolados.
 };
\ No newline at end of file
@@ -0,0 +1,50 @@
+/**
+ * @file MidiSessionParser.hpp
+ * @author Gabriel Nicolás González Ferreira (gabrielinuz@fi.mdp.edu.ar)
+ * @brief Provee funciones para leer y guardar archivos de sesión (varios dispositivos) en formato CSV.
+ * @version 2.6
+ * @date 2026-10-16
+ * @copyright Copyright (c) 2025. This project is released under the Apache License.
+ * @link http://www.apache.org/licenses/LICENSE-2.0
+ */
+#pragma once
+
+#include "SessionDevice.hpp"
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * @namespace MidiSessionParser
+ * @brief Agrupa el parseo y el guardado de sesiones: una línea por dispositivo del rack.
+ * @details El formato es "Channel;Port;Layout" con el canal de 1 a 16. El layout va al final
+ * porque es el campo que más probablemente contenga ';' (se toma el resto de la línea).
+ * Un layout con ruta relativa se resuelve desde el directorio del archivo de sesión.
+ */
+namespace MidiSessionParser
+{
+    /**
+     * @brief Parsea un archivo de sesión.
+     * @param filename La ruta del archivo.
+     * @param[out] devices Se reemplaza por los dispositivos leídos, en orden.
+     * @return true Si el archivo pudo abrirse.
+     */
+    bool load(const std::string& filename, std::vector<SessionDevice>& devices);
+
+    /**
+     * @brief Parsea el contenido de una sesión que ya está en memoria.
+     * @param content El texto completo del archivo (la primera línea es la cabecera).
+     * @param baseDirectory Directorio desde el que se resuelven los layouts relativos.
+     * @param[out] devices Se agregan los dispositivos leídos; las líneas inválidas se saltan.
+     */
+    void parseBuffer(std::string_view content, const std::string& baseDirectory, std::vector<SessionDevice>& devices);
+
+    /**
+     * @brief Guarda una sesión.
+     * @param filename La ruta del archivo.
+     * @param devices Los dispositivos, en el orden de sus ventanas.
+     * @return true Si el archivo se pudo escribir.
+     */
+    bool save(const std::string& filename, const std::vector<SessionDevice>& devices);
+
+} // namespace MidiSessionParser
@@ -0,0 +1,76 @@
+/**
+ * @file MidiThruRouter.hpp
+ * @author Gabriel Nicolás González Ferreira (gabrielinuz@fi.mdp.edu.ar)
+ * @brief MIDI thru: reenvía lo que llega por el puerto de entrada al puerto de salida, en el hilo de entrada.
+ * @version 2.5
+ * @date 2026-10-16
+ * @copyright Copyright (c) 2025. This project is released under the Apache License.
+ * @link http://www.apache.org/licenses/LICENSE-2.0
+ */
+#pragma once
+
+#include "MidiService.hpp"
+#include "MidiInputEvent.hpp"
+#include "LatencyHistogram.hpp"
+#include <atomic>
+#include <memory>
+
+/**
+ * @class MidiThruRouter
+ * @brief Une un teclado controlador (entrada) con el sintetizador (salida), mezclado con los CC de la GUI.
+ * @details Se registra como forwarder de MidiInputService: forward() corre en el hilo del
+ * handler de RtMidiIn, antes de que el evento se encole para la GUI, y entrega el mensaje a
+ * MidiService::sendThru(), que lo transmite en ese mismo hilo. Nunca pasa por FLTK ni por
+ * la cola de salida, así un redibujado lento o una ráfaga de Send All no lo demoran más que
+ * lo que tarda en salir la ráfaga en curso.
+ *
+ * La mezcla con los envíos de la GUI es por mensajes completos (ver MidiService::sendThru()),
+ * por lo que los mensajes de varios bytes nunca se intercalan.
+ *
+ * Por cada mensaje reenviado se registra la latencia desde la llegada (marca de tiempo del
+ * callback) hasta que RtMidi lo entregó al secuenciador; getLatencySnapshot() permite
+ * publicar percentiles desde el hilo de la GUI.
+ */
+class MidiThruRouter
+{
+    public:
+        /**
+         * @brief Construye el router sobre el servicio de salida.
+         * @param output El servicio de salida; puede ser nullptr (no reenvía nada).
+         */
+        explicit MidiThruRouter(std::shared_ptr<MidiService> output);
+
+        /** @brief Activa o desactiva el reenvío (desde cualquier hilo). */
+        void setEnabled(bool enabled) { m_enabled.store(enabled, std::memory_order_release); }
+
+        /** @brief Indica si el reenvío está activo. */
+        bool isEnabled() const { return m_enabled.load(std::memory_order_acquire); }
+
+        /** @brief Forwarder de MidiInputService (hilo del handler de RtMidi). */
+        static void forward_static(const MidiInputEvent& event, void* userdata);
+
+        /**
+         * @brief Reenvía un evento recibido al puerto de salida, si el thru está activo.
+         * @param event El evento, con la marca de tiempo de su llegada.
+         */
+        void forward(const MidiInputEvent& event);
+
+        /** @brief Instantánea de las latencias de reenvío, en ns (desde cualquier hilo). */
+        LatencyHistogram::Snapshot getLatencySnapshot() const { return m_latency.snapshot(); }
+
+        /** @brief Cantidad de mensajes reenviados. */
+        unsigned long getForwardedCount() const { return m_forwardedCount.load(std::memory_order_relaxed); }
+
+        /** @brief Cantidad de mensajes no reenviados porque el puerto de salida estaba cerrado. */
+        unsigned long getSkippedCount() const { return m_skippedCount.load(std::memory_order_relaxed); }
+
+    private:
+        std::shared_ptr<MidiService> m_output;
+        std::atomic<bool> m_enabled{false};
+
+        /// @brief Lo escribe solo el hilo de entrada.
+        LatencyHistogram m_latency;
+
+        std::atomic<unsigned long> m_forwardedCount{0};
+        std::atomic<unsigned long> m_skippedCount{0};
+};
@@ -0,0 +1,169 @@
+/**
+ * @file MorphEngine.hpp
+ * @author Gabriel Nicolás González Ferreira (gabrielinuz@fi.mdp.edu.ar)
+ * @brief Transiciones temporizadas (morph) entre dos presets, en un hilo temporizador propio.
+ * @version 2.8
+ * @date 2026-10-16
+ * @copyright Copyright (c) 2025. This project is released under the Apache License.
+ * @link http://www.apache.org/licenses/LICENSE-2.0
+ */
+#pragma once
+
+#include "MidiService.hpp"
+#include "PresetImage.hpp"
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+/**
+ * @class MorphEngine
+ * @brief Interpola cada CC activo entre dos PresetImage durante un tiempo configurable.
+ * @details En lugar de saltar al preset nuevo, el motor recorre el camino desde el estado
+ * actual a una tasa fija (por defecto 100 ticks por segundo, la ventana de ráfaga de
+ * OutputScheduler) en un hilo propio, no en callbacks idle de FLTK, así el ritmo no depende
+ * del redibujado. En cada tick solo se envían los CC cuyo valor entero cambió, como un lote
+ * por la cola Producer::Engine de MidiService (el mismo camino de salida que la GUI).
+ *
+ * @version 2.8: Los CC de 14 bits (PresetImage::isHighResolution() en el preset de llegada) se
+ * interpolan en 0-16383 y salen como par MSB/LSB; MidiService omite el MSB mientras no cambie,
+ * así un barrido lento sale casi todo como LSB sueltos.
+ *
+ * La GUI no se toca desde el hilo del motor: MainWindow consulta getCurrent() con un
+ * timeout de FLTK y actualiza los sliders.
+ */
+class MorphEngine
+{
+    public:
+        using Clock = std::chrono::steady_clock;
+
+        /// @brief Forma de la transición.
+        enum class Curve
+        {
+            Linear,      ///< Avance constante.
+            Exponential  ///< Arranca lento y acelera (útil para cutoff y volumen).
+        };
+
+        /// @brief Ticks por segundo por defecto (10 ms, una ventana de OutputScheduler).
+        static constexpr unsigned int DEFAULT_TICK_RATE = 100;
+
+        /**
+         * @brief Construye el motor y arranca su hilo temporizador (en reposo).
+         * @param midiService El servicio por el que se envían los valores.
+         * @param tickRate Ticks por segundo.
+         */
+        explicit MorphEngine(std::shared_ptr<MidiService> midiService, unsigned int tickRate = DEFAULT_TICK_RATE);
+
+        /** @brief Detiene el hilo temporizador. */
+        ~MorphEngine();
+
+        MorphEngine(const MorphEngine&) = delete;
+        MorphEngine& operator=(const MorphEngine&) = delete;
+
+        /// @brief @version 2.7: Canal de salida por CC# (layouts con canal por control).
+        using ChannelMap = std::array<unsigned char, PresetImage::CONTROLLERS>;
+
+        /**
+         * @brief Comienza una transición; reemplaza a la que esté en curso.
+         * @details Se interpolan los CC activos en @p to que también están en @p from; los
+         * que faltan en @p from saltan directo al valor final en el primer tick.
+         * Llamar siempre desde el mismo hilo (el de FLTK).
+         * @param from El estado de partida (lo que el dispositivo tiene ahora).
+         * @param to El preset de llegada.
+         * @param channel El canal MIDI (0-15).
+         * @param duration Duración total de la transición.
+         * @param curve La forma de la transición.
+         */
+        void start(const PresetImage& from, const PresetImage& to, unsigned char channel,
+                   std::chrono::milliseconds duration, Curve curve)
+        {
+            ChannelMap channels;
+            channels.fill(channel);
+            start(from, to, channels, duration, curve);
+        }
+
+        /**
+         * @brief @version 2.7: Igual que start(), con un canal por CC#.
+         * @details Cada tick se emite agrupado por canal, para que el running status rinda
+         * dentro de cada grupo.
+         * @param channels El canal MIDI (0-15) de cada CC#.
+         */
+        void start(const PresetImage& from, const PresetImage& to, const ChannelMap& channels,
+                   std::chrono::milliseconds duration, Curve curve);
+
+        /** @brief Cancela la transición en curso (los valores quedan donde estaban). */
+        void stop();
+
+        /** @brief Indica si hay una transición en curso. */
+        bool isRunning() const { return m_running.load(std::memory_order_acquire); }
+
+        /**
+         * @brief El preset de llegada con los valores alcanzados hasta ahora en los CC que se mueven.
+         * @details Pensado para que la GUI muestre el avance (desde el hilo que llamó a start()).
+         */
+        PresetImage getCurrent() const;
+
+        /** @brief Cantidad de mensajes CC enviados por el motor desde su creación (los dos de cada par de 14 bits). */
+        unsigned long getEmittedCount() const { return m_emittedCount.load(std::memory_order_relaxed); }
+
+        /**
+         * @brief Aplica la curva a un avance lineal.
+         * @param curve La curva.
+         * @param t El avance en [0, 1].
+         * @return double El avance con forma, también en [0, 1].
+         */
+        static double shape(Curve curve, double t);
+
+    private:
+        /// @brief Todo lo que el hilo necesita para una transición (se copia al empezar).
+        struct Job
+        {
+            std::array<unsigned char, PresetImage::CONTROLLERS> ccs;  ///< CC# que se mueven.
+            std::array<std::uint16_t, PresetImage::CONTROLLERS> from; ///< Valor inicial, por CC#. @version 2.8: 16 bits.
+            std::array<std::uint16_t, PresetImage::CONTROLLERS> to;   ///< Valor final, por CC#.
+            std::array<bool, PresetImage::CONTROLLERS> highResolution{}; ///< @version 2.8: CC# de 14 bits.
+            std::array<short, PresetImage::CONTROLLERS> known;        ///< Valor que ya tiene el dispositivo (-1 = desconocido).
+            std::size_t count = 0;                                    ///< Cantidad de CC en @c ccs.
+            ChannelMap channels{};                                    ///< @version 2.7: Canal por CC#.
+            Clock::duration duration{};
+            Curve curve = Curve::Linear;
+            Clock::time_point start;
+        };
+
+        /** @brief Bucle del hilo temporizador. */
+        void run();
+
+        /**
+         * @brief Calcula y envía un tick de la transición.
+         * @param job La transición.
+         * @param now El instante del tick.
+         * @param[in,out] last Último valor emitido por CC#.
+         * @return true Si la transición llegó al final.
+         */
+        bool tick(const Job& job, Clock::time_point now, std::array<short, PresetImage::CONTROLLERS>& last);
+
+        std::shared_ptr<MidiService> m_midiService;
+        Clock::duration m_tickPeriod;
+
+        std::mutex m_mutex;                 ///< Protege m_job, m_generation y m_quit.
+        std::condition_variable m_condition;
+        Job m_job;
+        unsigned long m_generation = 0;     ///< Cambia con cada start() o stop().
+        bool m_hasJob = false;
+        bool m_quit = false;
+
+        std::atomic<bool> m_running{false};
+        std::atomic<unsigned long> m_emittedCount{0};
+
+        /// @brief Último valor emitido por CC#, para que la GUI muestre el avance.
+        std::array<std::atomic<std::uint16_t>, PresetImage::CONTROLLERS> m_currentValues;
+
+        /// @brief Preset de llegada de la transición actual (solo lo usa el hilo de FLTK).
+        PresetImage m_target;
+
+        std::thread m_thread; ///< Hilo temporizador; se declara último para arrancar con todo inicializado.
+};
@@ -0,0 +1,83 @@
+/**
+ * @file NrpnEncoder.hpp
+ * @author Gabriel Nicolás González Ferreira (gabrielinuz@fi.mdp.edu.ar)
+ * @brief Codifica parámetros NRPN/RPN como CC recordando el parámetro seleccionado en cada canal.
+ * @version 2.9
+ * @date 2026-10-16
+ * @copyright Copyright (c) 2025. This project is released under the Apache License.
+ * @link http://www.apache.org/licenses/LICENSE-2.0
+ */
+#pragma once
+
+#include "MidiMessage.hpp"
+#include "NrpnMessage.hpp"
+#include <array>
+#include <atomic>
+#include <cstddef>
+
+/**
+ * @class NrpnEncoder
+ * @brief Convierte un NrpnMessage en la secuencia de CC que lo transmite, sin repetir la dirección.
+ * @details Un NRPN completo son cuatro CC: 99 y 98 (dirección MSB/LSB), 6 y 38 (dato MSB/LSB).
+ * El dispositivo recuerda el último parámetro seleccionado en cada canal, así que mientras se
+ * arrastra un mismo parámetro alcanza con reenviar el dato: la clase guarda la dirección
+ * seleccionada por canal y solo emite CC 99/98 (o 101/100 para RPN) cuando cambia. Con running
+ * status, un NRPN de 7 bits pasa de 6 bytes a 2 dentro de una ráfaga.
+ *
+ * Cualquier otro CC 98-101 que salga por el puerto (una fila de CC crudo, el MIDI thru) cambia
+ * la selección del dispositivo: hay que informarlo con observe() o invalidate() para que el
+ * próximo NRPN de ese canal vuelva a enviar su dirección.
+ *
+ * No es thread-safe: la usa exclusivamente el hilo de salida de MidiService.
+ */
+class NrpnEncoder
+{
+    public:
+        /// @brief Máximo de CC que produce encode(): dirección (2) y dato (2).
+        static constexpr std::size_t MAX_MESSAGES = 4;
+
+        NrpnEncoder() { reset(); }
+
+        /**
+         * @brief Codifica un parámetro y lo registra como seleccionado en su canal.
+         * @param message El parámetro a transmitir.
+         * @param[out] out Destino; debe tener lugar para MAX_MESSAGES mensajes.
+         * @return std::size_t La cantidad de CC escritos (1 a 4).
+         */
+        std::size_t encode(const NrpnMessage& message, MidiMessage* out);
+
+        /**
+         * @brief Cantidad de CC que escribiría encode() en este momento, sin cambiar el estado.
+         */
+        std::size_t messageCount(const NrpnMessage& message) const;
+
+        /**
+         * @brief Registra un CC transmitido por fuera del encoder.
+         * @details Si es un CC 98-101, la selección del dispositivo en ese canal ya no es la conocida.
+         */
+        void observe(const MidiMessage& message);
+
+        /** @brief Olvida el parámetro seleccionado en un canal. */
+        void invalidate(unsigned char channel) { m_selected[channel & 0x0F] = NO_ADDRESS; }
+
+        /** @brief Olvida la selección de todos los canales (ej. al cambiar de puerto). */
+        void reset() { m_selected.fill(NO_ADDRESS); }
+
+        /**
+         * @brief Cantidad de pares de dirección omitidos porque el parámetro ya estaba seleccionado.
+         * @details Puede leerse desde cualquier hilo.
+         */
+        unsigned long getOmittedAddressCount() const { return m_omittedCount.load(std::memory_order_relaxed); }
+
+    private:
+        /// @brief Valor de m_selected cuando no se sabe qué parámetro tiene seleccionado el dispositivo.
+        static constexpr int NO_ADDRESS = -1;
+
+        /** @brief Clave de la dirección de un parámetro: el número, con el bit 14 para RPN. */
+        static int addressOf(const NrpnMessage& message) { return (message.registered ? 0x4000 : 0) | (message.number & 0x3FFF); }
+
+        /// @brief Dirección seleccionada en cada canal (addressOf()), o NO_ADDRESS.
+        std::array<int, 16> m_selected;
+
+        std::atomic<unsigned long> m_omittedCount{0};
+};
@@ -0,0 +1,39 @@
+/**
+ * @file NrpnMessage.hpp
+ * @author Gabriel Nicolás González Ferreira (gabrielinuz@fi.mdp.edu.ar)
+ * @brief Define un tipo valor para el envío de un parámetro NRPN o RPN.
+ * @version 2.9
+ * @date 2026-10-16
+ * @copyright Copyright (c) 2025. This project is released under the Apache License.
+ * @link http://www.apache.org/licenses/LICENSE-2.0
+ */
+#pragma once
+
+#include <cstdint>
+#include <type_traits>
+
+/**
+ * @struct NrpnMessage
+ * @brief Un valor para un parámetro NRPN (o RPN): canal, número de parámetro y valor.
+ * @details En el cable es una secuencia de CC: la dirección (CC 99/98 para NRPN, 101/100 para
+ * RPN) y el dato (CC 6, y CC 38 si el valor es de 14 bits). Se guarda sin codificar porque la
+ * dirección puede omitirse si el dispositivo ya la tiene seleccionada: eso lo decide
+ * NrpnEncoder en el hilo de salida, que es el único que sabe qué se transmitió último.
+ * Es trivialmente copiable para viajar por las colas SPSC de MidiService.
+ */
+struct NrpnMessage
+{
+    unsigned char channel = 0;    ///< El canal MIDI (0-15).
+    bool registered = false;      ///< true para RPN (CC 101/100), false para NRPN (CC 99/98).
+    bool highResolution = false;  ///< true si el dato lleva LSB (CC 38): valor de 14 bits.
+    std::uint16_t number = 0;     ///< El número de parámetro (0-16383).
+    std::uint16_t value = 0;      ///< El valor (0-127, o 0-16383 si highResolution).
+
+    /** @brief Indica si @p other apunta al mismo parámetro (canal, tipo y número). */
+    bool sameAddress(const NrpnMessage& other) const
+    {
+        return channel == other.channel && registered == other.registered && number == other.number;
+    }
+};
+
+static_assert(std::is_trivially_copyable<NrpnMessage>::value, "NrpnMessage must stay trivially copyable");
@@ -0,0 +1,128 @@
+/**
+ * @file OutputScheduler.hpp
+ * @author Gabriel Nicolás González Ferreira (gabrielinuz@fi.mdp.edu.ar)
+ * @brief Planificador de salida que respeta la velocidad de transmisión del cable MIDI.
+ * @version 1.1
+ * @date 2026-10-16
+ * @copyright Copyright (c) 2025. This project is released under the Apache License.
+ * @link http://www.apache.org/licenses/LICENSE-2.0
+ */
+#pragma once
+
+#include "MidiMessage.hpp"
+#include <chrono>
+#include <cstddef>
+
+/**
+ * @class OutputScheduler
+ * @brief Regula el envío de mensajes a una tasa de bytes configurable (token bucket).
+ * @details Un puerto MIDI DIN transmite a 31250 baudios: 10 bits por byte, es decir
+ * 3125 bytes por segundo. Las interfaces USB-DIN tienen buffers chicos; si se les
+ * entrega un volcado completo de golpe, lo que no entra se pierde. Esta clase lleva la
+ * cuenta de los bytes disponibles según el tiempo transcurrido y codifica los mensajes
+ * con "running status" (se omite el byte de estado cuando se repite), lo que reduce
+ * un CC de 3 a 2 bytes dentro de una misma ráfaga.
+ *
+ * También aplica el límite opcional de mensajes por milisegundo. Ambos créditos se
+ * acumulan como máximo durante BURST_WINDOW; cuando hay trabajo atrasado el hilo de
+ * salida espera una ventana completa (nextBurstTime()) para entregar ráfagas largas,
+ * que es donde el running status ahorra bytes.
+ *
+ * No es thread-safe: la usa el hilo de salida de MidiService. Los métodos estáticos
+ * de estimación pueden usarse desde cualquier hilo.
+ */
+class OutputScheduler
+{
+    public:
+        using Clock = std::chrono::steady_clock;
+
+        /// @brief Velocidad de MIDI DIN: 31250 baudios / 10 bits por byte.
+        static constexpr unsigned int DIN_BYTES_PER_SECOND = 3125;
+
+        /// @brief Máximo tiempo de crédito acumulable; también es el largo de una ráfaga bajo carga.
+        static constexpr std::chrono::milliseconds BURST_WINDOW{10};
+
+        /**
+         * @brief Construye el planificador.
+         * @param bytesPerSecond La tasa de bytes a respetar; 0 desactiva el límite.
+         * @param messagesPerMs Máximo de mensajes por milisegundo; 0 desactiva el límite.
+         */
+        explicit OutputScheduler(unsigned int bytesPerSecond = DIN_BYTES_PER_SECOND, unsigned int messagesPerMs = 0);
+
+        /** @brief Cambia la tasa de bytes por segundo (0 = sin límite). */
+        void setByteRate(unsigned int bytesPerSecond);
+
+        /** @brief Devuelve la tasa de bytes por segundo configurada. */
+        unsigned int getByteRate() const { return m_bytesPerSecond; }
+
+        /** @brief Cambia el máximo de mensajes por milisegundo (0 = sin límite). */
+        void setMaxMessagesPerMs(unsigned int messagesPerMs);
+
+        /** @brief Devuelve el máximo de mensajes por milisegundo configurado. */
+        unsigned int getMaxMessagesPerMs() const { return m_messagesPerMs; }
+
+        /**
+         * @brief Comienza una ráfaga nueva: acredita los bytes ganados desde la anterior
+         * y reinicia el running status (cada ráfaga se entrega a RtMidi como un buffer propio).
+         * @param now El instante actual.
+         */
+        void beginBurst(Clock::time_point now);
+
+        /**
+         * @brief Bytes que ocuparía el mensaje en la ráfaga actual (con running status).
+         * @param message El mensaje a evaluar.
+         */
+        std::size_t encodedSize(const MidiMessage& message) const;
+
+        /**
+         * @brief Indica si hay crédito suficiente para @p bytes en la ráfaga actual.
+         */
+        bool canSend(std::size_t bytes) const;
+
+        /**
+         * @brief Codifica el mensaje en @p out aplicando running status y descuenta su costo.
+         * @param message El mensaje a codificar.
+         * @param[out] out Destino; debe tener espacio para MidiMessage::MAX_SIZE bytes.
+         * @return std::size_t Cantidad de bytes escritos.
+         */
+        std::size_t encode(const MidiMessage& message, unsigned char* out);
+
+        /**
+         * @brief Instante en que los créditos vuelven a estar completos (una ventana entera).
+         * @details Lo usa el hilo de salida cuando quedó trabajo pendiente tras una ráfaga.
+         */
+        Clock::time_point nextBurstTime() const;
+
+        /**
+         * @brief Calcula los bytes en el cable de una secuencia de mensajes enviada en una
+         * sola ráfaga, aplicando running status.
+         * @param messages Puntero al primer mensaje.
+         * @param count Cantidad de mensajes.
+         */
+        static std::size_t estimateBytes(const MidiMessage* messages, std::size_t count);
+
+        /**
+         * @brief Estima cuánto tardará en transmitirse una secuencia con los límites dados.
+         * @param bytes Bytes a transmitir (ver estimateBytes()).
+         * @param messages Cantidad de mensajes.
+         * @param bytesPerSecond Tasa de bytes; 0 = sin límite.
+         * @param messagesPerMs Mensajes por milisegundo; 0 = sin límite.
+         * @return std::chrono::microseconds El tiempo impuesto por el límite más restrictivo.
+         */
+        static std::chrono::microseconds estimateDuration(std::size_t bytes, std::size_t messages,
+                                                          unsigned int bytesPerSecond, unsigned int messagesPerMs);
+
+    private:
+        /// @brief Tope del crédito de bytes: una ventana de transmisión (nunca menos de un NRPN completo).
+        double byteCapacity() const;
+
+        /// @brief Tope del crédito de mensajes: una ventana de transmisión (nunca menos de uno).
+        double messageCapacity() const;
+
+        unsigned int m_bytesPerSecond;  ///< Tasa de bytes configurada (0 = sin límite).
+        unsigned int m_messagesPerMs;   ///< Mensajes por milisegundo (0 = sin límite).
+        double m_byteCredit;            ///< Bytes disponibles; puede quedar negativo (deuda).
+        double m_messageCredit;         ///< Mensajes disponibles.
+        Clock::time_point m_lastRefill; ///< Último instante en que se acreditaron créditos.
+        unsigned char m_runningStatus;  ///< Último byte de estado emitido en la ráfaga (0 = ninguno).
+};
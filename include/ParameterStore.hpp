@@ -0,0 +1,261 @@
+/**
+ * @file ParameterStore.hpp
+ * @author Gabriel Nicolás González Ferreira (gabrielinuz@fi.mdp.edu.ar)
+ * @brief Almacén contiguo (struct-of-arrays) del estado de los parámetros MIDI del layout.
+ * @version 2.9
+ * @date 2026-10-16
+ * @copyright Copyright (c) 2025. This project is released under the Apache License.
+ * @link http://www.apache.org/licenses/LICENSE-2.0
+ */
+#pragma once
+
+#include "SliderConfig.hpp"
+#include "MidiMessage.hpp"
+#include "PresetImage.hpp"
+#include "NrpnMessage.hpp"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @class ParameterStore
+ * @brief Fuente única de verdad del estado de cada parámetro (CC#, valor, rango, activo).
+ * @details Antes, el único lugar donde vivía el valor de un parámetro era el Fl_Slider, y
+ * guardar, enviar o comparar presets obligaba a recorrer widgets con llamadas virtuales.
+ * Ahora los datos se guardan como struct-of-arrays: un arreglo contiguo por campo, de modo
+ * que las operaciones masivas (guardar, armar un lote, aplicar un preset) son bucles
+ * simples sobre memoria contigua sin tocar la GUI. Los controles (IMidiControl) son
+ * vistas sobre una fila de este almacén.
+ *
+ * @version 2.8: Los valores y rangos son de 16 bits: una fila puede ser un control de 14 bits
+ * (0-16383) que sale como el par CC n (MSB) / CC n+32 (LSB), ver appendRowMessages().
+ *
+ * @version 2.9: Una fila puede ser un parámetro NRPN/RPN (getType()). Esas filas no tienen CC#
+ * (getCc() devuelve -1): no entran en la tabla por CC#, ni en los presets, el morph o el pad XY,
+ * que se indexan por CC#; se envían con appendActiveParameters() y parameterMessage().
+ *
+ * No es thread-safe: se usa desde el hilo de FLTK.
+ */
+class ParameterStore
+{
+    public:
+        /** @brief Construye un almacén vacío. */
+        ParameterStore() { m_firstRowByCc.fill(NO_ROW); m_channelByCc.fill(NO_CHANNEL); }
+
+        /**
+         * @brief Agrega un parámetro a partir de la configuración del layout.
+         * @details El valor inicial es el mínimo del rango y el parámetro arranca activo.
+         * @param config La configuración parseada del layout.
+         * @return std::size_t El índice del nuevo parámetro.
+         */
+        std::size_t add(const SliderConfig& config);
+
+        /** @brief Elimina todos los parámetros (ej. al cargar un layout nuevo). */
+        void clear();
+
+        /** @brief Cantidad de parámetros. */
+        std::size_t size() const { return m_cc.size(); }
+
+        /** @brief Indica si no hay parámetros cargados. */
+        bool empty() const { return m_cc.empty(); }
+
+        // --- Acceso por fila ---
+        int getCc(std::size_t index) const { return m_cc[index] == NOT_A_CC ? -1 : m_cc[index]; } ///< @version 2.9: -1 en los NRPN/RPN.
+        int getMinValue(std::size_t index) const { return m_min[index]; }
+        int getMaxValue(std::size_t index) const { return m_max[index]; }
+        int getValue(std::size_t index) const { return m_value[index]; }
+        bool isActive(std::size_t index) const { return m_active[index] != 0; }
+        const std::string& getDescription(std::size_t index) const { return m_description[index]; }
+
+        // --- @version 2.9: Parámetros NRPN/RPN ---
+
+        /** @brief Cómo se direcciona el parámetro: CC, NRPN o RPN. */
+        ParameterType getType(std::size_t index) const { return m_type[index]; }
+
+        /** @brief Número de NRPN/RPN del parámetro (0 en los CC). */
+        int getParameterNumber(std::size_t index) const { return m_parameterNumber[index]; }
+
+        /** @brief Indica si hay parámetros NRPN/RPN cargados. */
+        bool hasParameters() const { return m_parameterRows > 0; }
+
+        /**
+         * @brief El valor actual de un parámetro NRPN/RPN, listo para MidiService::sendParameters().
+         * @param index El índice del parámetro (getType() distinto de ControlChange).
+         * @param channel El canal MIDI (0-15).
+         */
+        NrpnMessage parameterMessage(std::size_t index, unsigned char channel) const
+        {
+            NrpnMessage message;
+            message.channel = channel;
+            message.registered = m_type[index] == ParameterType::Rpn;
+            message.highResolution = m_highResolution[index] != 0;
+            message.number = m_parameterNumber[index];
+            message.value = m_value[index];
+            return message;
+        }
+
+        /**
+         * @brief Agrega a @p out un NrpnMessage por cada parámetro NRPN/RPN activo, en orden de fila.
+         * @param channel El canal MIDI de la ventana (0-15); cada parámetro sale por channelFor().
+         * @param[out] out El lote donde se agregan los mensajes.
+         * @return std::size_t La cantidad de mensajes agregados.
+         */
+        std::size_t appendActiveParameters(unsigned char channel, std::vector<NrpnMessage>& out) const;
+
+        // --- @version 2.8: Controles de 14 bits ---
+
+        /// @brief Mensajes que puede generar una fila (el par MSB/LSB de un control de 14 bits).
+        static constexpr std::size_t MAX_MESSAGES_PER_ROW = 2;
+
+        /** @brief Indica si el parámetro es un control de 14 bits (CC n y CC n+32). */
+        bool isHighResolution(std::size_t index) const { return m_highResolution[index] != 0; }
+
+        /**
+         * @brief Indica si @p cc es el MSB de un control de 14 bits, para las operaciones indexadas
+         * por CC# (presets, morph, pad XY). Si varias filas comparten el CC#, manda la última.
+         */
+        bool isHighResolutionCc(int cc) const { return m_highResolutionByCc[cc & 0x7F] != 0; }
+
+        /**
+         * @brief Escribe los mensajes que llevan el valor actual de un CC al dispositivo.
+         * @details Un CC, o el par MSB/LSB (en ese orden) si el parámetro es de 14 bits; MidiService
+         * reconoce el par y, en los envíos no forzados, omite el MSB si solo cambió el LSB.
+         * @param index El índice del parámetro (un CC; los NRPN/RPN usan parameterMessage()).
+         * @param channel El canal MIDI (0-15).
+         * @param[out] out Destino; debe tener lugar para MAX_MESSAGES_PER_ROW mensajes.
+         * @return std::size_t La cantidad de mensajes escritos (1 o 2).
+         */
+        std::size_t appendRowMessages(std::size_t index, unsigned char channel, MidiMessage* out) const
+        {
+            if (m_highResolution[index])
+            {
+                return MidiMessage::controlChange14(channel, m_cc[index], m_value[index], out);
+            }
+            out[0] = MidiMessage::controlChange(channel, m_cc[index], static_cast<unsigned char>(m_value[index]));
+            return 1;
+        }
+
+        // --- @version 2.7: Canal por control ---
+
+        /// @brief Valor de getChannel() para un control que usa el canal de la ventana.
+        static constexpr int NO_CHANNEL = -1;
+
+        /** @brief Canal propio del parámetro (0-15), o NO_CHANNEL. */
+        int getChannel(std::size_t index) const { return m_channel[index]; }
+
+        /**
+         * @brief Canal por el que sale el parámetro.
+         * @param index El índice del parámetro.
+         * @param defaultChannel El canal de la ventana, para los parámetros sin canal propio.
+         */
+        unsigned char channelFor(std::size_t index, unsigned char defaultChannel) const
+        {
+            return m_channel[index] == NO_CHANNEL ? defaultChannel : static_cast<unsigned char>(m_channel[index]);
+        }
+
+        /**
+         * @brief Canal de un CC# para las operaciones indexadas por CC# (presets, morph, pad XY).
+         * @details Si varias filas comparten el CC#, manda la última agregada, igual que en snapshot().
+         */
+        unsigned char channelForCc(int cc, unsigned char defaultChannel) const
+        {
+            const int channel = m_channelByCc[cc & 0x7F];
+            return channel == NO_CHANNEL ? defaultChannel : static_cast<unsigned char>(channel);
+        }
+
+        /** @brief Indica si algún parámetro tiene canal propio (layout multitímbrico). */
+        bool hasChannelOverrides() const { return m_channelOverrides > 0; }
+
+        // --- @version 2.3: Búsqueda O(1) por CC# ---
+
+        /// @brief Valor de firstRowForCc()/nextRowForCc() cuando no hay (más) filas.
+        static constexpr int NO_ROW = -1;
+
+        /**
+         * @brief Primera fila que usa @p cc, en O(1) (tabla de 128 entradas).
+         * @details Varias filas pueden compartir un CC#; se recorren con nextRowForCc().
+         * @return int El índice de la fila, o NO_ROW.
+         */
+        int firstRowForCc(int cc) const { return m_firstRowByCc[cc & 0x7F]; }
+
+        /** @brief Siguiente fila con el mismo CC# que @p row, o NO_ROW. */
+        int nextRowForCc(std::size_t row) const { return m_nextRowSameCc[row]; }
+
+        /**
+         * @brief Establece el valor de un parámetro, recortado a su rango.
+         * @param index El índice del parámetro.
+         * @param value El nuevo valor.
+         */
+        void setValue(std::size_t index, int value);
+
+        /** @brief Establece el estado de activación de un parámetro. */
+        void setActive(std::size_t index, bool active) { m_active[index] = active ? 1 : 0; }
+
+        // --- Operaciones masivas (sin GUI) ---
+
+        /**
+         * @brief Lleva todos los parámetros activos a su valor mínimo.
+         * @return std::size_t La cantidad de parámetros reseteados.
+         */
+        std::size_t resetActive();
+
+        /**
+         * @brief @version 1.8: Aplica un preset en una sola pasada lineal.
+         * @details Cada parámetro cuyo CC# trae el preset toma su valor (recortado al rango)
+         * y su estado de activación; el resto queda igual.
+         * @param preset La imagen del preset.
+         * @return std::size_t La cantidad de parámetros actualizados.
+         */
+        std::size_t applyPreset(const PresetImage& preset);
+
+        /**
+         * @brief @version 2.0: Devuelve el estado actual como PresetImage (valor y activación por CC#).
+         * @details Si dos parámetros comparten CC#, queda el último. Lo usa MorphEngine como
+         * punto de partida y de llegada de una transición.
+         */
+        PresetImage snapshot() const;
+
+        /**
+         * @brief Agrega a @p out un mensaje CC por cada parámetro activo (dos si es de 14 bits).
+         * @details @version 2.9: Los NRPN/RPN no se incluyen (ver appendActiveParameters()).
+         * @details @version 2.7: Cada parámetro sale por su canal (channelFor()). Los mensajes se
+         * agrupan por canal, en orden de fila dentro de cada canal: el hilo de salida los
+         * transmite en ese orden y el running status omite el byte de estado dentro de cada grupo.
+         * @param channel El canal MIDI de la ventana (0-15).
+         * @param[out] out El lote donde se agregan los mensajes.
+         * @return std::size_t La cantidad de mensajes agregados.
+         */
+        std::size_t appendActiveBatch(unsigned char channel, std::vector<MidiMessage>& out) const;
+
+    private:
+        /// @brief @version 2.9: Valor de m_cc en las filas NRPN/RPN.
+        static constexpr unsigned char NOT_A_CC = 0xFF;
+
+        // Datos calientes: un arreglo contiguo por campo.
+        std::vector<unsigned char> m_cc;
+        std::vector<std::uint16_t> m_value; ///< @version 2.8: 16 bits (controles de 14 bits).
+        std::vector<std::uint16_t> m_min;
+        std::vector<std::uint16_t> m_max;
+        std::vector<unsigned char> m_active;
+        std::vector<unsigned char> m_highResolution; ///< @version 2.8: 1 si la fila es de 14 bits.
+        std::vector<ParameterType> m_type;            ///< @version 2.9: CC, NRPN o RPN.
+        std::vector<std::uint16_t> m_parameterNumber; ///< @version 2.9: Número de NRPN/RPN.
+        std::size_t m_parameterRows = 0;              ///< @version 2.9: Cantidad de filas NRPN/RPN.
+        std::vector<signed char> m_channel; ///< @version 2.7: 0-15, o NO_CHANNEL.
+
+        /// @brief @version 2.7: Canal propio de la última fila agregada con cada CC#, y cuántas filas tienen uno.
+        std::array<signed char, 128> m_channelByCc;
+        std::size_t m_channelOverrides = 0;
+
+        /// @brief @version 2.8: 1 si la última fila agregada con cada CC# es de 14 bits.
+        std::array<unsigned char, 128> m_highResolutionByCc{};
+
+        /// @brief @version 2.3: Tabla CC# -> primera fila, y cadena de filas con el mismo CC#.
+        std::array<int, 128> m_firstRowByCc;
+        std::vector<int> m_nextRowSameCc;
+
+        // Datos fríos: solo los usa la GUI.
+        std::vector<std::string> m_description;
+};
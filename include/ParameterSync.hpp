@@ -0,0 +1,120 @@
+/**
+ * @file ParameterSync.hpp
+ * @author Gabriel Nicolás González Ferreira (gabrielinuz@fi.mdp.edu.ar)
+ * @brief Sincronización bidireccional: los CC que envía el dispositivo se reflejan en el almacén.
+ * @version 2.9
+ * @date 2026-10-16
+ * @copyright Copyright (c) 2025. This project is released under the Apache License.
+ * @link http://www.apache.org/licenses/LICENSE-2.0
+ */
+#pragma once
+
+#include "ParameterStore.hpp"
+#include "MidiService.hpp"
+#include "MidiInputEvent.hpp"
+#include "MidiLearnMap.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+/**
+ * @class ParameterSync
+ * @brief Aplica los CC recibidos al ParameterStore y junta las filas que hay que redibujar.
+ * @details Cuando alguien mueve una perilla del sintetizador, el CC recibido en el canal
+ * seleccionado se busca en la tabla CC# -> filas del almacén (O(1)) y el valor se escribe
+ * en cada fila que usa ese CC. Los widgets no se tocan aquí: las filas quedan marcadas y
+ * la ventana las refresca a la tasa de la pantalla (takeDirtyRows()), así un dispositivo
+ * que envía miles de CC por segundo no genera miles de redibujados.
+ *
+ * Supresión de realimentación:
+ *  - Un valor igual al último que le enviamos al dispositivo es un eco: se ignora.
+ *  - Un valor distinto que llega dentro de ECHO_WINDOW desde nuestro último envío de ese CC
+ *    es un eco atrasado de un arrastre o una transición en curso: también se ignora, para
+ *    que el slider no salte hacia atrás.
+ *  - Un valor aceptado se registra con MidiService::noteReceived(): el dispositivo ya lo
+ *    tiene, así que un envío no forzado del mismo valor no vuelve a salir.
+ *
+ * @version 2.4: Los (canal, CC) aprendidos con MIDI Learn se despachan primero, por la tabla
+ * de ruteo 16x128 de MidiLearnMap: la perilla mueve la fila asociada, como si se moviera su
+ * slider, y el CC de esa fila se envía al dispositivo (un lote por llamada a apply()).
+ *
+ * @version 2.7: Con canales por control, un CC recibido se aplica a las filas cuyo canal de
+ * salida (el propio o el de la ventana) es el canal por el que llegó.
+ *
+ * @version 2.8: En una fila de 14 bits, el CC n (MSB) fija los 7 bits altos y pone los bajos
+ * en 0, y el CC n+32 (LSB) fija los 7 bits bajos. Una perilla aprendida de 7 bits se escala
+ * a todo el rango de 14 bits.
+ *
+ * @version 2.9: Una perilla aprendida puede mover una fila NRPN/RPN; su valor sale como
+ * parámetro (MidiService::sendParameters()). Los NRPN/RPN recibidos no se decodifican.
+ *
+ * Se usa desde el hilo de FLTK.
+ */
+class ParameterSync
+{
+    public:
+        /// @brief Ventana en la que un valor recibido se toma como eco de nuestros propios envíos.
+        static constexpr std::int64_t ECHO_WINDOW_NS = 50 * 1000 * 1000;
+
+        /**
+         * @brief Construye la sincronización sobre un almacén y el servicio de salida.
+         * @param store El almacén donde se escriben los valores recibidos.
+         * @param midiService El servicio de salida (shadow de lo enviado); puede ser nullptr.
+         */
+        ParameterSync(std::shared_ptr<ParameterStore> store, std::shared_ptr<MidiService> midiService);
+
+        /**
+         * @brief @version 2.4: Usa una tabla de MIDI Learn para despachar (nullptr = ninguna).
+         */
+        void setLearnMap(std::shared_ptr<const MidiLearnMap> learnMap) { m_learnMap = learnMap; }
+
+        /**
+         * @brief Aplica un lote de eventos recibidos.
+         * @param events Los eventos, en orden de llegada.
+         * @param count La cantidad de eventos.
+         * @param channel El canal MIDI seleccionado (0-15); los demás canales solo se usan si
+         * tienen un binding de MIDI Learn. También es el canal de salida de esos bindings.
+         * @return std::size_t La cantidad de filas del almacén actualizadas.
+         */
+        std::size_t apply(const MidiInputEvent* events, std::size_t count, unsigned char channel);
+
+        /**
+         * @brief Entrega las filas cambiadas desde la última llamada y las desmarca.
+         * @param[out] rows Se reemplaza por las filas a redibujar, sin repetidos.
+         */
+        void takeDirtyRows(std::vector<std::size_t>& rows);
+
+        /** @brief Olvida las filas marcadas (ej. al cargar un layout nuevo). */
+        void reset();
+
+        /** @brief Cantidad de CC aplicados al almacén desde la creación. */
+        unsigned long getAppliedCount() const { return m_appliedCount; }
+
+        /** @brief @version 2.4: Cantidad de eventos despachados por la tabla de MIDI Learn. */
+        unsigned long getRoutedCount() const { return m_routedCount; }
+
+        /** @brief Cantidad de CC descartados por ser ecos de nuestros envíos. */
+        unsigned long getEchoCount() const { return m_echoCount; }
+
+    private:
+        /** @brief Marca una fila para el próximo refresco (una sola vez). */
+        void markDirty(std::size_t row);
+
+        std::shared_ptr<ParameterStore> m_store;
+        std::shared_ptr<MidiService> m_midiService;
+        std::shared_ptr<const MidiLearnMap> m_learnMap; ///< @version 2.4
+
+        /// @brief @version 2.4: CC a enviar por los bindings del lote actual (se reutiliza).
+        std::vector<MidiMessage> m_outBatch;
+
+        /// @brief @version 2.9: NRPN/RPN a enviar por los bindings del lote actual (se reutiliza).
+        std::vector<NrpnMessage> m_outParameters;
+
+        std::vector<unsigned char> m_dirty;      ///< 1 si la fila ya está en m_dirtyRows.
+        std::vector<std::size_t> m_dirtyRows;    ///< Filas a refrescar, en orden de llegada.
+
+        unsigned long m_appliedCount = 0;
+        unsigned long m_echoCount = 0;
+        unsigned long m_routedCount = 0;
+};
@@ -0,0 +1,143 @@
+/**
+ * @file PresetBank.hpp
+ * @author Gabriel Nicolás González Ferreira (gabrielinuz@fi.mdp.edu.ar)
+ * @brief Banco binario de presets: un archivo con N registros fijos y un índice de nombres.
+ * @version 2.8
+ * @date 2026-10-16
+ * @copyright Copyright (c) 2025. This project is released under the Apache License.
+ * @link http://www.apache.org/licenses/LICENSE-2.0
+ */
+#pragma once
+
+#include "MappedFile.hpp"
+#include "PresetImage.hpp"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * @class PresetBank
+ * @brief Acceso aleatorio, mapeado en memoria, a miles de presets guardados en un solo archivo.
+ * @details Recorrer una biblioteca de miles de CSV obligaba a abrir y parsear cada archivo.
+ * El banco guarda todos los presets en un archivo binario (extensión .mccbank):
+ *
+ *     Header (32 bytes) | índice de nombres (N x NAME_SIZE) | registros (N x sizeof(PresetImage))
+ *
+ * El archivo se mapea con MappedFile y cada registro es una PresetImage trivialmente
+ * copiable, así que get(i) es un desplazamiento de puntero, sin E/S ni parseo. El índice
+ * de nombres está separado de los registros para listar el banco sin tocar los datos.
+ * Los enteros se guardan en el orden de bytes de la máquina (little-endian en x86 y ARM).
+ *
+ * @version 2.8: Formato 2: los registros son la PresetImage con valores de 16 bits. Los bancos
+ * del formato 1 (valores de 8 bits) se siguen abriendo: sus registros se convierten una vez
+ * a memoria propia al abrirlos, y se reescriben en el formato nuevo con write().
+ */
+class PresetBank
+{
+    public:
+        /// @brief Bytes reservados para cada nombre (terminado en '\0', se trunca si es más largo).
+        static constexpr std::size_t NAME_SIZE = 64;
+
+        /// @brief Versión del formato; open() rechaza bancos de otra versión (salvo la 1, que convierte).
+        /// @version 2.8: 2 (valores de 16 bits).
+        static constexpr std::uint32_t FORMAT_VERSION = 2;
+
+        /// @brief Un preset con nombre, para escribir un banco.
+        struct Entry
+        {
+            std::string name;
+            PresetImage image;
+        };
+
+        /**
+         * @brief Mapea un banco existente. Un banco abierto antes se cierra.
+         * @param filename La ruta del archivo .mccbank.
+         * @return true Si el archivo existe y tiene un encabezado y tamaño válidos.
+         */
+        bool open(const std::string& filename);
+
+        /** @brief Libera el mapeo; el banco queda vacío. */
+        void close();
+
+        /** @brief Indica si hay un banco abierto. */
+        bool isOpen() const { return m_file != nullptr; }
+
+        /** @brief Cantidad de presets del banco. */
+        std::size_t size() const { return m_count; }
+
+        /**
+         * @brief Nombre del preset @p index, apuntando dentro del mapeo.
+         * @param index Índice del preset (menor que size()).
+         */
+        std::string_view getName(std::size_t index) const;
+
+        /**
+         * @brief El preset @p index, apuntando dentro del mapeo (válido hasta close()).
+         * @param index Índice del preset (menor que size()).
+         */
+        const PresetImage& get(std::size_t index) const { return m_records[index]; }
+
+        /**
+         * @brief Busca un preset por nombre.
+         * @return int El índice, o -1 si no existe.
+         */
+        int find(std::string_view name) const;
+
+        /**
+         * @brief Escribe un banco nuevo con los presets dados.
+         * @param filename La ruta del archivo a crear (se reemplaza si existe).
+         * @param entries Los presets, en el orden en que quedarán en el banco.
+         * @return true Si el archivo se escribió completo.
+         */
+        static bool write(const std::string& filename, const std::vector<Entry>& entries);
+
+        /**
+         * @brief Importa presets CSV (CC#;Value;Active) a un banco nuevo.
+         * @details El nombre de cada preset es el nombre del archivo sin ruta ni extensión.
+         * Los archivos que no pueden leerse se saltan con un aviso por std::cerr.
+         * @param csvFiles Las rutas de los CSV a importar.
+         * @param bankFile La ruta del banco a crear.
+         * @return std::size_t La cantidad de presets importados (0 si no se pudo escribir).
+         */
+        static std::size_t importCsv(const std::vector<std::string>& csvFiles, const std::string& bankFile);
+
+        /**
+         * @brief Exporta cada preset del banco a un CSV "<nombre>.csv" en @p directory.
+         * @return std::size_t La cantidad de archivos escritos.
+         */
+        std::size_t exportCsv(const std::string& directory) const;
+
+    private:
+        /// @brief Encabezado del archivo, al comienzo del banco.
+        struct Header
+        {
+            char magic[8];             ///< "MCCBANK\0"
+            std::uint32_t version;     ///< FORMAT_VERSION.
+            std::uint32_t count;       ///< Cantidad de presets.
+            std::uint32_t nameSize;    ///< NAME_SIZE con el que se escribió.
+            std::uint32_t recordSize;  ///< sizeof(PresetImage) con el que se escribió.
+            std::uint64_t reserved;    ///< Para futuras versiones; se escribe en 0.
+        };
+        static_assert(sizeof(Header) == 32, "PresetBank header must be 32 bytes");
+        static_assert((sizeof(Header) + NAME_SIZE) % alignof(PresetImage) == 0,
+                      "Records must stay aligned inside the mapping");
+
+        /// @brief @version 2.8: Registro del formato 1 (valores de 8 bits), solo para leerlo.
+        struct RecordV1
+        {
+            std::array<unsigned char, PresetImage::CONTROLLERS> values;
+            std::array<std::uint64_t, PresetImage::CONTROLLERS / 64> present;
+            std::array<std::uint64_t, PresetImage::CONTROLLERS / 64> active;
+        };
+        static_assert(sizeof(RecordV1) == 160, "Format 1 records are 160 bytes");
+
+        std::unique_ptr<MappedFile> m_file;   ///< Mapeo del banco abierto.
+        std::vector<PresetImage> m_converted; ///< @version 2.8: Registros de un banco del formato 1, ya convertidos.
+        const char* m_names = nullptr;        ///< Inicio del índice de nombres.
+        const PresetImage* m_records = nullptr; ///< Inicio de los registros.
+        std::size_t m_count = 0;              ///< Cantidad de presets.
+};
@@ -0,0 +1,87 @@
+/**
+ * @file PresetImage.hpp
+ * @author Gabriel Nicolás González Ferreira (gabrielinuz@fi.mdp.edu.ar)
+ * @brief Imagen de un preset en memoria: un arreglo fijo de 128 CCs con bitmap de presencia.
+ * @version 2.8
+ * @date 2026-10-16
+ * @copyright Copyright (c) 2025. This project is released under the Apache License.
+ * @link http://www.apache.org/licenses/LICENSE-2.0
+ */
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+/**
+ * @struct PresetImage
+ * @brief Valores y estado de activación de los 128 CCs de un preset, indexados por CC#.
+ * @details Reemplaza al std::map<int, PresetValue>: los números de CC son densos (0-127),
+ * así que un arreglo fijo indexado por CC# alcanza. Un bitmap indica qué CCs trae el
+ * preset y otro cuáles están activos. Ocupa siempre lo mismo (160 bytes), no reserva
+ * memoria y es trivialmente copiable, así que puede guardarse o copiarse con memcpy.
+ *
+ * @version 2.8: Los valores son de 16 bits para guardar completos los controles de 14 bits
+ * (0-16383), y un tercer bitmap marca los CC# que son MSB de un par (ver ParameterStore::snapshot()).
+ * Ahora ocupa 304 bytes.
+ */
+struct PresetImage
+{
+    /// @brief Cantidad de números de Control Change.
+    static constexpr std::size_t CONTROLLERS = 128;
+
+    std::array<std::uint16_t, CONTROLLERS> values{};  ///< Valor de cada CC (0-127, o 0-16383 en los de 14 bits). @version 2.8: 16 bits.
+    std::array<std::uint64_t, CONTROLLERS / 64> present{}; ///< Bit n: el preset trae el CC n.
+    std::array<std::uint64_t, CONTROLLERS / 64> active{};  ///< Bit n: el CC n está activo.
+    std::array<std::uint64_t, CONTROLLERS / 64> highResolution{}; ///< @version 2.8: Bit n: el CC n es un control de 14 bits.
+
+    /** @brief Indica si el preset trae un valor para @p cc. */
+    bool has(int cc) const { return (present[cc >> 6] >> (cc & 63)) & 1u; }
+
+    /** @brief Valor guardado para @p cc (solo tiene sentido si has(cc)). */
+    int value(int cc) const { return values[cc]; }
+
+    /** @brief Estado de activación guardado para @p cc. */
+    bool isActive(int cc) const { return (active[cc >> 6] >> (cc & 63)) & 1u; }
+
+    /** @brief @version 2.8: Indica si @p cc es el MSB de un control de 14 bits (su LSB es cc + 32). */
+    bool isHighResolution(int cc) const { return (highResolution[cc >> 6] >> (cc & 63)) & 1u; }
+
+    /** @brief @version 2.8: Marca @p cc como control de 14 bits (o de 7 bits). */
+    void setHighResolution(int cc, bool isHighResolution)
+    {
+        const std::uint64_t bit = std::uint64_t(1) << (cc & 63);
+        highResolution[cc >> 6] = isHighResolution ? (highResolution[cc >> 6] | bit) : (highResolution[cc >> 6] & ~bit);
+    }
+
+    /**
+     * @brief Guarda el valor y la activación de un CC (una línea del preset).
+     * @param cc El número de CC (0-127).
+     * @param value El valor (0-127, o 0-16383 en un control de 14 bits).
+     * @param isActive El estado de activación.
+     */
+    void set(int cc, int value, bool isActive)
+    {
+        const std::uint64_t bit = std::uint64_t(1) << (cc & 63);
+        values[cc] = static_cast<std::uint16_t>(value);
+        present[cc >> 6] |= bit;
+        active[cc >> 6] = isActive ? (active[cc >> 6] | bit) : (active[cc >> 6] & ~bit);
+    }
+
+    /** @brief Vacía el preset. */
+    void clear() { *this = PresetImage{}; }
+
+    /** @brief Cantidad de CCs que trae el preset. */
+    std::size_t count() const
+    {
+        std::size_t total = 0;
+        for (std::uint64_t word : present)
+        {
+            for (; word; word &= word - 1) ++total;
+        }
+        return total;
+    }
+};
+
+static_assert(std::is_trivially_copyable<PresetImage>::value, "PresetImage must stay trivially copyable");
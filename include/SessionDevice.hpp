@@ -0,0 +1,25 @@
+/**
+ * @file SessionDevice.hpp
+ * @author Gabriel Nicolás González Ferreira (gabrielinuz@fi.mdp.edu.ar)
+ * @brief Define la estructura de datos de un dispositivo dentro de una sesión multi-puerto.
+ * @version 2.6
+ * @date 2026-10-16
+ * @copyright Copyright (c) 2025. This project is released under the Apache License.
+ * @link http://www.apache.org/licenses/LICENSE-2.0
+ */
+#pragma once
+
+#include <string>
+
+/**
+ * @brief Un sintetizador del rack: su puerto de salida, su canal y su layout.
+ * @details Cada dispositivo de una sesión se edita en su propia ventana (MainWindow) con
+ * su propio MidiService. El puerto se guarda por nombre porque los índices de RtMidi
+ * cambian al conectar o desconectar interfaces.
+ */
+struct SessionDevice
+{
+    std::string port_name;   ///< Nombre del puerto de salida (vacío = sin puerto).
+    int channel = 0;         ///< El canal MIDI (0-15).
+    std::string layout_path; ///< Ruta del layout CSV (vacía = sin layout).
+};
@@ -11,6 +11,16 @@
 
 #include <string>
 
+/**
+ * @brief @version 2.9: Cómo se direcciona un parámetro en el dispositivo.
+ */
+enum class ParameterType : unsigned char
+{
+    ControlChange, ///< Un CC (o un par de 14 bits).
+    Nrpn,          ///< Un NRPN: dirección por CC 99/98 y dato por CC 6/38.
+    Rpn            ///< Un RPN: dirección por CC 101/100 y dato por CC 6/38.
+};
+
 /**
  * @brief Estructura de datos que contiene la configuración para un control deslizante (slider).
  * @details Esta estructura es utilizada para pasar los datos parseados del archivo
@@ -18,8 +28,12 @@
  */
 struct SliderConfig 
 {
-    int cc_number;              ///< El número de Control Change (CC) MIDI (0-127).
+    int cc_number;              ///< El número de Control Change (CC) MIDI (0-127). @version 2.9: -1 en los NRPN/RPN.
     std::string description;    ///< El texto descriptivo que se mostrará en la GUI junto al slider.
     int min_value;              ///< El valor mínimo que el slider puede enviar (usualmente 0).
-    int max_value;              ///< El valor máximo que el slider puede enviar (usualmente 127).
+    int max_value;              ///< El valor máximo que el slider puede enviar (usualmente 127; hasta 16383 si es de 14 bits).
+    int channel = -1;           ///< @version 2.7: Canal propio (0-15), o -1 para usar el canal de la ventana.
+    bool high_resolution = false; ///< @version 2.8: Control de 14 bits: CC n (MSB) y CC n+32 (LSB), valores 0-16383.
+    ParameterType type = ParameterType::ControlChange; ///< @version 2.9: CC, NRPN o RPN.
+    int parameter_number = 0;   ///< @version 2.9: Número de NRPN/RPN (0-16383); en los NRPN high_resolution indica dato de 14 bits (CC 6 y 38).
 };
\ No newline at end of file
@@ -10,8 +10,9 @@
 #pragma once
 
 #include "IMidiControl.hpp"
-#include "SliderConfig.hpp"
+#include "ParameterStore.hpp"
 #include "MidiService.hpp"
+#include "MidiLearnMap.hpp"
 #include <FL/Fl_Slider.H>
 #include <FL/Fl_Box.H>
 #include <FL/Fl_Group.H>
@@ -27,16 +28,22 @@
  * y maneja el callback para enviar mensajes MIDI a través del MidiService.
  * @version 0.5: Se implementan los nuevos métodos virtuales de IMidiControl.
   * @version 0.6: Se añade un checkbox para activar/desactivar el control.
+ * @version 1.4: El valor, el rango y el estado de activación se leen y escriben en una fila
+ * del ParameterStore; el slider solo los muestra.
+ * @version 1.5: bind() permite reutilizar los widgets para otra fila (lista virtualizada).
+ * @version 2.4: En modo MIDI Learn, tocar el slider lo elige como destino en lugar de enviar.
+ * @version 2.8: Una fila de 14 bits recorre 0-16383 y envía el par MSB/LSB.
  */
 class SliderControl : public IMidiControl 
 {
     public:
         /**
         * @brief Construye un nuevo objeto SliderControl.
-        * @param config La configuración (CC#, descripción, rango) para este slider.
+        * @param store El almacén de parámetros que contiene el estado del control.
+        * @param index La fila del almacén que este slider representa.
         * @param midiService Un puntero compartido al servicio MIDI para enviar mensajes.
         */
-        SliderControl(const SliderConfig& config, std::shared_ptr<MidiService> midiService);
+        SliderControl(std::shared_ptr<ParameterStore> store, std::size_t index, std::shared_ptr<MidiService> midiService);
 
         /** @copydoc IMidiControl::createWidgets() */
         void createWidgets(int x, int y, int w, int h, unsigned char* currentMidiChannel) override;
@@ -67,6 +74,23 @@ class SliderControl : public IMidiControl
         /// --- @version 0.6: Implementación de los métodos de activación ---
         void setActive(bool active) override;
         bool isActive() const override;
+
+        /** @copydoc IMidiControl::refresh() */
+        void refresh() override;
+
+        /**
+         * @brief @version 1.5: Reasocia los widgets ya creados a otra fila del almacén.
+         * @details La usa VirtualControlList para reciclar filas al hacer scroll: se
+         * actualizan etiqueta, tooltip, rango, valor y activación sin crear widgets.
+         * @param index La nueva fila del almacén.
+         */
+        void bind(std::size_t index);
+
+        /** @brief @version 1.5: Devuelve la fila del almacén que muestra este slider. */
+        std::size_t getIndex() const { return m_index; }
+
+        /** @brief @version 2.4: Tabla de MIDI Learn compartida (nullptr = sin Learn). */
+        void setLearnMap(std::shared_ptr<MidiLearnMap> learnMap) { m_learnMap = learnMap; }
         
         /**
         * @brief Callback estático que FLTK puede invocar.
@@ -90,23 +114,30 @@ class SliderControl : public IMidiControl
         */
         void sliderCallback();
 
+        /** @brief @version 2.7: Texto del tooltip de una fila (CC# y, si lo tiene, su canal propio). */
+        std::string tooltipFor(std::size_t index) const;
+
         /// @version 0.6: Lógica del callback del checkbox
         void onCheckboxClicked();
 
-        /// @brief Configuración específica para este slider.
-        SliderConfig m_config;
+        /// @brief @version 1.4: Almacén de parámetros y fila que representa este slider.
+        std::shared_ptr<ParameterStore> m_store;
+        std::size_t m_index;
 
         /// @brief Puntero compartido al servicio MIDI.
         std::shared_ptr<MidiService> m_midiService;
 
+        /// @brief @version 2.4: MIDI Learn; el slider se arma a sí mismo al tocarlo en modo Learn.
+        std::shared_ptr<MidiLearnMap> m_learnMap;
+
         /// @brief Puntero al canal MIDI actual, propiedad de MainWindow.
         unsigned char* m_currentMidiChannel;
 
         /// @brief Almacena el texto del tooltip para asegurar que el puntero sea válido durante la vida del widget.
         std::string m_tooltipText;
 
-        /// @version 0.6: Estado de activación
-        bool m_isActive;
+        /** @brief Aplica el estado de activación del almacén a los widgets. */
+        void applyActiveState();
 
         // --- Widgets de FLTK ---
         Fl_Group* m_group;      ///< Un grupo para mantener juntos la etiqueta y el slider.
@@ -0,0 +1,114 @@
+/**
+ * @file SpscRingBuffer.hpp
+ * @author Gabriel Nicolás González Ferreira (gabrielinuz@fi.mdp.edu.ar)
+ * @brief Cola circular acotada y sin bloqueos para un productor y un consumidor.
+ * @version 1.2
+ * @date 2026-10-16
+ * @copyright Copyright (c) 2025. This project is released under the Apache License.
+ * @link http://www.apache.org/licenses/LICENSE-2.0
+ */
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+
+/**
+ * @class SpscRingBuffer
+ * @brief Ring buffer lock-free de capacidad fija (single-producer / single-consumer).
+ * @details Un único hilo puede llamar a tryPush() y un único hilo (distinto) a tryPop().
+ * No reserva memoria después de construido y nunca bloquea: si la cola está llena,
+ * tryPush() devuelve false y el llamador decide qué hacer (por ejemplo, contar la pérdida).
+ * Los índices crecen libremente y se enmascaran con (Capacity - 1), por eso la capacidad
+ * debe ser potencia de dos.
+ * @tparam T Tipo de elemento. Debe ser trivialmente copiable (ej. MidiMessage).
+ * @tparam Capacity Cantidad máxima de elementos (potencia de dos).
+ */
+template <typename T, std::size_t Capacity>
+class SpscRingBuffer
+{
+    static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+
+    public:
+        /**
+         * @brief Encola un elemento (solo desde el hilo productor).
+         * @param item El elemento a copiar en la cola.
+         * @return true Si se encoló. false si la cola estaba llena.
+         */
+        bool tryPush(const T& item)
+        {
+            const std::size_t head = m_head.load(std::memory_order_relaxed);
+            if (head - m_tail.load(std::memory_order_acquire) >= Capacity)
+            {
+                return false;
+            }
+            m_buffer[head & (Capacity - 1)] = item;
+            m_head.store(head + 1, std::memory_order_release);
+            return true;
+        }
+
+        /**
+         * @brief Encola varios elementos con una única publicación (solo desde el hilo productor).
+         * @details El consumidor ve el lote completo de una vez, nunca una parte a medio escribir.
+         * @param count Cantidad de elementos a encolar.
+         * @param generator Función (std::size_t i) -> T que produce el elemento i del lote.
+         * @return std::size_t Cuántos elementos se encolaron (menos que @p count si no había lugar).
+         */
+        template <typename Generator>
+        std::size_t tryPushBulk(std::size_t count, Generator generator)
+        {
+            const std::size_t head = m_head.load(std::memory_order_relaxed);
+            const std::size_t free = Capacity - (head - m_tail.load(std::memory_order_acquire));
+            const std::size_t pushed = count < free ? count : free;
+            for (std::size_t i = 0; i < pushed; ++i)
+            {
+                m_buffer[(head + i) & (Capacity - 1)] = generator(i);
+            }
+            m_head.store(head + pushed, std::memory_order_release);
+            return pushed;
+        }
+
+        /**
+         * @brief Desencola un elemento (solo desde el hilo consumidor).
+         * @param[out] item Destino del elemento desencolado.
+         * @return true Si había un elemento. false si la cola estaba vacía.
+         */
+        bool tryPop(T& item)
+        {
+            const std::size_t tail = m_tail.load(std::memory_order_relaxed);
+            if (tail == m_head.load(std::memory_order_acquire))
+            {
+                return false;
+            }
+            item = m_buffer[tail & (Capacity - 1)];
+            m_tail.store(tail + 1, std::memory_order_release);
+            return true;
+        }
+
+        /** @brief Cantidad aproximada de elementos encolados (válida desde cualquier hilo). */
+        std::size_t size() const
+        {
+            const std::size_t tail = m_tail.load(std::memory_order_acquire);
+            const std::size_t head = m_head.load(std::memory_order_acquire);
+            return head - tail;
+        }
+
+        /** @brief Lugar libre en este instante (desde el productor: tryPushBulk() encola al menos esto). */
+        std::size_t freeSpace() const { return Capacity - size(); }
+
+        /** @brief Indica si la cola está vacía en este instante. */
+        bool empty() const { return size() == 0; }
+
+        /** @brief Capacidad máxima de la cola. */
+        static constexpr std::size_t capacity() { return Capacity; }
+
+    private:
+        /// @brief Índice de escritura; solo lo modifica el productor. Alineado para evitar false sharing.
+        alignas(64) std::atomic<std::size_t> m_head{0};
+
+        /// @brief Índice de lectura; solo lo modifica el consumidor.
+        alignas(64) std::atomic<std::size_t> m_tail{0};
+
+        /// @brief Almacenamiento de los elementos.
+        alignas(64) std::array<T, Capacity> m_buffer{};
+};
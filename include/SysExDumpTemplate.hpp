@@ -0,0 +1,128 @@
+/**
+ * @file SysExDumpTemplate.hpp
+ * @author Gabriel Nicolás González Ferreira (gabrielinuz@fi.mdp.edu.ar)
+ * @brief Plantilla de pedido de volcado SysEx de un dispositivo y decodificador de su respuesta a valores de CC.
+ * @version 3.1
+ * @date 2026-10-16
+ * @copyright Copyright (c) 2025. This project is released under the Apache License.
+ * @link http://www.apache.org/licenses/LICENSE-2.0
+ */
+#pragma once
+
+#include "PresetImage.hpp"
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * @class SysExDumpTemplate
+ * @brief Describe cómo pedirle a un dispositivo su estado actual y cómo leer lo que responde.
+ * @details Vive junto al layout en un CSV "synth.csv" -> "synth.dump.csv" (ver pathFor()):
+ *
+ *     Key;Value
+ *     Request;F0 3E 13 00 00 7F 00 F7   bytes del pedido en hexadecimal; "CH" = canal (0-15)
+ *     Response;F0 3E 13 00 10           prefijo que identifica la respuesta
+ *     Size;392                          tamaño esperado de la respuesta (opcional)
+ *     Timeout;1000                      ms de espera por intento (opcional)
+ *     Retries;2                         reintentos después del primer pedido (opcional)
+ *     69;85                             CC#;posición del byte en la respuesta (F0 = 0)
+ *     1;20;21                           CC#;posición del MSB;posición del LSB (control de 14 bits)
+ *
+ * decode() copia esos bytes a una PresetImage, así la respuesta se aplica al almacén en una
+ * sola pasada con ParameterStore::applyPreset(). Se usa desde el hilo de FLTK.
+ */
+class SysExDumpTemplate
+{
+    public:
+        /// @brief Espera por defecto de cada intento, sin contar la transmisión de la respuesta.
+        static constexpr std::chrono::milliseconds DEFAULT_TIMEOUT{1000};
+
+        /// @brief Reintentos por defecto después del primer pedido.
+        static constexpr unsigned int DEFAULT_RETRIES = 2;
+
+        /// @brief Posición de un CC que la respuesta no trae.
+        static constexpr std::int32_t NO_OFFSET = -1;
+
+        SysExDumpTemplate() { clear(); }
+
+        /**
+         * @brief Ruta de la plantilla de un layout ("synth.csv" -> "synth.dump.csv").
+         * @param layoutPath La ruta del layout CSV.
+         */
+        static std::string pathFor(const std::string& layoutPath);
+
+        /**
+         * @brief Carga la plantilla desde un archivo; reemplaza la actual.
+         * @return true Si el archivo existía y define un pedido válido.
+         */
+        bool load(const std::string& filename);
+
+        /**
+         * @brief Interpreta el contenido de una plantilla ya en memoria. Las líneas inválidas se
+         * saltan con un aviso por std::cerr, como en los demás parsers.
+         * @return true Si la plantilla define un pedido SysEx válido y al menos un CC.
+         */
+        bool parseBuffer(std::string_view content);
+
+        /** @brief Vacía la plantilla. */
+        void clear();
+
+        /** @brief Indica si hay un pedido que enviar (load() o parseBuffer() tuvieron éxito). */
+        bool isValid() const { return m_valid; }
+
+        /**
+         * @brief Los bytes del pedido para un canal ("CH" reemplazado por @p channel).
+         * @param channel El canal MIDI de la ventana (0-15).
+         */
+        std::vector<unsigned char> buildRequest(unsigned char channel) const;
+
+        /**
+         * @brief Indica si un SysEx recibido es la respuesta a un pedido de esta plantilla.
+         * @details Empieza con el prefijo de Response y, si se declaró Size, mide eso.
+         */
+        bool matches(const unsigned char* data, std::size_t size) const;
+
+        /**
+         * @brief Copia a @p image el valor de cada CC que trae la respuesta.
+         * @details Los CC ya presentes en @p image (ej. ParameterStore::snapshot()) conservan su
+         * activación; los nuevos quedan activos. Los bytes fuera de la respuesta se ignoran.
+         * @return std::size_t La cantidad de CCs decodificados.
+         */
+        std::size_t decode(const unsigned char* data, std::size_t size, PresetImage& image) const;
+
+        /** @brief Tamaño declarado de la respuesta (0 = cualquiera). */
+        std::size_t getExpectedSize() const { return m_expectedSize; }
+
+        /** @brief Espera de cada intento, sin contar la transmisión de la respuesta. */
+        std::chrono::milliseconds getTimeout() const { return m_timeout; }
+
+        /** @brief Reintentos después del primer pedido. */
+        unsigned int getRetries() const { return m_retries; }
+
+        /** @brief Cantidad de CCs que la plantilla sabe leer. */
+        std::size_t getMappedCount() const { return m_mappedCount; }
+
+    private:
+        /// @brief Valor de m_request que se reemplaza por el canal ("CH" en el archivo).
+        static constexpr std::uint16_t CHANNEL_TOKEN = 0x100;
+
+        /// @brief Lee "F0 3E CH ..." a @p out; false si algún token no es un byte o "CH".
+        static bool parseHex(std::string_view text, std::vector<std::uint16_t>& out);
+
+        std::vector<std::uint16_t> m_request;  ///< Bytes del pedido; CHANNEL_TOKEN = canal.
+        std::vector<std::uint16_t> m_response; ///< Prefijo de la respuesta; CHANNEL_TOKEN acepta cualquier byte.
+        std::size_t m_expectedSize;
+        std::chrono::milliseconds m_timeout;
+        unsigned int m_retries;
+
+        /// @brief Posición del (MSB del) valor de cada CC# en la respuesta, o NO_OFFSET.
+        std::array<std::int32_t, PresetImage::CONTROLLERS> m_offset;
+        /// @brief Posición del LSB de los controles de 14 bits, o NO_OFFSET.
+        std::array<std::int32_t, PresetImage::CONTROLLERS> m_lsbOffset;
+        std::size_t m_mappedCount;
+        bool m_valid;
+};
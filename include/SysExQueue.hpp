@@ -0,0 +1,80 @@
+/**
+ * @file SysExQueue.hpp
+ * @author Gabriel Nicolás González Ferreira (gabrielinuz@fi.mdp.edu.ar)
+ * @brief Cola sin bloqueos de mensajes SysEx recibidos, sobre un buffer de bytes reservado de antemano.
+ * @version 3.0
+ * @date 2026-10-16
+ * @copyright Copyright (c) 2025. This project is released under the Apache License.
+ * @link http://www.apache.org/licenses/LICENSE-2.0
+ */
+#pragma once
+
+#include "SpscRingBuffer.hpp"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+/**
+ * @class SysExQueue
+ * @brief Lleva volcados SysEx completos (F0 ... F7) del hilo de RtMidi al hilo consumidor.
+ * @details Los bytes se copian en un buffer circular de CAPACITY bytes reservado en el
+ * constructor; un SpscRingBuffer de registros (inicio, tamaño, instante) los delimita. tryPush()
+ * no reserva memoria ni bloquea: si el mensaje no entra se descarta entero y devuelve false.
+ * Un mensaje más grande que CAPACITY nunca entra.
+ *
+ * Un único hilo llama a tryPush() (el handler de RtMidi) y un único hilo a tryPop().
+ */
+class SysExQueue
+{
+    public:
+        /// @brief Bytes del buffer circular (potencia de dos): varios volcados de sintetizador completos.
+        static constexpr std::size_t CAPACITY = 256 * 1024;
+
+        /// @brief Máximo de mensajes esperando al consumidor.
+        static constexpr std::size_t MAX_MESSAGES = 256;
+
+        SysExQueue() : m_bytes(new unsigned char[CAPACITY]) {}
+
+        SysExQueue(const SysExQueue&) = delete;
+        SysExQueue& operator=(const SysExQueue&) = delete;
+
+        /**
+         * @brief Copia un mensaje en la cola (solo desde el hilo productor).
+         * @param data Los bytes del mensaje, F0 y F7 incluidos.
+         * @param size Cantidad de bytes.
+         * @param timestampNs Instante de llegada (ns de steady_clock, como MidiInputEvent).
+         * @return true Si se encoló; false si no había lugar (el mensaje se descarta).
+         */
+        bool tryPush(const unsigned char* data, std::size_t size, std::int64_t timestampNs);
+
+        /**
+         * @brief Extrae el mensaje más antiguo (solo desde el hilo consumidor).
+         * @param[out] out Recibe los bytes; conserva su capacidad entre llamadas.
+         * @param[out] timestampNs Si no es nullptr, recibe el instante de llegada.
+         * @return true Si había un mensaje.
+         */
+        bool tryPop(std::vector<unsigned char>& out, std::int64_t* timestampNs = nullptr);
+
+        /** @brief Indica si no hay mensajes esperando. */
+        bool empty() const { return m_records.empty(); }
+
+    private:
+        /// @brief Ubicación de un mensaje en m_bytes (posiciones crecientes, se enmascaran con CAPACITY - 1).
+        struct Record
+        {
+            std::size_t begin;
+            std::size_t size;
+            std::int64_t timestampNs;
+        };
+
+        SpscRingBuffer<Record, MAX_MESSAGES> m_records;
+        std::unique_ptr<unsigned char[]> m_bytes;
+
+        /// @brief Próxima posición de escritura; solo la usa el productor.
+        std::size_t m_writePosition = 0;
+
+        /// @brief Hasta dónde liberó el consumidor; lo publica tryPop().
+        alignas(64) std::atomic<std::size_t> m_readPosition{0};
+};
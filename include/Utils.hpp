@@ -9,6 +9,7 @@
 #define UTILS_HPP
 
 #include <string>
+#include <string_view>
 
 namespace Utils
 {
@@ -27,6 +28,43 @@ namespace Utils
      * @return El directorio que contiene el archivo (ej: /home/user/presets/).
      */
     std::string getDirectoryFromPath(const std::string& filePath);
+
+    /**
+     * @brief @version 3.1: Cambia la extensión de una ruta por un sufijo, para los archivos que acompañan al layout.
+     * Por ejemplo, ("/home/user/synth.csv", ".dump.csv") -> "/home/user/synth.dump.csv".
+     * Un punto en un directorio ("./presets/synth") no cuenta como extensión.
+     * @param filePath La ruta del archivo.
+     * @param suffix El sufijo que reemplaza a la extensión (con su punto).
+     * @return La ruta sin la extensión original y con @p suffix.
+     */
+    std::string replaceExtension(const std::string& filePath, const std::string& suffix);
+
+    /**
+     * @brief @version 1.7: Convierte texto a entero sin excepciones ni copias (std::from_chars).
+     * @details Acepta lo mismo que aceptaba std::stoi en los parsers: espacios iniciales,
+     * signo opcional y caracteres sobrantes al final (ej. " 12 " -> 12).
+     * @param text El texto a convertir.
+     * @param[out] value El entero leído (solo se modifica si la conversión tuvo éxito).
+     * @return true Si el texto empieza con un número representable como int.
+     */
+    bool parseInt(std::string_view text, int& value);
+
+    /**
+     * @brief @version 1.7: Separa el primer campo de @p text hasta @p delimiter.
+     * @details Equivale a std::getline(ss, segment, delimiter) sobre una vista: devuelve el
+     * campo y avanza @p text detrás del delimitador (o la deja vacía si no había).
+     * @param[in,out] text El resto de la línea por recorrer.
+     * @param delimiter El separador de campos (';' en los CSV del proyecto).
+     * @return std::string_view El campo, apuntando dentro de @p text.
+     */
+    std::string_view nextField(std::string_view& text, char delimiter);
+
+    /**
+     * @brief @version 1.7: Separa la siguiente línea de @p text, sin el '\n' ni los '\r' finales.
+     * @param[in,out] text El resto del buffer; se avanza detrás del salto de línea.
+     * @return std::string_view La línea, apuntando dentro de @p text.
+     */
+    std::string_view nextLine(std::string_view& text);
 } // namespace Utils
 
 #endif // UTILS_HPP
\ No newline at end of file
@@ -0,0 +1,104 @@
+/**
+ * @file VirtualControlList.hpp
+ * @author Gabriel Nicolás González Ferreira (gabrielinuz@fi.mdp.edu.ar)
+ * @brief Lista virtualizada de sliders para layouts con cientos o miles de parámetros.
+ * @version 2.4
+ * @date 2026-10-16
+ * @copyright Copyright (c) 2025. This project is released under the Apache License.
+ * @link http://www.apache.org/licenses/LICENSE-2.0
+ */
+#pragma once
+
+#include "ParameterStore.hpp"
+#include "SliderControl.hpp"
+#include "MidiService.hpp"
+#include <FL/Fl_Group.H>
+#include <FL/Fl_Scrollbar.H>
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+/**
+ * @class VirtualControlList
+ * @brief Muestra las filas de un ParameterStore creando widgets solo para las visibles.
+ * @details Con Fl_Scroll cada fila del layout tiene su propio grupo de widgets, lo que
+ * para 500-2000 parámetros hace lentas la carga y el scroll. Esta lista mantiene un
+ * conjunto fijo de SliderControl (tantos como filas entran en el área visible) y, al
+ * hacer scroll, los reasocia a otras filas del almacén con SliderControl::bind().
+ * El costo de cargar y de desplazarse depende del alto de la ventana, no del layout.
+ *
+ * El scroll avanza de a una fila entera, así que las filas nunca quedan cortadas.
+ */
+class VirtualControlList : public Fl_Group
+{
+    public:
+        /// @brief Distancia vertical entre filas (alto del slider + separación).
+        static constexpr int ROW_PITCH = 50;
+
+        /**
+         * @brief Construye la lista vacía.
+         * @param x, y, w, h Posición y tamaño del área visible.
+         * @param store El almacén cuyas filas se muestran.
+         * @param midiService El servicio MIDI que usan los sliders para enviar.
+         * @param currentMidiChannel Puntero al canal MIDI actual, propiedad de MainWindow.
+         */
+        VirtualControlList(int x, int y, int w, int h,
+                           std::shared_ptr<ParameterStore> store,
+                           std::shared_ptr<MidiService> midiService,
+                           unsigned char* currentMidiChannel);
+
+        /**
+         * @brief Vuelve a leer la cantidad de filas del almacén y muestra desde la primera.
+         * @details Se llama después de cargar un layout.
+         */
+        void reload();
+
+        /** @brief Elimina las filas visibles (ej. antes de cargar un layout nuevo). */
+        void clearRows();
+
+        /** @brief Actualiza las filas visibles desde el almacén tras una operación masiva. */
+        void refresh();
+
+        /** @brief @version 2.4: Tabla de MIDI Learn que usan las filas (se aplica también a las futuras). */
+        void setLearnMap(std::shared_ptr<MidiLearnMap> learnMap);
+
+        /** @brief Primera fila del almacén que está a la vista. */
+        std::size_t getFirstRow() const { return m_firstRow; }
+
+        /** @brief Cantidad de filas con widgets propios (no depende del tamaño del layout). */
+        std::size_t getPoolSize() const { return m_rows.size(); }
+
+        /** @brief Recalcula cuántas filas entran cuando cambia el tamaño de la ventana. */
+        void resize(int x, int y, int w, int h) override;
+
+        /** @brief Atiende la rueda del mouse para desplazar la lista. */
+        int handle(int event) override;
+
+    private:
+        /** @brief Callback estático de la barra de desplazamiento. */
+        static void onScroll_static(Fl_Widget* w, void* userdata);
+
+        /** @brief Cantidad de filas que entran completas en el área visible. */
+        std::size_t visibleRows() const;
+
+        /** @brief Crea o elimina filas del pool para que coincida con el área visible. */
+        void rebuildPool();
+
+        /**
+         * @brief Muestra el almacén a partir de @p first, reasociando las filas del pool.
+         * @param first La primera fila a mostrar; se recorta al rango válido.
+         */
+        void scrollTo(std::size_t first);
+
+        /** @brief Sincroniza la barra de desplazamiento con la posición y el tamaño actuales. */
+        void updateScrollbar();
+
+        std::shared_ptr<ParameterStore> m_store;
+        std::shared_ptr<MidiService> m_midiService;
+        unsigned char* m_currentMidiChannel;
+        std::shared_ptr<MidiLearnMap> m_learnMap; ///< @version 2.4
+
+        Fl_Scrollbar* m_scrollbar;
+        std::vector<std::unique_ptr<SliderControl>> m_rows; ///< Pool de filas reutilizables.
+        std::size_t m_firstRow; ///< Fila del almacén que muestra m_rows[0].
+};
@@ -0,0 +1,148 @@
+/**
+ * @file XYPadControl.hpp
+ * @author Gabriel Nicolás González Ferreira (gabrielinuz@fi.mdp.edu.ar)
+ * @brief Pad XY que mezcla cuatro presets con pesos bilineales según la posición del cursor.
+ * @version 2.8
+ * @date 2026-10-16
+ * @copyright Copyright (c) 2025. This project is released under the Apache License.
+ * @link http://www.apache.org/licenses/LICENSE-2.0
+ */
+#pragma once
+
+#include "IMidiControl.hpp"
+#include "ParameterStore.hpp"
+#include "MidiService.hpp"
+#include "PresetImage.hpp"
+#include <FL/Fl_Group.H>
+#include <FL/Fl_Button.H>
+#include <FL/Fl_Positioner.H>
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+/**
+ * @class XYPadControl
+ * @brief Implementa IMidiControl para un pad 2D que interpola entre cuatro presets.
+ * @details Cada esquina del pad tiene asignado un PresetImage (A arriba a la izquierda,
+ * B arriba a la derecha, C abajo a la izquierda, D abajo a la derecha). Al mover el cursor,
+ * cada CC toma la mezcla bilineal de los cuatro valores:
+ *
+ *     v = A·(1-x)(1-y) + B·x(1-y) + C·(1-x)y + D·xy
+ *
+ * Los pesos se calculan una vez por movimiento en punto fijo (suman 65536) y la mezcla es
+ * un bucle sin ramas sobre los arreglos densos de 128 valores de los presets, que el
+ * compilador vectoriza. Después se comparan los valores mezclados con los últimos enviados
+ * (otro bucle vectorizable) y solo los CC que cambiaron se envían, como un único lote.
+ *
+ * El pad maneja los CC que las cuatro esquinas traen activos. Como un recall de preset,
+ * los valores mezclados se escriben en el ParameterStore; al terminar cada movimiento se
+ * dispara el callback del grupo (getWidgetGroup()) para que la ventana refresque los sliders.
+ *
+ * @version 2.8: Los valores se mezclan en 16 bits, así los CC de 14 bits del layout se
+ * interpolan con toda su resolución y salen como par MSB/LSB.
+ *
+ * El pad no corresponde a un único CC: getCcNumber() devuelve -1 y el "valor" del control
+ * es la posición X del cursor en 0-127.
+ */
+class XYPadControl : public IMidiControl
+{
+    public:
+        /// @brief Cantidad de esquinas (presets) del pad.
+        static constexpr int CORNERS = 4;
+
+        /**
+         * @brief Construye un nuevo pad sin esquinas asignadas.
+         * @param store El almacén donde se escriben los valores mezclados.
+         * @param midiService El servicio MIDI por el que se envían los lotes.
+         */
+        XYPadControl(std::shared_ptr<ParameterStore> store, std::shared_ptr<MidiService> midiService);
+
+        /** @copydoc IMidiControl::createWidgets() */
+        void createWidgets(int x, int y, int w, int h, unsigned char* currentMidiChannel) override;
+
+        /** @copydoc IMidiControl::getWidgetGroup() */
+        Fl_Widget* getWidgetGroup() override;
+
+        /** @copydoc IMidiControl::getHeight() */
+        int getHeight() const override;
+
+        /** @brief El pad no representa un único CC: devuelve -1. */
+        int getCcNumber() const override;
+
+        /** @copydoc IMidiControl::getDescription() */
+        std::string getDescription() const override;
+
+        /** @copydoc IMidiControl::getRange() */
+        std::string getRange() const override;
+
+        /** @brief Posición X del cursor, en 0-127. */
+        int getCurrentValue() const override;
+
+        /** @brief Mueve el cursor en X (0-127) sin enviar mensajes. */
+        void setCurrentValue(int value) override;
+
+        void setActive(bool active) override;
+        bool isActive() const override;
+
+        /** @copydoc IMidiControl::refresh() */
+        void refresh() override;
+
+        /**
+         * @brief Asigna un preset a una esquina del pad.
+         * @details Los últimos valores enviados se olvidan, así el próximo movimiento envía
+         * todos los CC que maneja el pad.
+         * @param corner La esquina (0 = A, 1 = B, 2 = C, 3 = D).
+         * @param preset El preset de la esquina.
+         */
+        void assignCorner(int corner, const PresetImage& preset);
+
+        /** @brief Indica si las cuatro esquinas tienen un preset asignado. */
+        bool isReady() const;
+
+        /** @brief Cantidad de CC que manejó el último movimiento (los que cambiaron). */
+        std::size_t getLastSentCount() const { return m_lastSentCount; }
+
+        /**
+         * @brief Mezcla las cuatro esquinas en la posición (@p x, @p y) y envía lo que cambió.
+         * @details No toca widgets; lo usa el callback del cursor.
+         * @param x La posición horizontal en [0, 1] (0 = izquierda).
+         * @param y La posición vertical en [0, 1] (0 = arriba).
+         * @return std::size_t La cantidad de CC enviados.
+         */
+        std::size_t moveTo(double x, double y);
+
+        static void onPadMoved_static(Fl_Widget* w, void* userdata);
+        static void onAssignCorner_static(Fl_Widget* w, void* userdata);
+
+    private:
+        void onPadMoved();
+        void onAssignCorner(Fl_Widget* button);
+
+        /** @brief Recalcula qué CC maneja el pad (presentes y activos en las cuatro esquinas). */
+        void updateMask();
+
+        /// @brief Valor de m_lastSent para un CC que todavía no se envió (los valores MIDI son 0-16383).
+        static constexpr std::uint16_t UNKNOWN_VALUE = 0xFFFF;
+
+        std::shared_ptr<ParameterStore> m_store;
+        std::shared_ptr<MidiService> m_midiService;
+        unsigned char* m_currentMidiChannel;
+        bool m_active;
+
+        // --- Datos de la mezcla: arreglos densos indexados por CC# ---
+        std::array<PresetImage, CORNERS> m_corners;
+        std::array<bool, CORNERS> m_assigned;
+        std::array<std::uint64_t, PresetImage::CONTROLLERS / 64> m_maskBits; ///< CC que maneja el pad.
+        std::array<unsigned char, PresetImage::CONTROLLERS> m_mask;     ///< 1 si el pad maneja el CC.
+        std::array<std::uint16_t, PresetImage::CONTROLLERS> m_blended;  ///< Resultado de la mezcla.
+        std::array<unsigned char, PresetImage::CONTROLLERS> m_changed;  ///< 1 si hay que enviar el CC.
+        std::array<std::uint16_t, PresetImage::CONTROLLERS> m_lastSent; ///< Último valor enviado por CC#.
+        std::array<MidiMessage, 2 * PresetImage::CONTROLLERS> m_batch;  ///< Lote reutilizado en cada movimiento (@version 2.8: hasta un par por CC#).
+        std::size_t m_lastSentCount;
+
+        // --- Widgets de FLTK ---
+        Fl_Group* m_group;
+        Fl_Positioner* m_pad;
+        std::array<Fl_Button*, CORNERS> m_cornerButtons;
+};
@@ -6,16 +6,19 @@
  * @date 2025-06-13
  */
 #include "Application.hpp"
+#include "MidiSessionParser.hpp"
 #include <FL/Fl.H>
 
 Application::Application()
 {
     // 1. Crear el servicio MIDI. Se usa shared_ptr porque será compartido con los controles.
     m_midiService = std::make_shared<MidiService>();
+    m_midiInput = std::make_shared<MidiInputService>(); /// @version 2.2: Entrada MIDI
 
     // 2. Crear la ventana principal, inyectando el servicio MIDI.
     //    Se usa unique_ptr porque la aplicación es la única dueña de la ventana.
-    m_mainWindow = std::make_unique<MainWindow>(600, 400, "MIDI CC Editor", m_midiService);
+    m_mainWindow = std::make_unique<MainWindow>(600, 440, "MIDI CC Editor", m_midiService, m_midiInput);
+    m_mainWindow->setSessionHost(this); /// @version 2.6
 }
 
 int Application::run(int argc, char** argv)
@@ -23,6 +26,7 @@ int Application::run(int argc, char** argv)
     // Procesar argumentos de línea de comandos específicos de FLTK.
     Fl::args(argc, argv);
     Fl::visual(FL_RGB); // Mejorar la apariencia visual.
+    Fl::lock(); /// @version 2.2: Habilita Fl::awake() desde el hilo de entrada de RtMidi.
 
     // Por defecto, cargar un layout inicial si existe, si no, se cargará por el usuario.
     // Se recomienda que el usuario cargue el layout explícitamente.
@@ -35,4 +39,76 @@ int Application::run(int argc, char** argv)
     // Iniciar el bucle de eventos de FLTK. Esta función bloqueará la ejecución
     // hasta que todas las ventanas se cierren.
     return Fl::run();
-}
\ No newline at end of file
+}
+
+/// --- @version 2.6: Sesiones multi-dispositivo ---
+
+MainWindow& Application::createDeviceWindow(std::size_t number)
+{
+    DeviceWindow device;
+    device.midiService = std::make_shared<MidiService>(); // Puerto, cola e hilo de salida propios.
+    const std::string title = "MIDI CC Editor - Device " + std::to_string(number);
+    device.window = std::make_unique<MainWindow>(600, 440, title.c_str(), device.midiService);
+    device.window->setSessionHost(this);
+    m_deviceWindows.push_back(std::move(device));
+
+    MainWindow& window = *m_deviceWindows.back().window;
+    window.show();
+    return window;
+}
+
+void Application::addDeviceWindow()
+{
+    const std::size_t number = m_deviceWindows.size() + 2;
+    MainWindow& window = createDeviceWindow(number);
+
+    // Sugerir el puerto siguiente al de la ventana anterior: cada sintetizador del rack en el suyo.
+    auto& service = *m_deviceWindows.back().midiService;
+    const unsigned int num_ports = service.getPortCount();
+    if (num_ports > 1)
+    {
+        SessionDevice device;
+        device.port_name = service.getPortName(static_cast<unsigned int>((number - 1) % num_ports));
+        window.applySessionDevice(device);
+    }
+}
+
+int Application::openSession(const std::string& filename)
+{
+    std::vector<SessionDevice> devices;
+    if (!MidiSessionParser::load(filename, devices))
+    {
+        return -1;
+    }
+
+    // Un dispositivo por ventana, en orden; se crean las que falten y las demás quedan como están.
+    for (std::size_t i = 0; i < devices.size(); ++i)
+    {
+        if (i == 0)
+        {
+            m_mainWindow->applySessionDevice(devices[i]);
+            continue;
+        }
+        MainWindow& window = (i - 1 < m_deviceWindows.size()) ? *m_deviceWindows[i - 1].window : createDeviceWindow(i + 1);
+        if (!window.isShown())
+        {
+            window.show();
+        }
+        window.applySessionDevice(devices[i]);
+    }
+    return static_cast<int>(devices.size());
+}
+
+int Application::saveSession(const std::string& filename)
+{
+    std::vector<SessionDevice> devices;
+    devices.push_back(m_mainWindow->getSessionDevice());
+    for (const auto& device : m_deviceWindows)
+    {
+        if (device.window->isShown())
+        {
+            devices.push_back(device.window->getSessionDevice());
+        }
+    }
+    return MidiSessionParser::save(filename, devices) ? static_cast<int>(devices.size()) : -1;
+}
@@ -0,0 +1,141 @@
+/**
+ * @file CcCoalescer.cpp
+ * @author Gabriel Nicolás González Ferreira (gabrielinuz@fi.mdp.edu.ar)
+ * @brief Implementación de la etapa de coalescencia de mensajes Control Change.
+ * @version 2.8
+ * @date 2026-10-16
+ */
+#include "CcCoalescer.hpp"
+
+CcCoalescer::CcCoalescer()
+    : m_orderHead(0), m_orderTail(0)
+{
+    m_pending.fill(NO_VALUE);
+    m_forced.fill(false);
+    m_paired.fill(false);
+    m_queued.fill(false);
+    reset();
+}
+
+bool CcCoalescer::push(const MidiMessage& message, bool force)
+{
+    if (message.size() != 3 || (message.status() & 0xF0) != 0xB0)
+    {
+        return false; // Solo se coalescen Control Change.
+    }
+
+    const std::size_t key = (message.status() & 0x0F) * CONTROLLERS + message.bytes[1];
+    if (!m_queued[key])
+    {
+        // Primera vez que esta clave queda pendiente: reservar su lugar en el orden de salida.
+        m_order[m_orderTail++ & (KEYS - 1)] = static_cast<unsigned short>(key);
+        m_queued[key] = true;
+    }
+    setPending(key, message.bytes[2], force);
+    return true;
+}
+
+void CcCoalescer::pushPair(const MidiMessage& msb, const MidiMessage& lsb, bool force)
+{
+    push(msb, force);
+    const std::size_t key = (msb.status() & 0x0F) * CONTROLLERS + msb.bytes[1];
+    m_paired[key] = true;
+
+    // El LSB no reserva lugar propio: sale con su MSB (ver pop()). Si ya tenía uno por un push()
+    // suelto, ese lugar queda sin valor y pop() lo saltea.
+    setPending(key + MidiMessage::HIGH_RESOLUTION_LSB_OFFSET, lsb.bytes[2], force);
+}
+
+void CcCoalescer::setPending(std::size_t key, unsigned char value, bool force)
+{
+    if (m_pending[key] != NO_VALUE)
+    {
+        m_coalescedCount.fetch_add(1, std::memory_order_relaxed); // El valor anterior nunca se envía.
+    }
+    m_pending[key] = value;
+    m_forced[key] = m_forced[key] || force;
+}
+
+std::size_t CcCoalescer::pop(MidiMessage* out)
+{
+    while (m_orderHead != m_orderTail)
+    {
+        const std::size_t key = m_order[m_orderHead++ & (KEYS - 1)];
+        const std::size_t cc = key % CONTROLLERS;
+        m_queued[key] = false;
+        if (m_pending[key] == NO_VALUE)
+        {
+            continue; // LSB suelto cuyo valor ya salió con su MSB (ver pushPair()).
+        }
+        if (cc >= MidiMessage::HIGH_RESOLUTION_LSB_OFFSET && cc < 2 * MidiMessage::HIGH_RESOLUTION_LSB_OFFSET &&
+            m_paired[key - MidiMessage::HIGH_RESOLUTION_LSB_OFFSET])
+        {
+            continue; /// @version 2.8: LSB de un par pendiente: sale después de su MSB, no antes.
+        }
+
+        const short value = m_pending[key];
+        const bool forced = m_forced[key];
+        m_pending[key] = NO_VALUE;
+        m_forced[key] = false;
+
+        std::size_t count = 0;
+        if (!forced && value == m_lastSent[key])
+        {
+            m_coalescedCount.fetch_add(1, std::memory_order_relaxed); // El dispositivo ya tiene este valor.
+        }
+        else
+        {
+            m_lastSent[key] = value;
+            out[count++] = MidiMessage::controlChange(static_cast<unsigned char>(key / CONTROLLERS),
+                                                      static_cast<unsigned char>(cc),
+                                                      static_cast<unsigned char>(value));
+        }
+
+        /// @version 2.8: El LSB de un par sale siempre detrás de un MSB transmitido (el receptor
+        /// lo acaba de poner en 0); si el MSB no cambió, sale solo si cambió él.
+        if (m_paired[key])
+        {
+            m_paired[key] = false;
+            const std::size_t lsbKey = key + MidiMessage::HIGH_RESOLUTION_LSB_OFFSET;
+            const short lsbValue = m_pending[lsbKey];
+            const bool lsbForced = m_forced[lsbKey];
+            m_pending[lsbKey] = NO_VALUE;
+            m_forced[lsbKey] = false;
+            if (lsbValue != NO_VALUE && (count > 0 || lsbForced || lsbValue != m_lastSent[lsbKey]))
+            {
+                m_lastSent[lsbKey] = lsbValue;
+                out[count++] = MidiMessage::controlChange(static_cast<unsigned char>(lsbKey / CONTROLLERS),
+                                                          static_cast<unsigned char>(lsbKey % CONTROLLERS),
+                                                          static_cast<unsigned char>(lsbValue));
+            }
+            else if (lsbValue != NO_VALUE)
+            {
+                m_coalescedCount.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+
+        if (count > 0)
+        {
+            return count;
+        }
+    }
+    return 0;
+}
+
+void CcCoalescer::noteDeviceValue(const MidiMessage& message)
+{
+    if (message.size() == 3 && (message.status() & 0xF0) == 0xB0)
+    {
+        const std::size_t key = (message.status() & 0x0F) * CONTROLLERS + message.bytes[1];
+        m_lastSent[key] = message.bytes[2];
+        if (message.bytes[1] < 32)
+        {
+            m_lastSent[key + 32] = 0; // El MSB resetea el LSB en el receptor.
+        }
+    }
+}
+
+void CcCoalescer::reset()
+{
+    m_lastSent.fill(NO_VALUE);
+}
@@ -0,0 +1,97 @@
+/**
+ * @file DumpRequestEngine.cpp
+ * @author Gabriel Nicolás González Ferreira (gabrielinuz@fi.mdp.edu.ar)
+ * @brief Implementación de los plazos y reintentos de los pedidos de volcado SysEx.
+ * @version 3.1
+ * @date 2026-10-16
+ */
+#include "DumpRequestEngine.hpp"
+#include "OutputScheduler.hpp"
+#include <utility>
+
+DumpRequestEngine::DumpRequestEngine(std::shared_ptr<MidiService> midiService)
+    : m_midiService(std::move(midiService)), m_state(State::Idle), m_attempts(0), m_budget(0)
+{
+}
+
+bool DumpRequestEngine::start(const SysExDumpTemplate& dumpTemplate, unsigned char channel, Clock::time_point now)
+{
+    cancel();
+    if (!m_midiService || !dumpTemplate.isValid())
+    {
+        return false;
+    }
+    m_template = dumpTemplate;
+    m_request = std::make_shared<const std::vector<unsigned char>>(m_template.buildRequest(channel));
+
+    // Una respuesta de varios KB tarda en llegar: a 3125 B/s, 4 KB son 1,3 s de cable.
+    m_budget = m_template.getTimeout() +
+               OutputScheduler::estimateDuration(m_template.getExpectedSize(), 1, m_midiService->getByteRate(), 0);
+    m_started = now;
+    if (!sendRequest(now))
+    {
+        m_state = State::Failed;
+        m_finished = now;
+        return false;
+    }
+    return true;
+}
+
+bool DumpRequestEngine::sendRequest(Clock::time_point now)
+{
+    if (!m_midiService->sendSysEx(m_request))
+    {
+        return false;
+    }
+    ++m_attempts;
+    m_deadline = now + m_budget;
+    m_state = State::Waiting;
+    return true;
+}
+
+bool DumpRequestEngine::offer(std::vector<unsigned char>& message)
+{
+    if (m_state != State::Waiting || !m_template.matches(message.data(), message.size()))
+    {
+        return false;
+    }
+    m_response.swap(message);
+    m_state = State::Received;
+    m_finished = Clock::now();
+    return true;
+}
+
+DumpRequestEngine::State DumpRequestEngine::poll(Clock::time_point now)
+{
+    if (m_state != State::Waiting)
+    {
+        return m_state;
+    }
+    if (m_midiService->isSysExBusy())
+    {
+        m_deadline = now + m_budget; // El pedido todavía no salió (o sale detrás de otro volcado).
+        return m_state;
+    }
+    if (now < m_deadline)
+    {
+        return m_state;
+    }
+    if (m_attempts > m_template.getRetries() || !sendRequest(now))
+    {
+        m_state = State::Failed;
+        m_finished = now;
+    }
+    return m_state;
+}
+
+void DumpRequestEngine::cancel()
+{
+    m_state = State::Idle;
+    m_attempts = 0;
+    m_response.clear();
+}
+
+DumpRequestEngine::Clock::duration DumpRequestEngine::getElapsed(Clock::time_point now) const
+{
+    return (m_state == State::Waiting ? now : m_finished) - m_started;
+}
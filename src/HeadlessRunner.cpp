@@ -0,0 +1,243 @@
+/**
+ * @file HeadlessRunner.cpp
+ * @author Gabriel Nicolás González Ferreira (gabrielinuz@fi.mdp.edu.ar)
+ * @brief Implementación del modo sin ventana (recall de un preset desde la línea de comandos).
+ * @version 3.2
+ * @date 2026-10-16
+ */
+#include "HeadlessRunner.hpp"
+#include "MidiLayoutParser.hpp"
+#include "MidiPresetParser.hpp"
+#include "MidiService.hpp"
+#include "ParameterStore.hpp"
+#include "Utils.hpp"
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    enum ExitCode
+    {
+        EXIT_SENT = 0,
+        EXIT_USAGE = 1,
+        EXIT_FILES = 2,
+        EXIT_PORT = 3,
+        EXIT_TIMEOUT = 4,
+        EXIT_TRUNCATED = 5
+    };
+
+    /// Margen sobre la duración estimada del lote antes de darlo por perdido.
+    constexpr std::chrono::milliseconds FLUSH_MARGIN{1000};
+
+    /// Pausa entre consultas a isOutputIdle(): corta frente a un lote que sale en ~1 ms.
+    constexpr std::chrono::microseconds FLUSH_POLL{100};
+
+    struct Options
+    {
+        std::string port;
+        std::string layout;
+        std::string preset;
+        int channel = 0;    // 1-16; 0 = falta.
+        int byteRate = -1;  // -1 = la de MidiService.
+        bool list = false;
+    };
+
+    void printUsage()
+    {
+        std::cerr << "Usage: mccc --headless --port N --channel C --layout L --preset P [--rate B]\n"
+                     "       mccc --headless --list\n"
+                     "  --port N     Output port index (see --list) or part of its name.\n"
+                     "  --channel C  MIDI channel, 1-16.\n"
+                     "  --layout L   Layout CSV.\n"
+                     "  --preset P   Preset CSV to send.\n"
+                     "  --rate B     Wire byte rate in bytes/s; 0 = unlimited (USB). Default: DIN (3125).\n";
+    }
+
+    bool parseOptions(int argc, char** argv, Options& options)
+    {
+        for (int i = 1; i < argc; ++i)
+        {
+            const std::string arg = argv[i];
+            if (arg == "--headless")
+            {
+                continue;
+            }
+            if (arg == "--list")
+            {
+                options.list = true;
+                continue;
+            }
+            if (i + 1 >= argc)
+            {
+                std::cerr << "Error: Missing value for " << arg << std::endl;
+                return false;
+            }
+            const char* value = argv[++i];
+            if (arg == "--port") options.port = value;
+            else if (arg == "--layout") options.layout = value;
+            else if (arg == "--preset") options.preset = value;
+            else if (arg == "--channel")
+            {
+                if (!Utils::parseInt(value, options.channel) || options.channel < 1 || options.channel > 16)
+                {
+                    std::cerr << "Error: Invalid MIDI channel '" << value << "' (expected 1-16)." << std::endl;
+                    return false;
+                }
+            }
+            else if (arg == "--rate")
+            {
+                if (!Utils::parseInt(value, options.byteRate) || options.byteRate < 0)
+                {
+                    std::cerr << "Error: Invalid byte rate '" << value << "'." << std::endl;
+                    return false;
+                }
+            }
+            else
+            {
+                std::cerr << "Error: Unknown option " << arg << std::endl;
+                return false;
+            }
+        }
+        if (!options.list && (options.port.empty() || options.channel == 0 || options.layout.empty() || options.preset.empty()))
+        {
+            std::cerr << "Error: --port, --channel, --layout and --preset are required." << std::endl;
+            return false;
+        }
+        return true;
+    }
+
+    /// Índice del puerto por número o por parte del nombre; -1 si no existe.
+    int findPort(const MidiService& midiService, const std::string& port)
+    {
+        const unsigned int count = midiService.getPortCount();
+        int index = -1;
+        if (Utils::parseInt(port, index) && std::to_string(index) == port)
+        {
+            return (index >= 0 && static_cast<unsigned int>(index) < count) ? index : -1;
+        }
+        for (unsigned int i = 0; i < count; ++i)
+        {
+            if (midiService.getPortName(i).find(port) != std::string::npos)
+            {
+                return static_cast<int>(i);
+            }
+        }
+        return -1;
+    }
+} // namespace
+
+bool HeadlessRunner::isRequested(int argc, char** argv)
+{
+    for (int i = 1; i < argc; ++i)
+    {
+        if (std::strcmp(argv[i], "--headless") == 0)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+int HeadlessRunner::run(int argc, char** argv)
+{
+    const auto start = std::chrono::steady_clock::now();
+
+    Options options;
+    if (!parseOptions(argc, argv, options))
+    {
+        printUsage();
+        return EXIT_USAGE;
+    }
+
+    // Los archivos primero: si hay un error no se llega a abrir el secuenciador.
+    ParameterStore parameters;
+    PresetImage preset;
+    if (!options.list)
+    {
+        std::vector<SliderConfig> configs;
+        if (!MidiLayoutParser::parse(options.layout, configs) || configs.empty())
+        {
+            std::cerr << "Error: Could not load MIDI layout from " << options.layout << std::endl;
+            return EXIT_FILES;
+        }
+        for (const auto& config : configs)
+        {
+            parameters.add(config);
+        }
+        if (!MidiPresetParser::load(options.preset, preset))
+        {
+            std::cerr << "Error: Could not load MIDI preset from " << options.preset << std::endl;
+            return EXIT_FILES;
+        }
+    }
+
+    MidiService midiService;
+    if (!midiService.getInitializationError().empty())
+    {
+        return EXIT_PORT; // MidiService ya lo informó por std::cerr.
+    }
+    if (options.list)
+    {
+        for (unsigned int i = 0; i < midiService.getPortCount(); ++i)
+        {
+            std::printf("%u: %s\n", i, midiService.getPortName(i).c_str());
+        }
+        return EXIT_SENT;
+    }
+
+    const int port = findPort(midiService, options.port);
+    if (port < 0 || !midiService.openPort(static_cast<unsigned int>(port)))
+    {
+        std::cerr << "Error: Could not open MIDI output port '" << options.port << "'." << std::endl;
+        return EXIT_PORT;
+    }
+    if (options.byteRate >= 0)
+    {
+        midiService.setByteRate(static_cast<unsigned int>(options.byteRate));
+    }
+
+    // El mismo lote que arma la ventana al cargar un preset (MainWindow::recallPreset()).
+    const unsigned char channel = static_cast<unsigned char>(options.channel - 1);
+    const std::size_t updated = parameters.applyPreset(preset);
+    std::vector<MidiMessage> messages;
+    std::vector<NrpnMessage> nrpn;
+    parameters.appendActiveBatch(channel, messages);
+    parameters.appendActiveParameters(channel, nrpn);
+    const auto estimate = midiService.estimateTransmitTime(messages.data(), messages.size());
+    midiService.sendBatch(messages);
+    midiService.sendParameters(nrpn);
+
+    // Esperar a que el hilo de salida entregue el último byte a RtMidi; cerrar antes lo descartaría.
+    const auto deadline = std::chrono::steady_clock::now() + estimate + FLUSH_MARGIN;
+    while (!midiService.isOutputIdle())
+    {
+        if (std::chrono::steady_clock::now() > deadline)
+        {
+            std::cerr << "Error: Timed out sending to " << midiService.getPortName(static_cast<unsigned int>(port)) << std::endl;
+            return EXIT_TIMEOUT;
+        }
+        std::this_thread::sleep_for(FLUSH_POLL);
+    }
+
+    const auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+    const MidiService::TransmitStats stats = midiService.getTransmitStats();
+    const std::size_t requested = messages.size() + nrpn.size();
+
+    // Lo que no entró en las colas se descartó: un recall incompleto no es un éxito.
+    const std::size_t dropped = midiService.getDroppedCount();
+    if (dropped > 0)
+    {
+        std::cerr << "Error: Preset truncated: " << (requested - dropped) << " of " << requested
+                  << " CC messages and NRPN/RPN parameters sent, " << dropped << " dropped (output queue full)." << std::endl;
+        return EXIT_TRUNCATED;
+    }
+    std::printf("Sent %zu CC messages and %zu NRPN/RPN parameters (%zu controls, %lu bytes) to %s on channel %d in %.2f ms.\n",
+                messages.size(), nrpn.size(), updated, stats.bytes,
+                midiService.getPortName(static_cast<unsigned int>(port)).c_str(), options.channel, elapsed.count() / 1000.0);
+    return EXIT_SENT;
+}
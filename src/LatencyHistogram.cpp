@@ -0,0 +1,76 @@
+/**
+ * @file LatencyHistogram.cpp
+ * @author Gabriel Nicolás González Ferreira (gabrielinuz@fi.mdp.edu.ar)
+ * @brief Implementación de las instantáneas y los percentiles de LatencyHistogram.
+ * @version 2.5
+ * @date 2026-10-16
+ */
+#include "LatencyHistogram.hpp"
+
+std::int64_t LatencyHistogram::bucketUpperBound(std::size_t index)
+{
+    if (index < 2 * SUB_BUCKETS)
+    {
+        return static_cast<std::int64_t>(index);
+    }
+    const std::size_t shift = index / SUB_BUCKETS - 1;
+    const std::uint64_t low = static_cast<std::uint64_t>(SUB_BUCKETS + index % SUB_BUCKETS) << shift;
+    return static_cast<std::int64_t>(low + (std::uint64_t{1} << shift) - 1);
+}
+
+LatencyHistogram::Snapshot LatencyHistogram::snapshot() const
+{
+    // Las muestras que llegan durante la copia pueden quedar o no: el total es el de lo copiado.
+    Snapshot snapshot;
+    for (std::size_t i = 0; i < BUCKETS; ++i)
+    {
+        snapshot.counts[i] = m_counts[i].load(std::memory_order_relaxed);
+        snapshot.total += snapshot.counts[i];
+    }
+    return snapshot;
+}
+
+std::int64_t LatencyHistogram::Snapshot::percentile(double quantile) const
+{
+    if (total == 0)
+    {
+        return 0;
+    }
+    const double clamped = quantile < 0.0 ? 0.0 : (quantile > 1.0 ? 1.0 : quantile);
+    std::uint64_t rank = static_cast<std::uint64_t>(clamped * static_cast<double>(total) + 0.5);
+    rank = rank == 0 ? 1 : rank;
+
+    std::uint64_t seen = 0;
+    for (std::size_t i = 0; i < BUCKETS; ++i)
+    {
+        seen += counts[i];
+        if (seen >= rank)
+        {
+            return bucketUpperBound(i);
+        }
+    }
+    return max();
+}
+
+std::int64_t LatencyHistogram::Snapshot::max() const
+{
+    for (std::size_t i = BUCKETS; i-- > 0;)
+    {
+        if (counts[i] != 0)
+        {
+            return bucketUpperBound(i);
+        }
+    }
+    return 0;
+}
+
+LatencyHistogram::Snapshot LatencyHistogram::Snapshot::since(const Snapshot& earlier) const
+{
+    Snapshot interval;
+    for (std::size_t i = 0; i < BUCKETS; ++i)
+    {
+        interval.counts[i] = counts[i] - earlier.counts[i];
+        interval.total += interval.counts[i];
+    }
+    return interval;
+}
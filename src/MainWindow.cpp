@@ -10,20 +10,67 @@
 #include "MidiPresetParser.hpp"
 #include "SliderControl.hpp"    // Se sigue necesitando para crear instancias
 #include "Utils.hpp" // Para la funciones de utilidad
+#include "MappedFile.hpp" // @version 3.0: Los .syx se envían desde el archivo mapeado
 #include <FL/fl_ask.H>
 #include <FL/Fl.H>
 #include <FL/Fl_File_Chooser.H> // Necesario para diálogos de archivo
 #include <FL/fl_draw.H> /// @version 0.6: Incluir para fl_font() y fl_measure()
 #include <algorithm>
+#include <cstdio> /// @version 1.2: std::snprintf para el informe de tiempos
 #include <sstream>
 #include <fstream>
-#include <map> // Para cargar presets
+
+namespace
+{
+    /// @version 2.0: Opciones del selector de recall: salto inmediato o transición.
+    struct MorphOption
+    {
+        const char* label;
+        int milliseconds; ///< 0 = salto inmediato.
+        MorphEngine::Curve curve;
+    };
+
+    const MorphOption MORPH_OPTIONS[] = {
+        {"Jump", 0, MorphEngine::Curve::Linear},
+        {"Linear 0.5 s", 500, MorphEngine::Curve::Linear},
+        {"Linear 2 s", 2000, MorphEngine::Curve::Linear},
+        {"Linear 5 s", 5000, MorphEngine::Curve::Linear},
+        {"Exp 0.5 s", 500, MorphEngine::Curve::Exponential},
+        {"Exp 2 s", 2000, MorphEngine::Curve::Exponential},
+        {"Exp 5 s", 5000, MorphEngine::Curve::Exponential},
+    };
+
+    /// Intervalo con el que la GUI muestra el avance de una transición (~30 cuadros por segundo).
+    constexpr double MORPH_GUI_INTERVAL = 1.0 / 30.0;
+
+    /// @version 3.1: Cada cuánto se revisan los plazos de un pedido de volcado SysEx.
+    constexpr double DUMP_POLL_INTERVAL = 0.05;
+
+    /// @version 2.2: Pausa entre lotes de eventos de entrada cuando la cola no se vació en uno.
+    constexpr double MIDI_INPUT_DRAIN_INTERVAL = 0.005;
+
+    /// @version 2.3: Los sliders siguen a la entrada MIDI como mucho a la tasa de la pantalla.
+    constexpr double DISPLAY_REFRESH_INTERVAL = 1.0 / 60.0;
+
+    /// @version 2.5: Cada cuánto se publican los percentiles de latencia del thru.
+    constexpr double THRU_REPORT_INTERVAL = 1.0;
+}
 
 /// <-- @version 0.7: inicializar estas rutas a un valor por defecto, como el directorio actual "."
-MainWindow::MainWindow(int width, int height, const char* title, std::shared_ptr<MidiService> midiService)
-    : m_midiService(midiService), m_lastLayoutPath("."), m_lastPresetPath(".")
+MainWindow::MainWindow(int width, int height, const char* title, std::shared_ptr<MidiService> midiService,
+                       std::shared_ptr<MidiInputService> midiInput)
+    : m_midiService(midiService),
+      m_midiInput(midiInput), /// @version 2.2
+      m_parameters(std::make_shared<ParameterStore>()), /// @version 1.4
+      m_morphEngine(std::make_unique<MorphEngine>(midiService)), /// @version 2.0
+      m_sync(std::make_unique<ParameterSync>(m_parameters, midiService)), /// @version 2.3
+      m_learnMap(std::make_shared<MidiLearnMap>()), /// @version 2.4
+      m_thruRouter(std::make_unique<MidiThruRouter>(midiService)), /// @version 2.5
+      m_dumpEngine(std::make_unique<DumpRequestEngine>(midiService)), /// @version 3.1
+      m_lastLayoutPath("."), m_lastPresetPath("."), m_lastBankPath("."), m_lastSysExPath(".")
 {
-    m_window = new Fl_Window(width, height, title);
+    m_window = new Fl_Window(width, height);
+    m_window->copy_label(title); /// @version 2.6: Cada ventana de una sesión arma su propio título.
     m_window->begin();
 
     int current_y = 10;
@@ -36,9 +83,56 @@ MainWindow::MainWindow(int width, int height, const char* title, std::shared_ptr
 
     // --- Selector de Puerto MIDI ---
     new Fl_Box(10, current_y, 80, 25, "MIDI Port:");
-    m_portChoice = new Fl_Choice(100, current_y, 280, 25);
+    m_portChoice = new Fl_Choice(100, current_y, 200, 25);
     m_portChoice->callback(onPortSelected_static, this);
     populateMidiPorts();
+
+    /// @version 2.6: Sesiones de varios dispositivos (una ventana y un puerto por sintetizador).
+    m_sessionMenu = new Fl_Menu_Button(305, current_y, 80, 25, "Session");
+    m_sessionMenu->add("New Device Window", 0, onSessionMenu_static, this);
+    m_sessionMenu->add("Open Session...", 0, onSessionMenu_static, this);
+    m_sessionMenu->add("Save Session...", 0, onSessionMenu_static, this);
+    m_sessionMenu->deactivate(); // Hasta que setSessionHost() le dé a quién delegar.
+
+    /// @version 1.1: Tasa de bytes del cable. Por defecto MIDI DIN (3125 bytes/s).
+    new Fl_Box(390, current_y, 60, 25, "Wire:");
+    m_wireRateChoice = new Fl_Choice(450, current_y, 140, 25);
+    m_wireRateChoice->add("DIN (3125 B/s)");
+    m_wireRateChoice->add("2x DIN (6250 B/s)");
+    m_wireRateChoice->add("USB (unlimited)");
+    m_wireRateChoice->value(0); // Coincide con el valor por defecto de MidiService.
+    m_wireRateChoice->callback(onWireRateSelected_static, this);
+    current_y += 35;
+
+    /// @version 2.2: Puerto de entrada y actividad recibida.
+    new Fl_Box(10, current_y, 80, 25, "MIDI In:");
+    m_inputPortChoice = new Fl_Choice(100, current_y, 205, 25);
+    m_inputPortChoice->callback(onInputPortSelected_static, this);
+
+    /// @version 2.5: MIDI thru de la entrada a la salida, en el hilo de entrada.
+    m_thruButton = new Fl_Button(310, current_y, 65, 25, "Thru");
+    m_thruButton->type(FL_TOGGLE_BUTTON);
+    m_thruButton->callback(onThruToggled_static, this);
+    m_thruButton->tooltip("MIDI thru: forward everything from the input port to the output port");
+
+    m_inputActivityBox = new Fl_Box(380, current_y, 140, 25, "In: -");
+    m_inputActivityBox->box(FL_THIN_DOWN_BOX);
+    m_inputActivityBox->align(FL_ALIGN_LEFT | FL_ALIGN_INSIDE | FL_ALIGN_CLIP);
+    populateMidiInputPorts();
+
+    /// @version 2.4: MIDI Learn: tocar un slider y mover una perilla del puerto de entrada.
+    m_learnButton = new Fl_Button(525, current_y, 65, 25, "Learn");
+    m_learnButton->type(FL_TOGGLE_BUTTON);
+    m_learnButton->callback(onLearnToggled_static, this);
+    m_learnButton->tooltip("MIDI Learn: click a slider, then move a knob on the input port");
+    m_sync->setLearnMap(m_learnMap);
+    m_learnMap->setArmListener(onLearnArmed_static, this);
+    if (m_midiInput)
+    {
+        // Llamado desde el hilo de RtMidi: solo despierta al bucle de FLTK.
+        m_midiInput->setNotifier(onMidiInputNotify, this);
+        m_midiInput->setForwarder(MidiThruRouter::forward_static, m_thruRouter.get()); /// @version 2.5
+    }
     current_y += 35;
 
     // --- Selector de Canal MIDI ---
@@ -51,11 +145,33 @@ MainWindow::MainWindow(int width, int height, const char* title, std::shared_ptr
     m_channelChoice->value(0); // Por defecto Canal 1 (índice 0)
     m_currentMidiChannel = 0;  // Inicializar el estado interno
     m_channelChoice->callback(onChannelSelected_static, this);
+
+    /// @version 1.0: Selector del límite de mensajes por milisegundo (coalescencia de CCs).
+    new Fl_Box(205, current_y, 65, 25, "Max rate:");
+    m_rateChoice = new Fl_Choice(270, current_y, 110, 25); // @version 3.0: Más angosto, para el menú SysEx.
+    m_rateChoice->add("1 msg/ms");
+    m_rateChoice->add("2 msg/ms");
+    m_rateChoice->add("4 msg/ms");
+    m_rateChoice->add("Unlimited");
+    m_rateChoice->value(3); // @version 1.1: Sin límite por defecto; la tasa de bytes ya regula la salida.
+    m_rateChoice->callback(onRateSelected_static, this);
+
+    /// @version 3.0: Volcados SysEx: enviar un .syx en partes y guardar lo que responde el dispositivo.
+    m_sysExMenu = new Fl_Menu_Button(385, current_y, 70, 25, "SysEx");
+    m_sysExMenu->add("Send SysEx File...", 0, onSysExMenu_static, this);
+    m_sysExMenu->add("Save Received SysEx...", 0, onSysExMenu_static, this);
+    m_sysExMenu->add("Cancel SysEx Send", 0, onSysExMenu_static, this);
+    m_sysExMenu->add("Request Device State", 0, onSysExMenu_static, this); /// @version 3.1
+
+    /// @version 1.3: Recall incremental: al cargar un preset se envía solo lo que difiere del shadow.
+    m_diffRecallCheck = new Fl_Check_Button(460, current_y, 130, 25, "Diff recall");
+    m_diffRecallCheck->value(1);
+    m_diffRecallCheck->tooltip("On preset load, send only the CCs whose value differs from the last value sent");
     current_y += 35;
 
     // --- Botones de Gestión de Layout y Presets ---
     int button_x = 10;
-    int button_width = 107;
+    int button_width = 88; // @version 2.1: Seis botones por fila (antes 107 para cinco).
     int button_height = 25;
     int button_spacing = 10;
 
@@ -79,6 +195,36 @@ MainWindow::MainWindow(int width, int height, const char* title, std::shared_ptr
 
     m_sendAllButton = new Fl_Button(button_x, current_y, button_width, button_height, "Send All");
     m_sendAllButton->callback(onSendAll_static, this);
+    button_x += button_width + button_spacing;
+
+    /// @version 2.1: Pad XY que mezcla cuatro presets; se abre en su propia ventana.
+    m_xyPadButton = new Fl_Button(button_x, current_y, button_width, button_height, "XY Pad");
+    m_xyPadButton->callback(onShowXYPad_static, this);
+    current_y += 35;
+
+    /// @version 1.9: Banco de presets binario: elegir un preset es un acceso al archivo mapeado.
+    new Fl_Box(10, current_y, 50, 25, "Bank:");
+    m_bankChoice = new Fl_Choice(60, current_y, 150, 25);
+    m_bankChoice->callback(onBankPresetSelected_static, this);
+    m_bankChoice->deactivate(); // Hasta que se abra un banco.
+
+    m_openBankButton = new Fl_Button(215, current_y, 80, button_height, "Open Bank");
+    m_openBankButton->callback(onOpenBank_static, this);
+
+    m_importBankButton = new Fl_Button(300, current_y, 80, button_height, "Import CSV");
+    m_importBankButton->callback(onImportBank_static, this);
+
+    m_exportBankButton = new Fl_Button(385, current_y, 80, button_height, "Export CSV");
+    m_exportBankButton->callback(onExportBank_static, this);
+
+    /// @version 2.0: Recall de presets: salto inmediato o transición temporizada (MorphEngine).
+    m_morphChoice = new Fl_Choice(470, current_y, 120, 25);
+    for (const auto& option : MORPH_OPTIONS)
+    {
+        m_morphChoice->add(option.label);
+    }
+    m_morphChoice->value(0);
+    m_morphChoice->tooltip("Preset recall: jump, or morph from the current values over the given time");
     current_y += 35;
 
     // --- Grupo de Scroll para Controles Dinámicos ---
@@ -91,6 +237,13 @@ MainWindow::MainWindow(int width, int height, const char* title, std::shared_ptr
     // Aquí no se crean sliders inicialmente. Se harán con loadMidiLayoutFromFile.
 
     m_scrollGroup->end(); // Fin del grupo de scroll
+
+    /// @version 1.5: Lista virtualizada en la misma área; se muestra solo con layouts grandes.
+    m_virtualList = new VirtualControlList(10, current_y, width - 20, height - current_y - 10,
+                                           m_parameters, m_midiService, &m_currentMidiChannel);
+    m_virtualList->hide();
+    m_virtualList->setLearnMap(m_learnMap); /// @version 2.4
+
     m_window->end(); // Fin de la ventana principal
 
     // Hacer la ventana redimensionable y ajustar su mínimo tamaño.
@@ -102,7 +255,21 @@ MainWindow::~MainWindow()
 {
     // Los widgets hijos de Fl_Window se destruyen automáticamente cuando la ventana es destruida.
     // Solo necesitamos limpiar los unique_ptr de m_controls.
+    Fl::remove_timeout(onBatchReport_static, this); /// @version 1.2: El informe pendiente apunta a this.
+    Fl::remove_timeout(onMorphTick_static, this);   /// @version 2.0
+    if (m_midiInput)                                /// @version 2.2: Sin callbacks de RtMidi hacia this.
+    {
+        m_midiInput->closePort();
+        m_midiInput->setNotifier(nullptr, nullptr);
+        m_midiInput->setForwarder(nullptr, nullptr); /// @version 2.5
+    }
+    Fl::remove_timeout(onThruReport_static, this);
+    Fl::remove_timeout(onSysExReport_static, this); /// @version 3.0
+    Fl::remove_timeout(onDumpTick_static, this); /// @version 3.1
+    Fl::remove_timeout(onMidiInputDrain_static, this);
+    Fl::remove_timeout(onSyncRefresh_static, this); /// @version 2.3
     clearDynamicControls();
+    delete m_xyPadWindow; /// @version 2.1: No es hija de m_window. Los widgets del pad se van con ella.
 }
 
 /**
@@ -111,29 +278,55 @@ MainWindow::~MainWindow()
  */
 void MainWindow::clearDynamicControls()
 {
+    stopMorph(); /// @version 2.0: La transición apunta a filas que van a desaparecer.
+    Fl::remove_timeout(onSyncRefresh_static, this); /// @version 2.3: Las filas marcadas dejan de existir.
+    m_sync->reset();
+    m_learnMap->clear(); /// @version 2.4: Los bindings apuntan a filas del layout anterior.
+    Fl::remove_timeout(onDumpTick_static, this); /// @version 3.1: La respuesta sería para el layout anterior.
+    m_dumpEngine->cancel();
+    m_dumpTemplate.clear();
+    if (m_learnButton)
+    {
+        m_learnButton->value(0);
+    }
     if (m_scrollGroup)
     {
         m_scrollGroup->clear(); // Elimina todos los widgets hijos de Fl_Scroll
     }
     m_controls.clear(); // Limpia el vector de unique_ptr
+    m_virtualList->clearRows(); /// @version 1.5
+    m_parameters->clear(); /// @version 1.4: Las vistas ya no existen, se vacía el almacén.
 }
 
 /**
  * @brief Crea y añade un nuevo control deslizante a la interfaz.
- * @param config La configuración del slider.
+ * @param index La fila del almacén de parámetros que representa el slider.
  * @param y_position La posición Y donde se debe dibujar el slider dentro del scroll group.
  */
-void MainWindow::addSliderControl(const SliderConfig& config, int y_position)
+void MainWindow::addSliderControl(std::size_t index, int y_position)
 {
     // El SliderControl necesita un puntero al canal MIDI actual para sus callbacks.
     // Se le pasa la dirección de m_currentMidiChannel.
-    auto sliderControl = std::make_unique<SliderControl>(config, m_midiService);
+    auto sliderControl = std::make_unique<SliderControl>(m_parameters, index, m_midiService);
     sliderControl->createWidgets(10, y_position, m_scrollGroup->w() - 20, 45, &m_currentMidiChannel);
     // Establecer el callback del slider individual
     sliderControl->getFlSlider()->callback(SliderControl::sliderCallback_static, sliderControl.get());
+    sliderControl->setLearnMap(m_learnMap); /// @version 2.4
     m_controls.push_back(std::move(sliderControl));
 }
 
+/**
+ * @brief Actualiza todos los widgets desde el almacén tras una operación masiva.
+ */
+void MainWindow::refreshControls()
+{
+    for (const auto& control : m_controls)
+    {
+        control->refresh();
+    }
+    m_virtualList->refresh(); /// @version 1.5: Solo las filas visibles tienen widgets.
+}
+
 
 /**
  * @brief Carga las configuraciones de los controles desde un archivo CSV de layout.
@@ -162,15 +355,49 @@ bool MainWindow::loadMidiLayoutFromFile(const std::string& filename)
         return true; // No es un error crítico si el archivo está vacío pero se abrió correctamente.
     }
 
+    /// @version 1.4: Primero se llena el almacén; los widgets son vistas sobre él.
+    for (const auto& config : configs)
+    {
+        m_parameters->add(config);
+    }
+
+    /// @version 2.4: Los bindings de MIDI Learn viven junto al layout.
+    m_layoutFile = filename;
+    std::string learn_note;
+    if (m_learnMap->load(MidiLearnMap::bindingsPathFor(filename), m_parameters->size()))
+    {
+        learn_note = " " + std::to_string(m_learnMap->size()) + " MIDI learn bindings.";
+    }
+
+    /// @version 3.1: El pedido de volcado SysEx también vive junto al layout.
+    if (m_dumpTemplate.load(SysExDumpTemplate::pathFor(filename)))
+    {
+        learn_note += " Device state request for " + std::to_string(m_dumpTemplate.getMappedCount()) + " CCs.";
+    }
+
+    /// @version 1.5: Layouts grandes: solo se crean widgets para las filas visibles.
+    if (m_parameters->size() >= VIRTUAL_LIST_THRESHOLD)
+    {
+        m_scrollGroup->hide();
+        m_virtualList->show();
+        m_virtualList->reload();
+        m_window->redraw();
+        updateStatus("MIDI layout loaded from " + display_name + ". " + std::to_string(configs.size()) +
+                     " parameters (virtualized list, " + std::to_string(m_virtualList->getPoolSize()) + " rows on screen)." + learn_note);
+        return true;
+    }
+    m_virtualList->hide();
+    m_scrollGroup->show();
+
     // Volver a establecer el grupo de scroll como el grupo actual para añadir widgets.
     m_scrollGroup->begin();
     int current_y_in_scroll = 0; // Posición Y dentro del grupo de scroll
     int slider_height = 45; // Altura de cada grupo de slider (label + slider)
     int slider_spacing = 5; // Espacio entre sliders
 
-    for (const auto& config : configs)
+    for (std::size_t i = 0; i < m_parameters->size(); ++i)
     {
-        addSliderControl(config, current_y_in_scroll);
+        addSliderControl(i, current_y_in_scroll);
         current_y_in_scroll += (slider_height + slider_spacing);
     }
     m_scrollGroup->end();
@@ -185,7 +412,7 @@ bool MainWindow::loadMidiLayoutFromFile(const std::string& filename)
     m_window->size(m_window->w(), std::max(m_window->h(), minimum_height_for_controls));
     m_window->redraw(); // Forzar el redibujado de la ventana y sus hijos.
 
-    updateStatus("MIDI layout loaded from " + display_name + ". " + std::to_string(configs.size()) + " sliders created.");
+    updateStatus("MIDI layout loaded from " + display_name + ". " + std::to_string(configs.size()) + " sliders created." + learn_note);
     return true;
 }
 
@@ -196,6 +423,12 @@ void MainWindow::show(int argc, char** argv)
     onPortSelected();
 }
 
+void MainWindow::show()
+{
+    m_window->show();
+    onPortSelected();
+}
+
 /** @version 0.6 Actualización de este método para que el texto se ajuste deinámicamente*/
 void MainWindow::updateStatus(const std::string& message)
 {
@@ -235,6 +468,21 @@ void MainWindow::onChannelSelected_static(Fl_Widget* w, void* userdata)
     static_cast<MainWindow*>(userdata)->onChannelSelected();
 }
 
+void MainWindow::onRateSelected_static(Fl_Widget* w, void* userdata)
+{
+    static_cast<MainWindow*>(userdata)->onRateSelected();
+}
+
+void MainWindow::onWireRateSelected_static(Fl_Widget* w, void* userdata)
+{
+    static_cast<MainWindow*>(userdata)->onWireRateSelected();
+}
+
+void MainWindow::onBatchReport_static(void* userdata)
+{
+    static_cast<MainWindow*>(userdata)->onBatchReport();
+}
+
 void MainWindow::onLoadLayout_static(Fl_Widget* w, void* userdata)
 {
     static_cast<MainWindow*>(userdata)->onLoadLayout();
@@ -250,6 +498,102 @@ void MainWindow::onSavePreset_static(Fl_Widget* w, void* userdata)
     static_cast<MainWindow*>(userdata)->onSavePreset();
 }
 
+void MainWindow::onInputPortSelected_static(Fl_Widget* w, void* userdata)
+{
+    static_cast<MainWindow*>(userdata)->onInputPortSelected();
+}
+
+void MainWindow::onMidiInputNotify(void* userdata)
+{
+    // Hilo de RtMidi: Fl::awake() es la única llamada de FLTK permitida fuera del hilo principal.
+    Fl::awake(onMidiInputDrain_static, userdata);
+}
+
+void MainWindow::onMidiInputDrain_static(void* userdata)
+{
+    static_cast<MainWindow*>(userdata)->onMidiInputDrain();
+}
+
+void MainWindow::onLearnToggled_static(Fl_Widget* w, void* userdata)
+{
+    static_cast<MainWindow*>(userdata)->onLearnToggled();
+}
+
+void MainWindow::onLearnArmed_static(void* userdata)
+{
+    static_cast<MainWindow*>(userdata)->onLearnArmed();
+}
+
+void MainWindow::onThruToggled_static(Fl_Widget* w, void* userdata)
+{
+    static_cast<MainWindow*>(userdata)->onThruToggled();
+}
+
+void MainWindow::onThruReport_static(void* userdata)
+{
+    static_cast<MainWindow*>(userdata)->onThruReport();
+}
+
+void MainWindow::onSessionMenu_static(Fl_Widget* w, void* userdata)
+{
+    static_cast<MainWindow*>(userdata)->onSessionMenu();
+}
+
+void MainWindow::onSysExMenu_static(Fl_Widget* w, void* userdata)
+{
+    static_cast<MainWindow*>(userdata)->onSysExMenu();
+}
+
+void MainWindow::onSysExReport_static(void* userdata)
+{
+    static_cast<MainWindow*>(userdata)->onSysExReport();
+}
+
+void MainWindow::onDumpTick_static(void* userdata)
+{
+    static_cast<MainWindow*>(userdata)->onDumpTick();
+}
+
+void MainWindow::onSyncRefresh_static(void* userdata)
+{
+    static_cast<MainWindow*>(userdata)->onSyncRefresh();
+}
+
+void MainWindow::onShowXYPad_static(Fl_Widget* w, void* userdata)
+{
+    static_cast<MainWindow*>(userdata)->onShowXYPad();
+}
+
+void MainWindow::onXYPadMoved_static(Fl_Widget* w, void* userdata)
+{
+    static_cast<MainWindow*>(userdata)->onXYPadMoved();
+}
+
+void MainWindow::onMorphTick_static(void* userdata)
+{
+    static_cast<MainWindow*>(userdata)->onMorphTick();
+}
+
+void MainWindow::onBankPresetSelected_static(Fl_Widget* w, void* userdata)
+{
+    static_cast<MainWindow*>(userdata)->onBankPresetSelected();
+}
+
+void MainWindow::onOpenBank_static(Fl_Widget* w, void* userdata)
+{
+    static_cast<MainWindow*>(userdata)->onOpenBank();
+}
+
+void MainWindow::onImportBank_static(Fl_Widget* w, void* userdata)
+{
+    static_cast<MainWindow*>(userdata)->onImportBank();
+}
+
+void MainWindow::onExportBank_static(Fl_Widget* w, void* userdata)
+{
+    static_cast<MainWindow*>(userdata)->onExportBank();
+}
+
 /**
  * @brief Callback estático para el botón "Reset All".
  */
@@ -272,6 +616,8 @@ void MainWindow::onPortSelected()
         return;
     }
 
+    stopMorph(); /// @version 2.0: Una transición no sigue en el puerto nuevo.
+
     //Leer NOTES.md #1 para entender por qué es importante cerrar primero los puertos si están abiertos.
     if (m_midiService->isPortOpen()) 
     {
@@ -304,6 +650,33 @@ void MainWindow::onChannelSelected()
     updateStatus("MIDI Channel set to " + std::to_string(m_currentMidiChannel + 1));
 }
 
+/**
+ * @brief Aplica el límite de mensajes por milisegundo elegido al servicio MIDI.
+ */
+void MainWindow::onRateSelected()
+{
+    static const unsigned int rates[] = {1, 2, 4, 0}; // Mismo orden que las opciones del Fl_Choice; 0 = sin límite.
+    int index = m_rateChoice->value();
+    if (!m_midiService || index < 0 || index > 3) return;
+
+    m_midiService->setMaxMessagesPerMs(rates[index]);
+    updateStatus(std::string("Output rate limit set to ") + m_rateChoice->text() + ".");
+}
+
+/**
+ * @brief Aplica la tasa de bytes del cable elegida al servicio MIDI.
+ */
+void MainWindow::onWireRateSelected()
+{
+    // Mismo orden que las opciones del Fl_Choice; 0 = sin límite.
+    static const unsigned int rates[] = {OutputScheduler::DIN_BYTES_PER_SECOND, 2 * OutputScheduler::DIN_BYTES_PER_SECOND, 0};
+    int index = m_wireRateChoice->value();
+    if (!m_midiService || index < 0 || index > 2) return;
+
+    m_midiService->setByteRate(rates[index]);
+    updateStatus(std::string("Wire rate set to ") + m_wireRateChoice->text() + ".");
+}
+
 /**
  * @brief Muestra un diálogo para seleccionar un archivo de layout MIDI y lo carga.
  */
@@ -324,7 +697,7 @@ void MainWindow::onLoadLayout()
  */
 void MainWindow::onLoadPreset()
 {
-    if (m_controls.empty())
+    if (m_parameters->empty())
     {
         updateStatus("Error: No MIDI controls loaded. Please load a layout first.");
         fl_alert("No hay controles MIDI cargados. Por favor, carga un archivo de diseño (layout) primero.");
@@ -340,25 +713,11 @@ void MainWindow::onLoadPreset()
         /// @version 0.6 - solo el nombre, tiene que ir adentro o da error cuando sea nulo IMPORTANTE.
         std::string display_name = Utils::getFileNameFromPath(filename); 
 
-        /// @version 0.6: Usar el nuevo mapa con el struct PresetValue.
-        std::map<int, PresetValue> presetData;
-        if (MidiPresetParser::load(filename, presetData))
+        /// @version 1.8: El preset se carga en una imagen de tamaño fijo indexada por CC#.
+        PresetImage preset;
+        if (MidiPresetParser::load(filename, preset))
         {
-            int updated_count = 0;
-            for (const auto& control : m_controls)
-            {
-                int cc_num = control->getCcNumber();
-                if (presetData.count(cc_num))
-                {
-                    const auto& data = presetData.at(cc_num);
-                    /// @version 0.6: Establecer tanto el valor como el estado de activación.
-                    control->setCurrentValue(data.value);
-                    control->setActive(data.active);
-                    updated_count++;
-                }
-            }
-            
-            updateStatus("Preset loaded from " + std::string(display_name) + ". " + std::to_string(updated_count) + " controls updated.");
+            recallPreset(preset, display_name); /// @version 1.9: Compartido con los bancos de presets.
         }
         else
         {
@@ -368,12 +727,76 @@ void MainWindow::onLoadPreset()
     }
 }
 
+/**
+ * @brief Aplica un preset al almacén, refresca la GUI y lo envía al dispositivo.
+ * @param preset La imagen del preset.
+ * @param display_name Nombre para la barra de estado.
+ */
+void MainWindow::recallPreset(const PresetImage& preset, const std::string& display_name)
+{
+    stopMorph();
+
+    /// @version 2.0: Transición temporizada desde los valores actuales en lugar de un salto.
+    const MorphOption& morph = MORPH_OPTIONS[m_morphChoice->value()];
+    if (morph.milliseconds > 0 && m_midiService && m_midiService->isPortOpen())
+    {
+        PresetImage from = m_parameters->snapshot();
+        std::size_t updated_count = m_parameters->applyPreset(preset);
+        PresetImage to = m_parameters->snapshot(); // Ya recortado al rango de cada parámetro.
+
+        /// @version 2.7: Cada CC# sale por el canal de su control.
+        MorphEngine::ChannelMap channels;
+        for (int cc = 0; cc < static_cast<int>(PresetImage::CONTROLLERS); ++cc)
+        {
+            channels[cc] = m_parameters->channelForCc(cc, m_currentMidiChannel);
+        }
+        m_morphEngine->start(from, to, channels, std::chrono::milliseconds(morph.milliseconds), morph.curve);
+        m_morphLabel = display_name;
+        m_morphEmittedBefore = m_morphEngine->getEmittedCount();
+
+        // Los sliders arrancan en el punto de partida y siguen al motor (ver onMorphTick()).
+        m_parameters->applyPreset(m_morphEngine->getCurrent());
+        refreshControls();
+        Fl::add_timeout(MORPH_GUI_INTERVAL, onMorphTick_static, this);
+
+        updateStatus("Morphing to " + display_name + " (" + morph.label + "). " +
+                     std::to_string(updated_count) + " controls updated.");
+        return;
+    }
+
+    /// @version 1.8: Una sola pasada lineal sobre el almacén; luego se refrescan las vistas.
+    std::size_t updated_count = m_parameters->applyPreset(preset);
+    refreshControls();
+
+    updateStatus("Preset loaded from " + display_name + ". " + std::to_string(updated_count) + " controls updated.");
+
+    /// @version 1.2: Recall: enviar el preset al dispositivo en un solo lote.
+    if (m_midiService && m_midiService->isPortOpen())
+    {
+        std::vector<MidiMessage> messages = buildActiveControlsBatch();
+        if (m_diffRecallCheck->value())
+        {
+            /// @version 1.3: Enviar solo las diferencias con el último valor enviado de cada CC.
+            std::vector<MidiMessage> changed = m_midiService->filterChanged(messages.data(), messages.size());
+            std::size_t saved = messages.size() - changed.size();
+            m_diffSavedTotal += saved;
+            sendBatchWithReport(changed, "Preset " + display_name, false);
+            m_batchNote = " Diff saved " + std::to_string(saved) + " of " + std::to_string(messages.size()) +
+                          " messages (total saved: " + std::to_string(m_diffSavedTotal) + ").";
+        }
+        else
+        {
+            sendBatchWithReport(messages, "Preset " + display_name, true);
+        }
+    }
+}
+
 /**
  * @brief Muestra un diálogo para guardar el estado actual de los controles como un preset MIDI.
  */
 void MainWindow::onSavePreset()
 {
-    if (m_controls.empty())
+    if (m_parameters->empty())
     {
         updateStatus("No sliders to save.");
         fl_alert("No hay sliders cargados para guardar un preset.");
@@ -392,7 +815,7 @@ void MainWindow::onSavePreset()
             filename += ".csv";
         }
 
-        if (MidiPresetParser::save(filename, m_controls))
+        if (MidiPresetParser::save(filename, *m_parameters))
         {
             updateStatus("Preset saved to " + display_name);
         }
@@ -405,33 +828,34 @@ void MainWindow::onSavePreset()
 }
 
 /**
- * @brief Implementa la lógica para resetear todos los controles a sus valores mínimos (0).
+ * @brief Implementa la lógica para resetear todos los controles a sus valores mínimos.
  */
 void MainWindow::onResetAll() 
 {
-    if (m_controls.empty()) 
+    if (m_parameters->empty()) 
     {
         updateStatus("No hay controles para resetear.");
         return;
     }
 
-    int reset_count = 0;
-    for (const auto& control : m_controls) 
+    stopMorph(); /// @version 2.0: El reset manda sobre una transición en curso.
+
+    /// @version 1.4: El reset es un bucle sobre el almacén; los widgets se refrescan después.
+    /// Cada parámetro activo vuelve al mínimo de su rango (usualmente 0).
+    m_parameters->resetActive();
+    refreshControls();
+
+    /// @version 1.2: El reset se acumula en un lote y se envía de una sola vez.
+    std::vector<MidiMessage> messages = buildActiveControlsBatch();
+
+    if (m_midiService && m_midiService->isPortOpen())
     {
-        /// @version 0.6: Solo resetear y enviar si el control está activo.
-        if (control->isActive())
-        {
-            control->setCurrentValue(0); // <-- Establece el valor a 0 (o control->m_config.min_value)
-
-            /*Después de establecer el valor, 
-            necesitamos simular el envío MIDI 
-            o directamente enviar el mensaje 
-            si setCurrentValue no lo hace.*/            
-            m_midiService->sendCcMessage(m_currentMidiChannel, static_cast<unsigned char>(control->getCcNumber()), 0);
-            reset_count++;
-        }
+        sendBatchWithReport(messages, "Reset All", true);
+    }
+    else
+    {
+        updateStatus(std::to_string(messages.size()) + " active controls have been reset to their minimum.");
     }
-    updateStatus(std::to_string(reset_count) + " active controls have been reset to 0.");
 }
 
 /**
@@ -446,21 +870,92 @@ void MainWindow::onSendAll()
         return;
     }
 
-    int sent_count = 0;
-    for (const auto& control : m_controls)
+    stopMorph(); /// @version 2.0
+    /// @version 1.2: Un solo lote en lugar de un sendMessage() por control.
+    sendBatchWithReport(buildActiveControlsBatch(), "Send All", true);
+}
+
+/**
+ * @brief Arma un lote con el valor actual de los controles activos.
+ */
+std::vector<MidiMessage> MainWindow::buildActiveControlsBatch() const
+{
+    /// @version 1.4: Bucle directo sobre el almacén, sin recorrer widgets.
+    std::vector<MidiMessage> messages;
+    messages.reserve(m_parameters->size());
+    m_parameters->appendActiveBatch(m_currentMidiChannel, messages);
+    return messages;
+}
+
+/**
+ * @brief Envía un lote y programa el informe de tiempos en la barra de estado.
+ */
+void MainWindow::sendBatchWithReport(const std::vector<MidiMessage>& messages, const std::string& label, bool includeParameters)
+{
+    /// @version 2.9: Los NRPN/RPN activos van detrás de los CC, por la misma cola (solo en los envíos completos).
+    std::vector<NrpnMessage> parameters;
+    if (includeParameters)
     {
-        /// @version 0.6: Solo enviar el mensaje si el control está activo.
-        if (control->isActive())
-        {
-            m_midiService->sendCcMessage(
-                m_currentMidiChannel,
-                static_cast<unsigned char>(control->getCcNumber()),
-                static_cast<unsigned char>(control->getCurrentValue())
-            );
-            sent_count++;
-        }
+        m_parameters->appendActiveParameters(m_currentMidiChannel, parameters);
+    }
+
+    /// @version 1.1: Estimar la duración del volcado antes de enviarlo.
+    /// @version 2.9: Con los NRPN/RPN codificados como saldrían (dirección incluida al cambiar de parámetro).
+    std::vector<MidiMessage> estimated = messages;
+    NrpnEncoder encoder;
+    for (const NrpnMessage& parameter : parameters)
+    {
+        MidiMessage encoded[NrpnEncoder::MAX_MESSAGES];
+        estimated.insert(estimated.end(), encoded, encoded + encoder.encode(parameter, encoded));
+    }
+    auto estimate = m_midiService->estimateTransmitTime(estimated.data(), estimated.size());
+
+    m_batchLabel = label;
+    m_batchSize = messages.size();
+    m_batchStatsBefore = m_midiService->getTransmitStats();
+    m_batchStart = std::chrono::steady_clock::now();
+    m_batchNote.clear();
+
+    m_midiService->sendBatch(messages);
+    m_midiService->sendParameters(parameters);
+    const std::string nrpn = parameters.empty() ? "" : " and " + std::to_string(parameters.size()) + " NRPN/RPN parameters";
+
+    /// @version 2.7: Un layout multitímbrico sale por varios canales (agrupados, ver appendActiveBatch()).
+    const std::string channels = m_parameters->hasChannelOverrides() ? "per-control channels"
+                                                                     : "Channel " + std::to_string(m_currentMidiChannel + 1);
+    updateStatus(label + ": sending " + std::to_string(messages.size()) + " MIDI CC messages" + nrpn + " on " + channels +
+                 " (~" + std::to_string(estimate.count() / 1000) + " ms)...");
+
+    // El informe se muestra cuando el hilo de salida termina; se reprograma si todavía no terminó.
+    Fl::remove_timeout(onBatchReport_static, this);
+    Fl::add_timeout(std::chrono::duration<double>(estimate).count() + 0.02, onBatchReport_static, this);
+}
+
+/**
+ * @brief Muestra las llamadas a RtMidi y el tiempo real que llevó el último lote.
+ */
+void MainWindow::onBatchReport()
+{
+    if (!m_midiService->isOutputIdle())
+    {
+        Fl::repeat_timeout(0.02, onBatchReport_static, this);
+        return;
     }
-    updateStatus("Sent " + std::to_string(sent_count) + " active MIDI CC messages on Channel " + std::to_string(m_currentMidiChannel + 1) + ".");
+
+    auto stats = m_midiService->getTransmitStats();
+    unsigned long calls = stats.calls - m_batchStatsBefore.calls;
+    unsigned long bytes = stats.bytes - m_batchStatsBefore.bytes;
+    double busy_ms = std::chrono::duration<double, std::milli>(stats.busy - m_batchStatsBefore.busy).count();
+    double total_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - m_batchStart).count();
+
+    // busy_ms es el tiempo dentro de RtMidi (codificación + drains); total_ms incluye el ritmo del cable.
+    char timing[96];
+    std::snprintf(timing, sizeof(timing), "RtMidi %.2f ms, total %.1f ms", busy_ms, total_ms);
+
+    /// @version 0.9: Mostrar la profundidad de la cola de salida y los descartes para detectar contrapresión.
+    updateStatus(m_batchLabel + ": " + std::to_string(m_batchSize) + " messages, " + std::to_string(bytes) + " bytes in " +
+                 std::to_string(calls) + " drain(s), " + timing + ". Dropped: " + std::to_string(m_midiService->getDroppedCount()) +
+                 ", coalesced: " + std::to_string(m_midiService->getCoalescedCount()) + "." + m_batchNote);
 }
 
 /** 
@@ -487,4 +982,812 @@ void MainWindow::populateMidiPorts()
     m_portChoice->value(0); // Seleccionar el primer puerto por defecto
     m_portChoice->activate();
     updateStatus("MIDI ports found. Select a port.");
-}
\ No newline at end of file
+}
+
+/// --- @version 2.2: Entrada MIDI ---
+
+void MainWindow::populateMidiInputPorts()
+{
+    m_inputPortChoice->clear();
+    m_inputPortChoice->add("None");
+    m_inputPortChoice->value(0);
+    if (!m_midiInput)
+    {
+        m_inputPortChoice->deactivate();
+        return;
+    }
+
+    const unsigned int num_ports = m_midiInput->getPortCount();
+    for (unsigned int i = 0; i < num_ports; ++i)
+    {
+        // add() interpreta '/' como submenú; replace() toma el nombre tal cual.
+        m_inputPortChoice->add("port");
+        m_inputPortChoice->replace(static_cast<int>(i) + 1, m_midiInput->getPortName(i).c_str());
+    }
+    m_inputPortChoice->activate();
+}
+
+void MainWindow::onInputPortSelected()
+{
+    if (!m_midiInput)
+    {
+        return;
+    }
+    m_midiInput->closePort();
+    m_receivedSysEx.clear(); /// @version 3.0: Lo recibido pertenece al puerto anterior.
+
+    const int item = m_inputPortChoice->value();
+    if (item <= 0)
+    {
+        m_inputActivityBox->copy_label("In: -");
+        updateStatus("MIDI input closed.");
+        return;
+    }
+    if (m_midiInput->openPort(static_cast<unsigned int>(item - 1)))
+    {
+        updateStatus("MIDI input opened: " + m_midiInput->getPortName(item - 1));
+    }
+    else
+    {
+        m_inputPortChoice->value(0);
+        updateStatus("Error: Could not open MIDI input port " + std::to_string(item - 1));
+    }
+}
+
+/**
+ * @brief Vacía la cola de entrada en lotes acotados (hilo de FLTK).
+ * @details Cada llamada procesa como máximo MIDI_INPUT_BATCH eventos. Si quedan más, el
+ * siguiente lote se programa con un timeout corto en lugar de seguir en el bucle, así la
+ * GUI atiende el redibujado y el mouse entre lotes aunque un controlador envíe sin parar.
+ */
+void MainWindow::onMidiInputDrain()
+{
+    if (!m_midiInput)
+    {
+        return;
+    }
+    const std::size_t count = m_midiInput->drain(m_inputEvents.data(), m_inputEvents.size());
+    if (count > 0)
+    {
+        handleMidiInput(m_inputEvents.data(), count);
+    }
+
+    /// @version 3.0: Los SysEx recibidos se acumulan hasta "Save Received SysEx...".
+    std::size_t sysExCount = 0;
+    while (sysExCount < MIDI_INPUT_BATCH && m_midiInput->popSysEx(m_sysExMessage))
+    {
+        m_receivedSysEx.insert(m_receivedSysEx.end(), m_sysExMessage.begin(), m_sysExMessage.end());
+        ++sysExCount;
+
+        /// @version 3.1: Puede ser la respuesta a "Request Device State" (se aplica en onDumpTick()).
+        if (m_dumpEngine->offer(m_sysExMessage))
+        {
+            Fl::remove_timeout(onDumpTick_static, this);
+            Fl::add_timeout(0.0, onDumpTick_static, this);
+        }
+    }
+    if (sysExCount > 0)
+    {
+        char text[64];
+        std::snprintf(text, sizeof(text), "In: %lu | SysEx %zu B", m_midiInput->getReceivedCount(), m_sysExMessage.size());
+        m_inputActivityBox->copy_label(text);
+        m_inputActivityBox->redraw();
+    }
+    if (m_midiInput->hasPending() && !Fl::has_timeout(onMidiInputDrain_static, this))
+    {
+        Fl::add_timeout(MIDI_INPUT_DRAIN_INTERVAL, onMidiInputDrain_static, this);
+    }
+}
+
+/**
+ * @brief Procesa un lote de eventos recibidos: muestra la actividad y los aplica al almacén.
+ * @param events Los eventos, en orden de llegada.
+ * @param count La cantidad de eventos.
+ */
+void MainWindow::handleMidiInput(const MidiInputEvent* events, std::size_t count)
+{
+    // Una sola actualización de la etiqueta por lote, con el último mensaje.
+    const MidiMessage& last = events[count - 1].message;
+    char text[64];
+    const unsigned int kind = last.status() & 0xF0;
+    if (kind == 0xB0 && last.size() == 3)
+    {
+        std::snprintf(text, sizeof(text), "In: %lu | Ch %u CC %u = %u", m_midiInput->getReceivedCount(),
+                      (last.status() & 0x0F) + 1u, last.bytes[1], last.bytes[2]);
+    }
+    else
+    {
+        std::snprintf(text, sizeof(text), "In: %lu | Status 0x%02X", m_midiInput->getReceivedCount(), last.status());
+    }
+    m_inputActivityBox->copy_label(text);
+    m_inputActivityBox->redraw();
+
+    /// @version 2.4: Con una fila armada, el primer CC del lote se aprende (y también se aplica abajo).
+    if (m_learnMap->getArmedRow() != MidiLearnMap::NO_ROW)
+    {
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            const MidiMessage& message = events[i].message;
+            if (message.size() == 3 && (message.status() & 0xF0) == 0xB0)
+            {
+                learnBinding(message.status() & 0x0F, message.bytes[1]);
+                break;
+            }
+        }
+    }
+
+    /// @version 2.3: Los CC del canal seleccionado van al almacén ya; los sliders, en el próximo cuadro.
+    if (m_sync->apply(events, count, m_currentMidiChannel) > 0 && !Fl::has_timeout(onSyncRefresh_static, this))
+    {
+        Fl::add_timeout(DISPLAY_REFRESH_INTERVAL, onSyncRefresh_static, this);
+    }
+}
+
+/**
+ * @brief @version 2.3: Redibuja los sliders de las filas que cambió la entrada MIDI.
+ * @details Se llama como mucho una vez por cuadro, sin importar cuántos CC llegaron.
+ */
+void MainWindow::onSyncRefresh()
+{
+    m_sync->takeDirtyRows(m_syncRows);
+    if (m_virtualList->visible())
+    {
+        m_virtualList->refresh(); // Solo las filas a la vista tienen widgets.
+        return;
+    }
+    for (std::size_t row : m_syncRows)
+    {
+        if (row < m_controls.size())
+        {
+            m_controls[row]->refresh(); // El control es la vista de la fila row (ver addSliderControl()).
+        }
+    }
+}
+
+/// --- @version 1.9: Bancos de presets ---
+
+/**
+ * @brief Abre un banco de presets (.mccbank) y llena el selector con sus nombres.
+ * @param filename La ruta del banco.
+ * @return true Si el banco se pudo abrir.
+ */
+bool MainWindow::openPresetBank(const std::string& filename)
+{
+    std::string display_name = Utils::getFileNameFromPath(filename);
+    m_bankChoice->clear();
+    if (!m_presetBank.open(filename))
+    {
+        m_bankChoice->deactivate();
+        updateStatus("Error opening preset bank " + display_name);
+        fl_alert(("Error al abrir el banco de presets:\n" + display_name).c_str());
+        return false;
+    }
+
+    for (std::size_t i = 0; i < m_presetBank.size(); ++i)
+    {
+        // replace() toma el texto literal; add() interpretaría '/', '&' y '_' del nombre.
+        int item = m_bankChoice->add("preset");
+        m_bankChoice->replace(item, std::string(m_presetBank.getName(i)).c_str());
+    }
+    if (m_presetBank.size() > 0)
+    {
+        m_bankChoice->activate();
+    }
+    else
+    {
+        m_bankChoice->deactivate();
+    }
+    m_bankChoice->redraw();
+
+    updateStatus("Preset bank " + display_name + " opened. " + std::to_string(m_presetBank.size()) + " presets.");
+    return true;
+}
+
+/**
+ * @brief Aplica el preset elegido en el selector del banco.
+ */
+void MainWindow::onBankPresetSelected()
+{
+    int index = m_bankChoice->value();
+    if (index < 0 || static_cast<std::size_t>(index) >= m_presetBank.size())
+    {
+        return;
+    }
+    if (m_parameters->empty())
+    {
+        updateStatus("Error: No MIDI controls loaded. Please load a layout first.");
+        fl_alert("No hay controles MIDI cargados. Por favor, carga un archivo de diseño (layout) primero.");
+        return;
+    }
+    // El registro se lee directamente del archivo mapeado, sin E/S ni parseo.
+    recallPreset(m_presetBank.get(index), std::string(m_presetBank.getName(index)));
+}
+
+/**
+ * @brief Muestra un diálogo para abrir un banco de presets.
+ */
+void MainWindow::onOpenBank()
+{
+    const char* filename = fl_file_chooser("Open Preset Bank", "*.mccbank", m_lastBankPath.c_str());
+    if (filename)
+    {
+        m_lastBankPath = Utils::getDirectoryFromPath(filename);
+        openPresetBank(filename);
+    }
+}
+
+/**
+ * @brief Importa varios presets CSV a un banco nuevo y lo abre.
+ */
+void MainWindow::onImportBank()
+{
+    Fl_File_Chooser chooser(m_lastPresetPath.c_str(), "*.csv", Fl_File_Chooser::MULTI, "Import CSV Presets");
+    chooser.show();
+    while (chooser.shown())
+    {
+        Fl::wait();
+    }
+    if (chooser.count() == 0 || !chooser.value(1))
+    {
+        return; // Cancelado.
+    }
+
+    std::vector<std::string> files;
+    for (int i = 1; i <= chooser.count(); ++i)
+    {
+        files.push_back(chooser.value(i));
+    }
+    m_lastPresetPath = Utils::getDirectoryFromPath(files.front());
+
+    const char* bank_char = fl_file_chooser("Save Preset Bank As", "*.mccbank", "presets.mccbank", 1);
+    if (!bank_char)
+    {
+        return;
+    }
+    std::string bank_file = bank_char;
+    if (bank_file.rfind(".mccbank") == std::string::npos)
+    {
+        bank_file += ".mccbank";
+    }
+    m_lastBankPath = Utils::getDirectoryFromPath(bank_file);
+
+    std::size_t imported = PresetBank::importCsv(files, bank_file);
+    if (imported == 0)
+    {
+        updateStatus("No presets imported into " + Utils::getFileNameFromPath(bank_file));
+        fl_alert(("No se pudo importar ningún preset al banco:\n" + Utils::getFileNameFromPath(bank_file)).c_str());
+        return;
+    }
+    if (openPresetBank(bank_file))
+    {
+        updateStatus(std::to_string(imported) + " of " + std::to_string(files.size()) +
+                     " CSV presets imported into " + Utils::getFileNameFromPath(bank_file) + ".");
+    }
+}
+
+/**
+ * @brief Exporta cada preset del banco abierto a un CSV en el directorio elegido.
+ */
+void MainWindow::onExportBank()
+{
+    if (!m_presetBank.isOpen() || m_presetBank.size() == 0)
+    {
+        updateStatus("No preset bank open to export.");
+        fl_alert("No hay un banco de presets abierto para exportar.");
+        return;
+    }
+
+    const char* directory = fl_dir_chooser("Export Bank to Directory", m_lastPresetPath.c_str());
+    if (directory)
+    {
+        m_lastPresetPath = directory;
+        std::size_t written = m_presetBank.exportCsv(directory);
+        updateStatus(std::to_string(written) + " presets exported to " + Utils::getFileNameFromPath(directory) + ".");
+    }
+}
+
+/// --- @version 2.0: Transiciones entre presets ---
+
+/**
+ * @brief Copia al almacén los valores alcanzados por la transición y refresca los sliders.
+ * @details Corre en el hilo de FLTK; el motor envía por su cuenta desde su propio hilo.
+ */
+void MainWindow::onMorphTick()
+{
+    m_parameters->applyPreset(m_morphEngine->getCurrent());
+    refreshControls();
+
+    if (m_morphEngine->isRunning())
+    {
+        Fl::repeat_timeout(MORPH_GUI_INTERVAL, onMorphTick_static, this);
+        return;
+    }
+    updateStatus("Morph to " + m_morphLabel + " finished. " +
+                 std::to_string(m_morphEngine->getEmittedCount() - m_morphEmittedBefore) + " CC messages sent.");
+}
+
+/**
+ * @brief Cancela la transición en curso, si la hay. Los valores quedan donde llegaron.
+ */
+void MainWindow::stopMorph()
+{
+    if (m_morphEngine->isRunning())
+    {
+        m_morphEngine->stop();
+        m_parameters->applyPreset(m_morphEngine->getCurrent());
+        refreshControls();
+    }
+    Fl::remove_timeout(onMorphTick_static, this);
+}
+
+/// --- @version 2.1: Pad XY ---
+
+/**
+ * @brief Muestra la ventana del pad XY; la crea la primera vez.
+ */
+void MainWindow::onShowXYPad()
+{
+    if (!m_xyPadWindow)
+    {
+        m_xyPadWindow = new Fl_Window(300, 340, "XY Morph Pad");
+        m_xyPadWindow->begin();
+        m_xyPad = std::make_unique<XYPadControl>(m_parameters, m_midiService);
+        m_xyPad->createWidgets(10, 10, 280, 320, &m_currentMidiChannel);
+        m_xyPad->getWidgetGroup()->callback(onXYPadMoved_static, this);
+        m_xyPadWindow->end();
+        m_xyPadWindow->resizable(m_xyPad->getWidgetGroup());
+    }
+    m_xyPadWindow->show();
+    updateStatus("XY Pad: set each corner from the current values, then drag to blend.");
+}
+
+/**
+ * @brief El pad ya escribió en el almacén y envió los CC que cambiaron: refrescar los sliders.
+ */
+void MainWindow::onXYPadMoved()
+{
+    // El pad manda sobre una transición en curso. No se usa stopMorph(): volvería a escribir
+    // en el almacén los valores del motor encima de los del pad.
+    if (m_morphEngine->isRunning())
+    {
+        m_morphEngine->stop();
+        Fl::remove_timeout(onMorphTick_static, this);
+    }
+    refreshControls();
+    updateStatus("XY Pad: " + std::to_string(m_xyPad->getLastSentCount()) + " CC messages sent.");
+}
+
+/// --- @version 2.4: MIDI Learn ---
+
+void MainWindow::onLearnToggled()
+{
+    const bool learning = m_learnButton->value() != 0;
+    m_learnMap->setLearning(learning);
+    refreshControls(); // Quitar el resaltado de una fila armada.
+    if (!learning)
+    {
+        updateStatus("MIDI Learn off. " + std::to_string(m_learnMap->size()) + " bindings.");
+    }
+    else if (m_parameters->empty())
+    {
+        updateStatus("MIDI Learn: load a layout first.");
+    }
+    else if (!m_midiInput || !m_midiInput->isPortOpen())
+    {
+        updateStatus("MIDI Learn: select a MIDI input port, then click a slider.");
+    }
+    else
+    {
+        updateStatus("MIDI Learn: click a slider, then move a knob.");
+    }
+}
+
+void MainWindow::onLearnArmed()
+{
+    const int row = m_learnMap->getArmedRow();
+    refreshControls(); // Mover el resaltado a la fila armada.
+    if (row != MidiLearnMap::NO_ROW)
+    {
+        updateStatus("MIDI Learn: move a knob for '" + m_parameters->getDescription(static_cast<std::size_t>(row)) + "'.");
+    }
+}
+
+/**
+ * @brief Asocia la fila armada al (canal, CC) recibido y guarda los bindings junto al layout.
+ * @param channel El canal de entrada (0-15).
+ * @param cc El CC de entrada.
+ */
+void MainWindow::learnBinding(unsigned char channel, unsigned char cc)
+{
+    const int row = m_learnMap->getArmedRow();
+    if (!m_learnMap->capture(channel, cc))
+    {
+        return;
+    }
+    const std::string path = MidiLearnMap::bindingsPathFor(m_layoutFile);
+    const bool saved = m_learnMap->save(path);
+    refreshControls();
+    updateStatus("Learned: Ch " + std::to_string(channel + 1) + " CC " + std::to_string(cc) + " -> '" +
+                 m_parameters->getDescription(static_cast<std::size_t>(row)) + "'." +
+                 (saved ? " Saved to " + Utils::getFileNameFromPath(path) + "." : " Error: could not save bindings."));
+}
+
+/// --- @version 2.5: MIDI thru ---
+
+void MainWindow::onThruToggled()
+{
+    const bool enabled = m_thruButton->value() != 0;
+    if (!enabled)
+    {
+        m_thruRouter->setEnabled(false);
+        Fl::remove_timeout(onThruReport_static, this);
+        m_thruReportedCount = ~0UL; // Publicar el resumen aunque no haya nada nuevo.
+        onThruReport();
+        return;
+    }
+
+    // Los percentiles se publican por sesión de thru: se parte de la instantánea actual.
+    m_thruBaseline = m_thruRouter->getLatencySnapshot();
+    m_thruReportedCount = m_thruRouter->getForwardedCount();
+    m_thruRouter->setEnabled(true);
+    Fl::add_timeout(THRU_REPORT_INTERVAL, onThruReport_static, this);
+
+    const bool inputOpen = m_midiInput && m_midiInput->isPortOpen();
+    const bool outputOpen = m_midiService && m_midiService->isPortOpen();
+    if (!inputOpen || !outputOpen)
+    {
+        updateStatus("MIDI thru on: waiting for " + std::string(!inputOpen ? "a MIDI input port" : "a MIDI output port") + ".");
+    }
+    else if (m_midiInput->getPortName(static_cast<unsigned int>(m_inputPortChoice->value() - 1)) ==
+             m_midiService->getPortName(static_cast<unsigned int>(m_portChoice->value())))
+    {
+        updateStatus("MIDI thru on. Warning: input and output are the same device; its messages return to it.");
+    }
+    else
+    {
+        updateStatus("MIDI thru on: " + m_midiInput->getPortName(static_cast<unsigned int>(m_inputPortChoice->value() - 1)) +
+                     " -> " + m_midiService->getPortName(static_cast<unsigned int>(m_portChoice->value())) + ".");
+    }
+}
+
+/**
+ * @brief Publica en la barra de estado los percentiles de latencia del thru desde que se activó.
+ * @details Solo reescribe la barra si se reenviaron mensajes desde el último informe, para no
+ * tapar otros mensajes mientras el teclado está quieto.
+ */
+void MainWindow::onThruReport()
+{
+    const unsigned long forwarded = m_thruRouter->getForwardedCount();
+    if (forwarded != m_thruReportedCount)
+    {
+        m_thruReportedCount = forwarded;
+        const LatencyHistogram::Snapshot session = m_thruRouter->getLatencySnapshot().since(m_thruBaseline);
+        char text[160];
+        std::snprintf(text, sizeof(text),
+                      "MIDI thru%s: %llu forwarded | latency p50 %.1f us, p99 %.1f us, p99.9 %.1f us, max %.1f us",
+                      m_thruRouter->isEnabled() ? "" : " off", static_cast<unsigned long long>(session.total),
+                      session.percentile(0.50) / 1000.0, session.percentile(0.99) / 1000.0,
+                      session.percentile(0.999) / 1000.0, session.max() / 1000.0);
+        updateStatus(text);
+    }
+    if (m_thruRouter->isEnabled())
+    {
+        Fl::repeat_timeout(THRU_REPORT_INTERVAL, onThruReport_static, this);
+    }
+}
+
+/// --- @version 2.6: Sesiones multi-dispositivo ---
+
+void MainWindow::setSessionHost(ISessionHost* host)
+{
+    m_sessionHost = host;
+    if (host)
+    {
+        m_sessionMenu->activate();
+    }
+    else
+    {
+        m_sessionMenu->deactivate();
+    }
+}
+
+/**
+ * @brief Describe el dispositivo que edita esta ventana, para guardarlo en una sesión.
+ */
+SessionDevice MainWindow::getSessionDevice() const
+{
+    SessionDevice device;
+    if (m_midiService && m_midiService->isPortOpen() && m_portChoice->value() >= 0)
+    {
+        device.port_name = m_midiService->getPortName(static_cast<unsigned int>(m_portChoice->value()));
+    }
+    device.channel = m_currentMidiChannel;
+    device.layout_path = m_layoutFile;
+    return device;
+}
+
+/**
+ * @brief Abre el puerto (por nombre), elige el canal y carga el layout de un dispositivo.
+ * @return true Si el puerto existe en este sistema.
+ */
+bool MainWindow::applySessionDevice(const SessionDevice& device)
+{
+    bool portFound = device.port_name.empty();
+    const unsigned int num_ports = m_midiService ? m_midiService->getPortCount() : 0;
+    for (unsigned int i = 0; i < num_ports && !portFound; ++i)
+    {
+        if (m_midiService->getPortName(i) == device.port_name)
+        {
+            m_portChoice->value(static_cast<int>(i));
+            onPortSelected();
+            portFound = true;
+        }
+    }
+
+    m_channelChoice->value(device.channel & 0x0F);
+    onChannelSelected();
+
+    if (!device.layout_path.empty())
+    {
+        loadMidiLayoutFromFile(device.layout_path);
+    }
+    if (!portFound)
+    {
+        updateStatus("Warning: MIDI port not found: " + device.port_name);
+    }
+    return portFound;
+}
+
+void MainWindow::onSessionMenu()
+{
+    if (!m_sessionHost)
+    {
+        return;
+    }
+    const char* item = m_sessionMenu->text();
+    if (!item)
+    {
+        return;
+    }
+
+    const std::string choice = item;
+    if (choice == "New Device Window")
+    {
+        m_sessionHost->addDeviceWindow();
+        return;
+    }
+
+    const bool saving = choice == "Save Session...";
+    const char* filename = saving ? fl_file_chooser("Save MIDI Session", "*.csv", m_lastLayoutPath.c_str())
+                                  : fl_file_chooser("Open MIDI Session", "*.csv", m_lastLayoutPath.c_str());
+    if (!filename)
+    {
+        return;
+    }
+    const std::string path = filename; // El buffer de fl_file_chooser se reutiliza en la próxima llamada.
+    m_lastLayoutPath = Utils::getDirectoryFromPath(path);
+    const std::string display_name = Utils::getFileNameFromPath(path);
+
+    const int devices = saving ? m_sessionHost->saveSession(path) : m_sessionHost->openSession(path);
+    if (devices < 0)
+    {
+        updateStatus("Error: Could not " + std::string(saving ? "save" : "open") + " MIDI session " + display_name);
+        fl_alert(((saving ? "Error al guardar la sesión MIDI:\n" : "Error al abrir la sesión MIDI:\n") + display_name).c_str());
+        return;
+    }
+    updateStatus(std::string(saving ? "Session saved to " : "Session opened from ") + display_name + ": " +
+                 std::to_string(devices) + " device(s).");
+}
+
+/**
+ * @brief @version 3.0: Envía un .syx, guarda los SysEx recibidos o cancela el envío en curso.
+ */
+void MainWindow::onSysExMenu()
+{
+    const char* item = m_sysExMenu->text();
+    if (!item)
+    {
+        return;
+    }
+    const std::string choice = item;
+    if (choice == "Send SysEx File...")
+    {
+        sendSysExFile();
+    }
+    else if (choice == "Save Received SysEx...")
+    {
+        saveReceivedSysEx();
+    }
+    else if (choice == "Request Device State")
+    {
+        requestDeviceState();
+    }
+    else if (m_midiService && m_midiService->isSysExBusy())
+    {
+        m_midiService->cancelSysEx();
+        updateStatus("SysEx send cancelled.");
+    }
+}
+
+void MainWindow::sendSysExFile()
+{
+    if (!m_midiService || !m_midiService->isPortOpen())
+    {
+        updateStatus("Error: No hay un puerto MIDI abierto para enviar los datos.");
+        fl_alert("Por favor, selecciona un puerto MIDI válido primero.");
+        return;
+    }
+    const char* filename = fl_file_chooser("Send SysEx File", "*.syx", m_lastSysExPath.c_str());
+    if (!filename)
+    {
+        return;
+    }
+    const std::string path = filename;
+    m_lastSysExPath = Utils::getDirectoryFromPath(path);
+    const std::string display_name = Utils::getFileNameFromPath(path);
+
+    // El archivo mapeado vive hasta que el hilo de salida termina de transmitirlo: no se copia.
+    auto file = std::make_shared<const MappedFile>(path);
+    const std::string_view bytes = file->view();
+    const std::shared_ptr<const unsigned char> data(file, reinterpret_cast<const unsigned char*>(bytes.data()));
+    if (!file->isOpen() || !m_midiService->sendSysEx(data, bytes.size()))
+    {
+        updateStatus("Error: " + display_name + " is not a valid SysEx file.");
+        fl_alert(("El archivo no contiene mensajes SysEx válidos:\n" + display_name).c_str());
+        return;
+    }
+
+    m_sysExSendSize = bytes.size();
+    m_sysExSendStart = std::chrono::steady_clock::now();
+    updateStatus("SysEx: sending " + std::to_string(bytes.size()) + " bytes from " + display_name + " in " +
+                 std::to_string(m_midiService->getSysExChunkBytes()) + "-byte chunks...");
+    Fl::remove_timeout(onSysExReport_static, this);
+    Fl::add_timeout(0.1, onSysExReport_static, this);
+}
+
+/**
+ * @brief @version 3.0: Informa la duración del envío de SysEx cuando el hilo de salida termina.
+ */
+void MainWindow::onSysExReport()
+{
+    if (m_midiService->isSysExBusy())
+    {
+        Fl::repeat_timeout(0.1, onSysExReport_static, this);
+        return;
+    }
+    const auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - m_sysExSendStart);
+    updateStatus("SysEx: " + std::to_string(m_sysExSendSize) + " bytes sent in " + std::to_string(elapsed.count()) + " ms.");
+}
+
+void MainWindow::saveReceivedSysEx()
+{
+    if (m_receivedSysEx.empty())
+    {
+        updateStatus("No SysEx received since the last save.");
+        return;
+    }
+    const char* filename = fl_file_chooser("Save Received SysEx As", "*.syx", "dump.syx", 1);
+    if (!filename)
+    {
+        return;
+    }
+    const std::string path = filename;
+    std::ofstream file(path, std::ios::binary);
+    if (!file.write(reinterpret_cast<const char*>(m_receivedSysEx.data()), static_cast<std::streamsize>(m_receivedSysEx.size())))
+    {
+        updateStatus("Error: Could not save SysEx to " + Utils::getFileNameFromPath(path));
+        fl_alert(("Error al guardar el SysEx:\n" + Utils::getFileNameFromPath(path)).c_str());
+        return;
+    }
+    m_lastSysExPath = Utils::getDirectoryFromPath(path);
+    updateStatus("SysEx saved to " + Utils::getFileNameFromPath(path) + ": " + std::to_string(m_receivedSysEx.size()) + " bytes.");
+    m_receivedSysEx.clear();
+}
+
+/**
+ * @brief @version 3.1: Pide al dispositivo su estado actual con el pedido SysEx del layout.
+ * @details Solo encola el pedido: la respuesta llega por onMidiInputDrain() y onDumpTick()
+ * vence los plazos y reintenta, así la GUI sigue respondiendo mientras llega un volcado grande.
+ */
+void MainWindow::requestDeviceState()
+{
+    if (!m_dumpTemplate.isValid())
+    {
+        updateStatus("Error: The layout has no device state request (" +
+                     Utils::getFileNameFromPath(SysExDumpTemplate::pathFor(m_layoutFile)) + ").");
+        fl_alert("El layout no tiene un pedido de volcado SysEx (archivo .dump.csv junto al layout).");
+        return;
+    }
+    if (!m_midiService || !m_midiService->isPortOpen() || !m_midiInput || !m_midiInput->isPortOpen())
+    {
+        updateStatus("Error: Device state request needs both MIDI ports open.");
+        fl_alert("Para leer el estado del dispositivo selecciona un puerto MIDI de salida y uno de entrada.");
+        return;
+    }
+
+    Fl::remove_timeout(onDumpTick_static, this);
+    if (!m_dumpEngine->start(m_dumpTemplate, m_currentMidiChannel, DumpRequestEngine::Clock::now()))
+    {
+        updateStatus("Error: Could not send the device state request.");
+        return;
+    }
+    updateStatus("Requesting device state...");
+    Fl::add_timeout(DUMP_POLL_INTERVAL, onDumpTick_static, this);
+}
+
+void MainWindow::onDumpTick()
+{
+    const auto now = DumpRequestEngine::Clock::now();
+    const unsigned int attempts = m_dumpEngine->getAttempts();
+    switch (m_dumpEngine->poll(now))
+    {
+        case DumpRequestEngine::State::Waiting:
+            if (m_dumpEngine->getAttempts() != attempts)
+            {
+                updateStatus("No answer from the device, retrying (attempt " + std::to_string(m_dumpEngine->getAttempts()) + ")...");
+            }
+            Fl::repeat_timeout(DUMP_POLL_INTERVAL, onDumpTick_static, this);
+            break;
+        case DumpRequestEngine::State::Received:
+            applyDeviceState();
+            break;
+        case DumpRequestEngine::State::Failed:
+            updateStatus("Error: No device state received after " + std::to_string(m_dumpEngine->getAttempts()) + " requests.");
+            m_dumpEngine->cancel();
+            break;
+        case DumpRequestEngine::State::Idle:
+            break;
+    }
+}
+
+void MainWindow::applyDeviceState()
+{
+    stopMorph();
+    const std::vector<unsigned char>& response = m_dumpEngine->getResponse();
+
+    // Solo los CC que trae el volcado; el resto del estado actual queda igual (y activo o no, como estaba).
+    PresetImage received;
+    const std::size_t decoded = m_dumpEngine->getTemplate().decode(response.data(), response.size(), received);
+    PresetImage image = m_parameters->snapshot();
+    for (int cc = 0; cc < static_cast<int>(PresetImage::CONTROLLERS); ++cc)
+    {
+        if (received.has(cc))
+        {
+            image.set(cc, received.value(cc), image.has(cc) ? image.isActive(cc) : true);
+        }
+    }
+    const std::size_t updated_count = m_parameters->applyPreset(image);
+    refreshControls();
+
+    // El dispositivo ya tiene estos valores: el recall incremental no debe reenviarlos.
+    // Se anota el valor que quedó en el store (ya recortado al rango del control), no el crudo.
+    const PresetImage stored = m_parameters->snapshot();
+    MidiMessage messages[ParameterStore::MAX_MESSAGES_PER_ROW];
+    for (int cc = 0; cc < static_cast<int>(PresetImage::CONTROLLERS); ++cc)
+    {
+        if (!received.has(cc) || !stored.has(cc) || m_parameters->firstRowForCc(cc) == ParameterStore::NO_ROW)
+        {
+            continue;
+        }
+        const unsigned char channel = m_parameters->channelForCc(cc, m_currentMidiChannel);
+        std::size_t count = 1;
+        if (m_parameters->isHighResolutionCc(cc))
+        {
+            count = MidiMessage::controlChange14(channel, static_cast<unsigned char>(cc), stored.value(cc), messages);
+        }
+        else
+        {
+            messages[0] = MidiMessage::controlChange(channel, static_cast<unsigned char>(cc), static_cast<unsigned char>(stored.value(cc) & 0x7F));
+        }
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            m_midiService->noteReceived(messages[i]);
+        }
+    }
+
+    const auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(m_dumpEngine->getElapsed(DumpRequestEngine::Clock::now()));
+    updateStatus("Device state received: " + std::to_string(response.size()) + " bytes, " + std::to_string(decoded) +
+                 " CCs decoded, " + std::to_string(updated_count) + " controls updated in " + std::to_string(elapsed.count()) +
+                 " ms (" + std::to_string(m_dumpEngine->getAttempts()) + " requests).");
+    m_dumpEngine->cancel();
+}
@@ -0,0 +1,55 @@
+/**
+ * @file MappedFile.cpp
+ * @author Gabriel Nicolás González Ferreira (gabrielinuz@fi.mdp.edu.ar)
+ * @brief Implementación del mapeo en memoria de archivos de solo lectura (POSIX).
+ * @version 1.7
+ * @date 2026-10-16
+ */
+#include "MappedFile.hpp"
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+MappedFile::MappedFile(const std::string& filename)
+    : m_data(nullptr), m_size(0), m_open(false)
+{
+    const int fd = ::open(filename.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0)
+    {
+        return;
+    }
+
+    struct stat info;
+    if (::fstat(fd, &info) == 0 && S_ISREG(info.st_mode))
+    {
+        m_size = static_cast<std::size_t>(info.st_size);
+        if (m_size == 0)
+        {
+            m_open = true; // mmap no acepta longitud 0; la vista queda vacía.
+        }
+        else
+        {
+            void* data = ::mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (data != MAP_FAILED)
+            {
+                ::madvise(data, m_size, MADV_SEQUENTIAL); // Los parsers leen de principio a fin.
+                m_data = static_cast<const char*>(data);
+                m_open = true;
+            }
+            else
+            {
+                m_size = 0;
+            }
+        }
+    }
+    ::close(fd); // El mapeo sigue siendo válido sin el descriptor.
+}
+
+MappedFile::~MappedFile()
+{
+    if (m_data)
+    {
+        ::munmap(const_cast<char*>(m_data), m_size);
+    }
+}
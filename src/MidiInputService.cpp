@@ -0,0 +1,171 @@
+/**
+ * @file MidiInputService.cpp
+ * @author Gabriel Nicolás González Ferreira (gabrielinuz@fi.mdp.edu.ar)
+ * @brief Implementación de MidiInputService: callback de RtMidiIn y cola de eventos sin bloqueos.
+ * @version 3.0
+ * @date 2026-10-16
+ */
+#include "MidiInputService.hpp"
+#include <chrono>
+#include <iostream>
+
+MidiInputService::MidiInputService()
+{
+    try
+    {
+        m_midiIn = std::make_unique<RtMidiIn>();
+        // El callback se registra una sola vez; RtMidi lo invoca desde su propio hilo.
+        m_midiIn->setCallback(&MidiInputService::onMessage_static, this);
+        m_midiIn->ignoreTypes(false, true, true); // @version 3.0: Se reciben SysEx; clock y active sensing no.
+    }
+    catch (const RtMidiError& error)
+    {
+        m_errorString = error.getMessage();
+        std::cerr << "RtMidi Input Initialization Error: " << m_errorString << std::endl;
+        m_midiIn = nullptr;
+    }
+}
+
+MidiInputService::~MidiInputService()
+{
+    closePort();
+}
+
+void MidiInputService::setNotifier(Notifier notifier, void* userdata)
+{
+    m_notifier = notifier;
+    m_notifierData = userdata;
+}
+
+void MidiInputService::setForwarder(Forwarder forwarder, void* userdata)
+{
+    m_forwarder = forwarder;
+    m_forwarderData = userdata;
+}
+
+bool MidiInputService::openPort(unsigned int portNumber)
+{
+    if (!m_midiIn || isPortOpen() || portNumber >= getPortCount())
+    {
+        return false;
+    }
+    try
+    {
+        m_midiIn->openPort(portNumber);
+        m_portOpen = m_midiIn->isPortOpen();
+        return m_portOpen;
+    }
+    catch (const RtMidiError& error)
+    {
+        std::cerr << "Error opening MIDI input port: " << error.getMessage() << std::endl;
+        return false;
+    }
+}
+
+void MidiInputService::closePort()
+{
+    // RtMidi detiene su hilo al cerrar: después de esto no llegan más callbacks.
+    if (m_midiIn && m_midiIn->isPortOpen())
+    {
+        m_midiIn->closePort();
+    }
+    m_portOpen = false;
+}
+
+bool MidiInputService::isPortOpen() const
+{
+    return m_portOpen.load(std::memory_order_acquire);
+}
+
+unsigned int MidiInputService::getPortCount() const
+{
+    return m_midiIn ? m_midiIn->getPortCount() : 0;
+}
+
+std::string MidiInputService::getPortName(unsigned int portNumber) const
+{
+    if (!m_midiIn || portNumber >= getPortCount())
+    {
+        return "";
+    }
+    return m_midiIn->getPortName(portNumber);
+}
+
+std::size_t MidiInputService::drain(MidiInputEvent* out, std::size_t maxEvents)
+{
+    // Rearmar el aviso antes de leer: lo que llegue después de este punto vuelve a notificar.
+    // acq_rel se sincroniza con el exchange del productor y hace visibles sus eventos.
+    m_notifyPending.exchange(false, std::memory_order_acq_rel);
+
+    std::size_t count = 0;
+    while (count < maxEvents && m_queue.tryPop(out[count]))
+    {
+        ++count;
+    }
+    return count;
+}
+
+void MidiInputService::onMessage_static(double deltaTime, std::vector<unsigned char>* message, void* userdata)
+{
+    if (message)
+    {
+        static_cast<MidiInputService*>(userdata)->onMessage(*message);
+    }
+}
+
+void MidiInputService::onMessage(const std::vector<unsigned char>& message)
+{
+    // Hilo del handler de RtMidi: nada que bloquee ni reserve memoria.
+    if (message.empty())
+    {
+        return;
+    }
+    const std::int64_t now = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+
+    /// @version 3.0: Un SysEx llega completo; se copia en el buffer ya reservado.
+    if (message[0] == 0xF0)
+    {
+        if (!m_sysEx.tryPush(message.data(), message.size(), now))
+        {
+            m_sysExDroppedCount.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        m_receivedCount.fetch_add(1, std::memory_order_relaxed);
+        notify();
+        return;
+    }
+    if (message.size() > MidiMessage::MAX_SIZE)
+    {
+        return; // Solo mensajes de canal y SysEx.
+    }
+
+    MidiInputEvent event;
+    event.timestampNs = now;
+    event.message = MidiMessage::fromBytes(message.data(), message.size());
+
+    m_receivedCount.fetch_add(1, std::memory_order_relaxed);
+
+    /// @version 2.5: El thru sale antes de encolar: su latencia no depende de la cola de la GUI.
+    if (m_forwarder)
+    {
+        m_forwarder(event, m_forwarderData);
+    }
+
+    if (!m_queue.tryPush(event))
+    {
+        m_droppedCount.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    notify();
+}
+
+void MidiInputService::notify()
+{
+    // Un solo aviso por tanda: mientras el consumidor no haya llamado a drain() no se repite.
+    if (m_notifier && !m_notifyPending.exchange(true, std::memory_order_acq_rel))
+    {
+        m_notifier(m_notifierData);
+    }
+}
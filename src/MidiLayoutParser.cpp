@@ -2,87 +2,129 @@
  * @file MidiLayoutParser.cpp
  * @author Gabriel Nicolás González Ferreira (gabrielinuz@fi.mdp.edu.ar)
  * @brief Implementación del parser para archivos de diseño (layout) de controladores MIDI.
- * @version 0.5
- * @date 2025-06-14
+ * @version 2.9
+ * @date 2026-10-16
  */
 #include "MidiLayoutParser.hpp"
-#include <fstream>
-#include <sstream>
+#include "MappedFile.hpp"
+#include "MidiMessage.hpp"
+#include "Utils.hpp"
+#include <algorithm> // Para std::count y std::min
 #include <iostream>
-#include <algorithm> // Para std::remove
 
 namespace MidiLayoutParser
 {
+    /// @version 1.7: El archivo se mapea en memoria y se parsea en el lugar.
     bool parse(const std::string& filename, std::vector<SliderConfig>& configs)
     {
-        std::ifstream file(filename);
-        if (!file.is_open())
+        MappedFile file(filename);
+        if (!file.isOpen())
         {
             std::cerr << "Error: Could not open MIDI layout file: " << filename << std::endl;
             return false;
         }
+        return parseBuffer(file.view(), configs);
+    }
 
-        std::string line;
-        // Leer la primera línea (cabecera) y descartarla
-        if (!std::getline(file, line))
+    /// @version 1.7: Tokeniza con string_view y std::from_chars, sin excepciones ni copias por línea.
+    bool parseBuffer(std::string_view content, std::vector<SliderConfig>& configs)
+    {
+        // Leer la primera línea (cabecera) y descartarla.
+        // Si el archivo empieza con BOM UTF-8 (ej. gs-music-apollo), el BOM cae en esta línea.
+        if (content.empty())
         {
-            // Si el archivo está vacío (solo la cabecera o nada), no es un error de parseo, simplemente no hay configuraciones.
+            // Si el archivo está vacío, no es un error de parseo, simplemente no hay configuraciones.
             return true;
         }
+        Utils::nextLine(content);
 
         // Limpiar el vector de configuraciones antes de cargar nuevas
         configs.clear();
+        configs.reserve(static_cast<std::size_t>(std::count(content.begin(), content.end(), '\n')) + 1);
 
         // Procesar cada línea del archivo.
-        while (std::getline(file, line))
+        while (!content.empty())
         {
-            line.erase(std::remove(line.begin(), line.end(), '\r'), line.end()); // Eliminar retornos de carro
+            const std::string_view line = Utils::nextLine(content);
             if (line.empty()) continue; // Saltar líneas vacías
 
-            std::stringstream ss(line);
-            std::string segment;
-            SliderConfig current_config;
+            std::string_view rest = line;
+            const std::string_view description = Utils::nextField(rest, ';'); // Campo 1
+            const std::string_view cc = Utils::nextField(rest, ';');          // Campo 2
+            const std::string_view range = Utils::nextField(rest, ';');       // Campo 3: "min-max"
+            const std::string_view channel = Utils::nextField(rest, ';');     // @version 2.7: Campo 4 (opcional): canal 1-16
 
-            try
+            SliderConfig current_config;
+            const std::size_t dash_pos = range.find('-');
+            const char* reason = nullptr;
+            /// @version 2.9: "NRPN:n" o "RPN:n" en lugar del CC#.
+            const std::string_view address = cc.substr(std::min(cc.find_first_not_of(' '), cc.size()));
+            const std::size_t prefix = address.compare(0, 5, "NRPN:") == 0 ? 5 : (address.compare(0, 4, "RPN:") == 0 ? 4 : 0);
+            bool addressOk = false;
+            if (prefix > 0)
             {
-                // Leer Descripción (campo 1)
-                std::getline(ss, segment, ';');
-                current_config.description = segment;
-
-                // Leer CC# (campo 2)
-                std::getline(ss, segment, ';');
-                current_config.cc_number = std::stoi(segment);
+                current_config.type = prefix == 5 ? ParameterType::Nrpn : ParameterType::Rpn;
+                current_config.cc_number = -1;
+                addressOk = Utils::parseInt(address.substr(prefix), current_config.parameter_number) &&
+                            current_config.parameter_number >= 0 && current_config.parameter_number <= 16383;
+            }
+            else
+            {
+                addressOk = Utils::parseInt(cc, current_config.cc_number);
+            }
 
-                // Leer Rango (campo 3) - Formato "min-max"
-                std::getline(ss, segment, ';');
-                size_t dash_pos = segment.find('-');
-                if (dash_pos == std::string::npos)
-                {
-                    throw std::runtime_error("Invalid range format, expected 'min-max'");
-                }
-                current_config.min_value = std::stoi(segment.substr(0, dash_pos));
-                current_config.max_value = std::stoi(segment.substr(dash_pos + 1));
+            if (!addressOk)
+            {
+                reason = prefix > 0 ? "Invalid NRPN/RPN number, expected 0-16383" : "Invalid CC number";
+            }
+            else if (dash_pos == std::string_view::npos)
+            {
+                reason = "Invalid range format, expected 'min-max'";
+            }
+            else if (!Utils::parseInt(range.substr(0, dash_pos), current_config.min_value) ||
+                     !Utils::parseInt(range.substr(dash_pos + 1), current_config.max_value))
+            {
+                reason = "Invalid range value";
+            }
+            else if (!channel.empty() && (!Utils::parseInt(channel, current_config.channel) ||
+                                          current_config.channel < 1 || current_config.channel > 16))
+            {
+                reason = "Invalid channel, expected 1-16";
+            }
 
-                // Validar datos
-                if (current_config.cc_number < 0 || current_config.cc_number > 127 ||
-                    current_config.min_value < 0 || current_config.min_value > 127 ||
-                    current_config.max_value < 0 || current_config.max_value > 127 ||
-                    current_config.min_value > current_config.max_value)
-                {
-                    std::cerr << "Warning: Invalid data in layout line, skipping: " << line << std::endl;
-                    continue; // Saltar línea inválida
-                }
+            if (reason)
+            {
+                std::cerr << "Error parsing MIDI layout line: '" << line << "'. Reason: " << reason << std::endl;
+                continue; // Solo se salta la línea problemática y se continúa.
+            }
 
-                configs.push_back(current_config);
+            /// @version 2.8: Un máximo mayor que 127 declara un control de 14 bits (par MSB/LSB).
+            /// @version 2.9: En un NRPN/RPN, un dato de 14 bits (CC 6 y 38); cualquier número sirve.
+            current_config.high_resolution = current_config.max_value > 127;
+            const bool isCc = current_config.type == ParameterType::ControlChange;
+            if (isCc && current_config.high_resolution && current_config.cc_number > MidiMessage::HIGH_RESOLUTION_MAX_CC)
+            {
+                std::cerr << "Error parsing MIDI layout line: '" << line
+                          << "'. Reason: 14-bit controls need a CC number in 0-31" << std::endl;
+                continue;
             }
-            catch(const std::exception& e)
+
+            // Validar datos
+            const int max_value = current_config.high_resolution ? MidiMessage::HIGH_RESOLUTION_MAX_VALUE : 127;
+            if ((isCc && (current_config.cc_number < 0 || current_config.cc_number > 127)) ||
+                current_config.min_value < 0 || current_config.min_value > max_value ||
+                current_config.max_value < 0 || current_config.max_value > max_value ||
+                current_config.min_value > current_config.max_value)
             {
-                std::cerr << "Error parsing MIDI layout line: '" << line << "'. Reason: " << e.what() << std::endl;
-                // No retornar false aquí, solo se salta la línea problemática y se continúa.
+                std::cerr << "Warning: Invalid data in layout line, skipping: " << line << std::endl;
+                continue; // Saltar línea inválida
             }
+
+            current_config.channel = channel.empty() ? -1 : current_config.channel - 1; // 0-15, o -1 = canal de la ventana
+            current_config.description.assign(description.data(), description.size());
+            configs.push_back(std::move(current_config));
         }
-        file.close();
         return true;
     }
 
-} // namespace MidiLayoutParser
\ No newline at end of file
+} // namespace MidiLayoutParser
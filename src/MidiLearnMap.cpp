@@ -0,0 +1,142 @@
+/**
+ * @file MidiLearnMap.cpp
+ * @author Gabriel Nicolás González Ferreira (gabrielinuz@fi.mdp.edu.ar)
+ * @brief Implementación de la tabla de ruteo de MIDI Learn y de su archivo de bindings.
+ * @version 2.4
+ * @date 2026-10-16
+ */
+#include "MidiLearnMap.hpp"
+#include "MappedFile.hpp"
+#include "Utils.hpp"
+#include <fstream>
+#include <iostream>
+
+MidiLearnMap::MidiLearnMap()
+    : m_count(0), m_learning(false), m_armedRow(NO_ROW)
+{
+    m_routes.fill(NO_ROW);
+}
+
+void MidiLearnMap::bind(unsigned char channel, unsigned char cc, std::size_t row)
+{
+    // Una perilla por fila: si la fila ya tenía otra, se libera. Es una pasada de 2048
+    // enteros y solo ocurre al aprender, nunca al despachar.
+    for (int& route : m_routes)
+    {
+        if (route == static_cast<int>(row))
+        {
+            route = NO_ROW;
+            --m_count;
+        }
+    }
+    int& route = m_routes[(channel & 0x0F) * 128 + (cc & 0x7F)];
+    if (route == NO_ROW)
+    {
+        ++m_count;
+    }
+    route = static_cast<int>(row);
+}
+
+void MidiLearnMap::clear()
+{
+    m_routes.fill(NO_ROW);
+    m_count = 0;
+    setLearning(false);
+}
+
+void MidiLearnMap::setLearning(bool learning)
+{
+    m_learning = learning;
+    m_armedRow = NO_ROW;
+}
+
+void MidiLearnMap::setArmListener(ArmListener listener, void* userdata)
+{
+    m_armListener = listener;
+    m_armListenerData = userdata;
+}
+
+void MidiLearnMap::arm(std::size_t row)
+{
+    m_armedRow = static_cast<int>(row);
+    if (m_armListener)
+    {
+        m_armListener(m_armListenerData);
+    }
+}
+
+bool MidiLearnMap::capture(unsigned char channel, unsigned char cc)
+{
+    if (!m_learning || m_armedRow == NO_ROW)
+    {
+        return false;
+    }
+    bind(channel, cc, static_cast<std::size_t>(m_armedRow));
+    m_armedRow = NO_ROW;
+    return true;
+}
+
+std::string MidiLearnMap::bindingsPathFor(const std::string& layoutPath)
+{
+    return Utils::replaceExtension(layoutPath, ".learn.csv");
+}
+
+bool MidiLearnMap::load(const std::string& filename, std::size_t rowCount)
+{
+    m_routes.fill(NO_ROW);
+    m_count = 0;
+
+    MappedFile file(filename);
+    if (!file.isOpen())
+    {
+        return false; // Es normal: el layout todavía no tiene bindings.
+    }
+    parseBuffer(file.view(), rowCount);
+    return true;
+}
+
+void MidiLearnMap::parseBuffer(std::string_view content, std::size_t rowCount)
+{
+    while (!content.empty())
+    {
+        const std::string_view line = Utils::nextLine(content);
+        if (line.empty() || line.compare(0, 7, "Channel") == 0) continue; // Saltar líneas vacías o la cabecera
+
+        std::string_view rest = line;
+        int channel = 0;
+        int cc = 0;
+        int row = 0;
+        if (!Utils::parseInt(Utils::nextField(rest, ';'), channel) ||
+            !Utils::parseInt(Utils::nextField(rest, ';'), cc) ||
+            !Utils::parseInt(Utils::nextField(rest, ';'), row))
+        {
+            std::cerr << "Error parsing MIDI learn line: '" << line << "'. Reason: Invalid number" << std::endl;
+            continue;
+        }
+        if (channel < 1 || channel > 16 || cc < 0 || cc > 127 || row < 0 || static_cast<std::size_t>(row) >= rowCount)
+        {
+            std::cerr << "Warning: Invalid data in MIDI learn line, skipping: " << line << std::endl;
+            continue;
+        }
+        bind(static_cast<unsigned char>(channel - 1), static_cast<unsigned char>(cc), static_cast<std::size_t>(row));
+    }
+}
+
+bool MidiLearnMap::save(const std::string& filename) const
+{
+    std::ofstream file(filename);
+    if (!file.is_open())
+    {
+        std::cerr << "Error: Could not create/open MIDI learn file for writing: " << filename << std::endl;
+        return false;
+    }
+    file << "Channel;CC#;Row\n";
+    for (std::size_t key = 0; key < KEYS; ++key)
+    {
+        if (m_routes[key] != NO_ROW)
+        {
+            file << (key / 128 + 1) << ";" << (key % 128) << ";" << m_routes[key] << "\n";
+        }
+    }
+    return static_cast<bool>(file);
+}
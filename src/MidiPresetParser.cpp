@@ -2,86 +2,80 @@
  * @file MidiPresetParser.cpp
  * @author Gabriel Nicolás González Ferreira (gabrielinuz@fi.mdp.edu.ar)
  * @brief Implementación del parser y guardador para archivos de presets MIDI.
- * @version 0.6
- * @date 2025-06-17
+ * @version 2.9
+ * @date 2026-10-16
  */
 #include "MidiPresetParser.hpp"
+#include "MappedFile.hpp"
+#include "Utils.hpp"
 #include <fstream>
-#include <sstream>
 #include <iostream>
-#include <algorithm> 
 
 namespace MidiPresetParser
 {
-    // @version 0.6: La firma de la función cambia para usar el nuevo struct PresetValue.
-    bool load(const std::string& filename, std::map<int, PresetValue>& presetData)
+    /// @version 1.8: El archivo se mapea en memoria y se carga en una PresetImage.
+    bool load(const std::string& filename, PresetImage& preset)
     {
-        std::ifstream file(filename);
-        if (!file.is_open())
+        MappedFile file(filename);
+        if (!file.isOpen())
         {
             std::cerr << "Error: Could not open MIDI preset file: " << filename << std::endl;
             return false;
         }
+        return parseBuffer(file.view(), preset);
+    }
 
-        std::string line;
+    /// @version 1.8: Tokeniza con string_view y std::from_chars, sin excepciones.
+    bool parseBuffer(std::string_view content, PresetImage& preset)
+    {
         // Leer la primera línea (cabecera) y descartarla
-        if (!std::getline(file, line))
+        if (content.empty())
         {
             return true; // Archivo vacío (o solo cabecera) no es un error.
         }
+        Utils::nextLine(content);
 
-        presetData.clear(); // Limpiar el mapa antes de cargar nuevos datos.
+        preset.clear(); // Limpiar la imagen antes de cargar nuevos datos.
 
         // Procesar cada línea del archivo.
-        while (std::getline(file, line))
+        while (!content.empty())
         {
-            line.erase(std::remove(line.begin(), line.end(), '\r'), line.end());// Eliminar retornos de carro
-            if (line.empty() || line.rfind("CC#", 0) == 0) continue; // Saltar líneas vacías o la cabecera
+            const std::string_view line = Utils::nextLine(content);
+            if (line.empty() || line.compare(0, 3, "CC#") == 0) continue; // Saltar líneas vacías o la cabecera
 
-            std::stringstream ss(line);
-            std::string segment;
+            std::string_view rest = line;
+            const std::string_view ccField = Utils::nextField(rest, ';');     // Campo 1
+            const std::string_view valueField = Utils::nextField(rest, ';');  // Campo 2
+            const std::string_view activeField = Utils::nextField(rest, ';'); // Campo 3 (opcional)
 
-            try
+            int cc_number = 0;
+            int value = 0;
+            // Por defecto es true para compatibilidad con presets antiguos (CC#;Value).
+            // Se aceptan "0" o "1"; cualquier número distinto de 0 cuenta como activo.
+            int active = 1;
+            if (!Utils::parseInt(ccField, cc_number) || !Utils::parseInt(valueField, value) ||
+                (!activeField.empty() && !Utils::parseInt(activeField, active)))
             {
-                // Leer CC# (campo 1)
-                std::getline(ss, segment, ';');
-                int cc_number = std::stoi(segment);
-
-                // Leer Valor (campo 2)
-                std::getline(ss, segment, ';');
-                int value = std::stoi(segment);
-
-                // NUEVO: Leer estado de activación (campo 3)
-                bool active = true; // Por defecto es true para compatibilidad con presets antiguos
-                if (std::getline(ss, segment, ';'))
-                {
-                    // Si hay un tercer campo, lo parseamos.
-                    // Se aceptan "0" o "1". Cualquier otra cosa se trata como error o se ignora.
-                    if (!segment.empty()) {
-                        active = (std::stoi(segment) != 0);
-                    }
-                }
+                std::cerr << "Error parsing MIDI preset line: '" << line << "'. Reason: Invalid number" << std::endl;
+                continue; // Saltar línea problemática
+            }
 
-                if (cc_number >= 0 && cc_number <= 127 && value >= 0 && value <= 127)
-                {
-                    presetData[cc_number] = {value, active}; // Almacenar el struct
-                }
-                else
-                {
-                     std::cerr << "Warning: Invalid data in preset line, skipping: " << line << std::endl;
-                }
+            /// @version 2.8: Los CC 0-31 pueden ser controles de 14 bits y guardan el valor completo (0-16383).
+            const int max_value = (cc_number >= 0 && cc_number <= MidiMessage::HIGH_RESOLUTION_MAX_CC)
+                                      ? MidiMessage::HIGH_RESOLUTION_MAX_VALUE : 127;
+            if (cc_number >= 0 && cc_number <= 127 && value >= 0 && value <= max_value)
+            {
+                preset.set(cc_number, value, active != 0);
             }
-            catch(const std::exception& e)
+            else
             {
-                std::cerr << "Error parsing MIDI preset line: '" << line << "'. Reason: " << e.what() << std::endl;
-                continue; // Saltar línea problemática
+                 std::cerr << "Warning: Invalid data in preset line, skipping: " << line << std::endl;
             }
         }
-        file.close();
         return true;
     }
 
-    bool save(const std::string& filename, const std::vector<std::unique_ptr<IMidiControl>>& controls)
+    bool save(const std::string& filename, const ParameterStore& store)
     {
         std::ofstream file(filename);
         if (!file.is_open())
@@ -93,13 +87,41 @@ namespace MidiPresetParser
         //  @version 0.6: Escribir nueva cabecera
         file << "CC#;Value;Active\n";
 
-        // Escribir datos de cada control
-        for (const auto& control : controls)
+        // Escribir datos de cada parámetro
+        /// @version 1.4: Bucle directo sobre el almacén, sin llamadas virtuales a los widgets.
+        for (std::size_t i = 0; i < store.size(); ++i)
         {
+            /// @version 2.9: Los NRPN/RPN no tienen CC# y no se guardan en el preset.
+            if (store.getCc(i) < 0)
+            {
+                continue;
+            }
             //  @version 0.6: Guardar el estado de activación
-            file << control->getCcNumber() << ";"
-                 << control->getCurrentValue() << ";"
-                 << (control->isActive() ? "1" : "0") << "\n";
+            file << store.getCc(i) << ";"
+                 << store.getValue(i) << ";"
+                 << (store.isActive(i) ? "1" : "0") << "\n";
+        }
+
+        file.close();
+        return true;
+    }
+
+    bool save(const std::string& filename, const PresetImage& preset)
+    {
+        std::ofstream file(filename);
+        if (!file.is_open())
+        {
+            std::cerr << "Error: Could not create/open MIDI preset file for writing: " << filename << std::endl;
+            return false;
+        }
+
+        file << "CC#;Value;Active\n";
+        for (int cc = 0; cc < static_cast<int>(PresetImage::CONTROLLERS); ++cc)
+        {
+            if (preset.has(cc))
+            {
+                file << cc << ";" << preset.value(cc) << ";" << (preset.isActive(cc) ? "1" : "0") << "\n";
+            }
         }
 
         file.close();
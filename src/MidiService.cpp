@@ -7,10 +7,25 @@
  */
 #include "MidiService.hpp"
 #include <iostream>
-#include <vector>
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+
+namespace
+{
+    /** @brief Instante actual en nanosegundos de steady_clock (misma escala que MidiInputEvent). */
+    std::int64_t steadyNowNs()
+    {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+}
 
 MidiService::MidiService() 
 {
+    clearShadow(); /// @version 1.3: El estado del dispositivo empieza desconocido.
+    m_pendingParameters.reserve(PARAMETER_CAPACITY); /// @version 2.9: El hilo de salida no reserva memoria.
+
     try
     {
         m_midiOut = std::make_unique<RtMidiOut>();
@@ -21,23 +36,44 @@ MidiService::MidiService()
         std::cerr << "RtMidi Initialization Error: " << m_errorString << std::endl;
         m_midiOut = nullptr; // Asegurarse de que el puntero es nulo en caso de error.
     }
+
+    /// @version 0.9: El hilo de salida solo tiene sentido si RtMidi pudo inicializarse.
+    if (m_midiOut)
+    {
+        m_running = true;
+        m_outputThread = std::thread(&MidiService::outputLoop, this);
+    }
 }
 
 MidiService::~MidiService()
 {
+    /// @version 0.9: Detener el hilo de salida antes de cerrar el puerto.
+    if (m_outputThread.joinable())
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_wakeMutex);
+            m_running = false;
+        }
+        m_wakeCondition.notify_one();
+        m_outputThread.join();
+    }
     closePort();
 }
 
 bool MidiService::openPort(unsigned int portNumber)
 {
-    if (!m_midiOut || isPortOpen() || portNumber >= m_midiOut->getPortCount())
+    if (!m_midiOut || isPortOpen() || portNumber >= getPortCount())
     {
         return false;
     }
     try
     {
+        std::lock_guard<std::mutex> lock(m_portMutex);
         m_midiOut->openPort(portNumber);
-        return true;
+        m_resetCoalescer = true; /// @version 1.0: El nuevo dispositivo tiene un estado desconocido.
+        clearShadow();           /// @version 1.3: Lo mismo para el shadow del lado de la GUI.
+        m_portOpen = m_midiOut->isPortOpen();
+        return m_portOpen;
     }
     catch (const RtMidiError& error)
     {
@@ -48,20 +84,24 @@ bool MidiService::openPort(unsigned int portNumber)
 
 void MidiService::closePort()
 {
+    std::lock_guard<std::mutex> lock(m_portMutex);
     if (m_midiOut && m_midiOut->isPortOpen())
     {
         m_midiOut->closePort();
     }
+    m_portOpen = false;
 }
 
 bool MidiService::isPortOpen() const
 {
-    return m_midiOut && m_midiOut->isPortOpen();
+    return m_portOpen.load(std::memory_order_acquire);
 }
 
 unsigned int MidiService::getPortCount() const
 {
-    return m_midiOut ? m_midiOut->getPortCount() : 0;
+    if (!m_midiOut) return 0;
+    std::lock_guard<std::mutex> lock(m_portMutex); // El handle de ALSA se comparte con el hilo de salida.
+    return m_midiOut->getPortCount();
 }
 
 std::string MidiService::getPortName(unsigned int portNumber) const
@@ -70,28 +110,564 @@ std::string MidiService::getPortName(unsigned int portNumber) const
     {
         return "";
     }
+    std::lock_guard<std::mutex> lock(m_portMutex);
     return m_midiOut->getPortName(portNumber);
 }
 
 void MidiService::sendCcMessage(unsigned char channel, unsigned char cc, unsigned char value)
+{
+    /// @version 0.8: El mensaje se arma en la pila, ya no se usa un std::vector por envío.
+    sendMessage(MidiMessage::controlChange(channel, cc, value));
+}
+
+void MidiService::sendMessage(const MidiMessage& message, bool force)
 {
     if (!isPortOpen())
     {
         return; // No intentar enviar si el puerto no está abierto.
     }
-    std::vector<unsigned char> message;
-    // Construir el mensaje de Control Change
-    message.push_back(0xB0 | channel); // Status byte for Control Change
-    message.push_back(cc);             // CC number
-    message.push_back(value);          // CC value
 
+    /// @version 0.9: El hilo de FLTK solo encola; nunca espera al secuenciador.
+    if (!m_outputQueues[static_cast<std::size_t>(Producer::Gui)].tryPush({message, force}))
+    {
+        m_droppedCount.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    updateShadow(message, steadyNowNs());
+    wakeOutputThread();
+}
+
+void MidiService::sendBatch(const MidiMessage* messages, std::size_t count, bool force, Producer producer)
+{
+    if (!isPortOpen() || count == 0)
+    {
+        return;
+    }
+
+    auto& queue = m_outputQueues[static_cast<std::size_t>(producer)];
+    // Solo el productor agrega: lo que entra ahora es lo que va a entrar en tryPushBulk().
+    const std::size_t fits = std::min(count, queue.freeSpace());
+    const std::size_t pushed = queue.tryPushBulk(fits, [messages, fits, force](std::size_t i)
+    {
+        /// @version 2.8: El hilo de salida junta el MSB con su LSB (los dos se publican a la vez).
+        /// Un MSB cuyo LSB quedó fuera de la cola no se marca: sale solo.
+        const bool paired = i + 1 < fits && MidiMessage::isHighResolutionPair(messages[i], messages[i + 1]);
+        return OutputEvent{messages[i], force, false, paired};
+    });
+    if (pushed < count)
+    {
+        m_droppedCount.fetch_add(count - pushed, std::memory_order_relaxed);
+    }
+    const std::int64_t now = steadyNowNs(); /// @version 2.3: Una lectura del reloj por lote.
+    for (std::size_t i = 0; i < pushed; ++i)
+    {
+        updateShadow(messages[i], now);
+    }
+    wakeOutputThread();
+}
+
+void MidiService::sendParameters(const NrpnMessage* messages, std::size_t count, Producer producer)
+{
+    if (!isPortOpen() || count == 0)
+    {
+        return;
+    }
+
+    auto& queue = m_outputQueues[static_cast<std::size_t>(producer)];
+    const std::size_t pushed = queue.tryPushBulk(count, [messages](std::size_t i)
+    {
+        return OutputEvent{MidiMessage{}, true, false, false, true, messages[i]};
+    });
+    if (pushed < count)
+    {
+        m_droppedCount.fetch_add(count - pushed, std::memory_order_relaxed);
+    }
+    wakeOutputThread();
+}
+
+bool MidiService::isValidSysEx(const unsigned char* data, std::size_t size)
+{
+    bool inMessage = false;
+    for (std::size_t i = 0; i < size; ++i)
+    {
+        const unsigned char byte = data[i];
+        if (byte == 0xF0 && !inMessage)
+        {
+            inMessage = true;
+        }
+        else if (byte == 0xF7 && inMessage)
+        {
+            inMessage = false;
+        }
+        else if (!inMessage || byte >= 0x80)
+        {
+            return false; // Datos fuera de un mensaje, o un byte de estado dentro.
+        }
+    }
+    return size > 0 && !inMessage;
+}
+
+bool MidiService::sendSysEx(std::shared_ptr<const unsigned char> data, std::size_t size)
+{
+    if (!isPortOpen() || !data || !isValidSysEx(data.get(), size))
+    {
+        return false;
+    }
+    {
+        std::lock_guard<std::mutex> lock(m_sysExMutex);
+        m_sysExJobs.push_back({std::move(data), size, 0});
+        m_sysExBusy.store(true, std::memory_order_release);
+    }
+    wakeOutputThread();
+    return true;
+}
+
+void MidiService::cancelSysEx()
+{
+    std::lock_guard<std::mutex> lock(m_sysExMutex);
+    m_sysExJobs.clear();
+    m_sysExCancel.store(true, std::memory_order_release); // El volcado en curso lo corta el hilo de salida.
+}
+
+void MidiService::setSysExChunking(std::size_t chunkBytes, std::chrono::milliseconds delay)
+{
+    m_sysExChunkBytes.store(std::max<std::size_t>(chunkBytes, 1), std::memory_order_relaxed);
+    m_sysExChunkDelayMs.store(static_cast<unsigned int>(std::max<long long>(delay.count(), 0)), std::memory_order_relaxed);
+}
+
+bool MidiService::sendThru(const MidiMessage& message)
+{
+    if (!isPortOpen() || message.size() == 0)
+    {
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(m_portMutex);
+    if (!m_midiOut || !m_midiOut->isPortOpen())
+    {
+        return false; // Se cerró entre la comprobación y el bloqueo.
+    }
+    /// @version 3.0: Dentro de un SysEx solo pueden ir mensajes de tiempo real.
+    if (m_sysExStreaming.load(std::memory_order_relaxed) && message.status() < 0xF8)
+    {
+        return false;
+    }
     try
     {
-        m_midiOut->sendMessage(&message);
+        m_midiOut->sendMessage(message.data(), message.size());
+
+        /// @version 2.9: CC 98-101 (dirección NRPN/RPN): el dispositivo cambió de parámetro seleccionado.
+        if (message.size() == 3 && (message.status() & 0xF0) == 0xB0 && message.bytes[1] >= 98 && message.bytes[1] <= 101)
+        {
+            m_thruSelectionChanged.fetch_or(1u << (message.status() & 0x0F), std::memory_order_release);
+        }
+        return true;
+    }
+    catch (const RtMidiError& error)
+    {
+        std::cerr << "Error sending MIDI thru message: " << error.getMessage() << std::endl;
+        return false;
+    }
+}
+
+std::vector<MidiMessage> MidiService::filterChanged(const MidiMessage* messages, std::size_t count) const
+{
+    std::vector<MidiMessage> changed;
+    changed.reserve(count);
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        const MidiMessage& message = messages[i];
+        const bool isCc = message.size() == 3 && (message.status() & 0xF0) == 0xB0;
+        if (!isCc || getLastSentValue(message.status() & 0x0F, message.bytes[1]) != message.bytes[2])
+        {
+            changed.push_back(message);
+
+            /// @version 2.8: El receptor pone el LSB en 0 al recibir el MSB: el LSB va aunque no cambie.
+            if (i + 1 < count && MidiMessage::isHighResolutionPair(message, messages[i + 1]))
+            {
+                changed.push_back(messages[++i]);
+            }
+        }
+    }
+    return changed;
+}
+
+void MidiService::updateShadow(const MidiMessage& message, std::int64_t nowNs)
+{
+    if (message.size() == 3 && (message.status() & 0xF0) == 0xB0)
+    {
+        const std::size_t key = (message.status() & 0x0F) * 128 + message.bytes[1];
+        m_shadow[key].store(message.bytes[2], std::memory_order_relaxed);
+        m_shadowTime[key].store(nowNs, std::memory_order_relaxed);
+    }
+}
+
+void MidiService::noteReceived(const MidiMessage& message)
+{
+    if (message.size() != 3 || (message.status() & 0xF0) != 0xB0)
+    {
+        return;
+    }
+    m_shadow[(message.status() & 0x0F) * 128 + message.bytes[1]].store(message.bytes[2], std::memory_order_relaxed);
+
+    // El hilo de salida lo procesará junto con el próximo envío; no hace falta despertarlo.
+    // Si la cola está llena no pasa nada grave: a lo sumo se reenvía un valor repetido.
+    if (isPortOpen())
+    {
+        m_outputQueues[static_cast<std::size_t>(Producer::Gui)].tryPush({message, false, true});
+    }
+}
+
+void MidiService::clearShadow()
+{
+    for (auto& value : m_shadow)
+    {
+        value.store(-1, std::memory_order_relaxed);
+    }
+    for (auto& time : m_shadowTime)
+    {
+        time.store(0, std::memory_order_relaxed);
+    }
+}
+
+bool MidiService::queuesEmpty() const
+{
+    for (const auto& queue : m_outputQueues)
+    {
+        if (!queue.empty())
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+std::size_t MidiService::getQueueDepth() const
+{
+    std::size_t depth = 0;
+    for (const auto& queue : m_outputQueues)
+    {
+        depth += queue.size();
+    }
+    return depth;
+}
+
+MidiService::TransmitStats MidiService::getTransmitStats() const
+{
+    return {m_transmitCalls.load(std::memory_order_relaxed),
+            m_transmitBytes.load(std::memory_order_relaxed),
+            std::chrono::nanoseconds(m_transmitNanos.load(std::memory_order_relaxed))};
+}
+
+void MidiService::wakeOutputThread()
+{
+    // Solo se toca el mutex si el hilo de salida está dormido (ver outputLoop()).
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (m_outputSleeping.load(std::memory_order_relaxed))
+    {
+        std::lock_guard<std::mutex> lock(m_wakeMutex);
+        m_wakeCondition.notify_one();
+    }
+}
+
+std::chrono::microseconds MidiService::estimateTransmitTime(const MidiMessage* messages, std::size_t count) const
+{
+    return OutputScheduler::estimateDuration(OutputScheduler::estimateBytes(messages, count), count,
+                                             getByteRate(), getMaxMessagesPerMs());
+}
+
+void MidiService::queueParameter(const NrpnMessage& message)
+{
+    for (std::size_t i = m_parameterHead; i < m_pendingParameters.size(); ++i)
+    {
+        if (m_pendingParameters[i].sameAddress(message))
+        {
+            m_pendingParameters[i] = message; // El valor nuevo conserva el turno del anterior.
+            return;
+        }
+    }
+    if (m_pendingParameters.size() == PARAMETER_CAPACITY && m_parameterHead > 0)
+    {
+        m_pendingParameters.erase(m_pendingParameters.begin(), m_pendingParameters.begin() + m_parameterHead);
+        m_parameterHead = 0;
+    }
+    if (m_pendingParameters.size() == PARAMETER_CAPACITY)
+    {
+        m_droppedCount.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    m_pendingParameters.push_back(message);
+}
+
+void MidiService::processOutputEvent(const OutputEvent& event, std::size_t& length)
+{
+    if (event.parameter)
+    {
+        queueParameter(event.nrpn); /// @version 2.9
+        return;
+    }
+    if (event.received)
+    {
+        m_coalescer.noteDeviceValue(event.message); /// @version 2.3
+        return;
+    }
+    if (!m_coalescer.push(event.message, event.force))
+    {
+        length += m_scheduler.encode(event.message, m_burstBuffer.data() + length);
+    }
+}
+
+std::size_t MidiService::nextSysExChunk(const SysExJob& job) const
+{
+    const unsigned char* data = job.data.get();
+    const std::size_t position = job.offset;
+    const std::size_t limit = std::max(m_sysExChunkBytes.load(std::memory_order_relaxed), m_encoderSize);
+
+    if (data[position] == 0xF0)
+    {
+        // Al comienzo de un mensaje: tantos mensajes enteros como entren en la parte.
+        std::size_t end = position;
+        while (end < job.size)
+        {
+            const auto* f7 = static_cast<const unsigned char*>(std::memchr(data + end, 0xF7, job.size - end));
+            const std::size_t messageEnd = static_cast<std::size_t>(f7 - data) + 1;
+            if (messageEnd - position > limit)
+            {
+                break;
+            }
+            end = messageEnd;
+        }
+        // Si el primero no entra entero, sus primeros bytes: RtMidi agranda su codificador a ese
+        // tamaño (al comienzo del mensaje, así que no pierde nada) y emite el evento al llenarse.
+        return end > position ? end - position : limit;
+    }
+
+    // A mitad de un mensaje el codificador ya mide al menos una parte: hasta llenarlo, o hasta el F7.
+    const auto* f7 = static_cast<const unsigned char*>(std::memchr(data + position, 0xF7, job.size - position));
+    return std::min(static_cast<std::size_t>(f7 - data) + 1 - position, m_encoderSize);
+}
+
+bool MidiService::streamSysEx()
+{
+    if (!isPortOpen())
+    {
+        std::lock_guard<std::mutex> lock(m_sysExMutex);
+        m_sysExJobs.clear(); // Sin puerto no hay a quién enviarlos.
+        m_sysExCurrent = SysExJob{};
+        m_sysExStreaming.store(false, std::memory_order_relaxed);
+        m_sysExBusy.store(false, std::memory_order_release);
+        return false;
+    }
+
+    if (m_sysExCancel.exchange(false, std::memory_order_acq_rel) && m_sysExCurrent.data)
+    {
+        // Cortado a mitad de un mensaje: F7 lo cierra en el dispositivo (y en el codificador de RtMidi).
+        if (m_sysExCurrent.data.get()[m_sysExCurrent.offset - 1] != 0xF7)
+        {
+            const unsigned char end = 0xF7;
+            transmit(&end, 1);
+        }
+        m_sysExCurrent = SysExJob{};
+        m_sysExStreaming.store(false, std::memory_order_relaxed);
+    }
+
+    if (!m_sysExCurrent.data)
+    {
+        std::lock_guard<std::mutex> lock(m_sysExMutex);
+        if (m_sysExJobs.empty())
+        {
+            m_sysExBusy.store(false, std::memory_order_release);
+            return false;
+        }
+        m_sysExCurrent = std::move(m_sysExJobs.front());
+        m_sysExJobs.pop_front();
+        m_sysExStreaming.store(true, std::memory_order_relaxed); // transmit() toma m_portMutex después.
+    }
+
+    // La pausa también separa un volcado del siguiente.
+    const auto now = std::chrono::steady_clock::now();
+    if (now < m_sysExNextChunk)
+    {
+        std::this_thread::sleep_until(m_sysExNextChunk);
+        return true;
+    }
+
+    const std::size_t chunk = nextSysExChunk(m_sysExCurrent);
+    transmit(m_sysExCurrent.data.get() + m_sysExCurrent.offset, chunk);
+    m_sysExCurrent.offset += chunk;
+    m_sysExSentBytes.fetch_add(chunk, std::memory_order_relaxed);
+
+    // La próxima parte sale cuando esta terminó de pasar por el cable, más la pausa configurada.
+    m_sysExNextChunk = now + OutputScheduler::estimateDuration(chunk, 1, m_bytesPerSecond.load(std::memory_order_relaxed), 0) +
+                       std::chrono::milliseconds(m_sysExChunkDelayMs.load(std::memory_order_relaxed));
+    if (m_sysExCurrent.offset >= m_sysExCurrent.size)
+    {
+        m_sysExCurrent = SysExJob{};
+        m_sysExStreaming.store(false, std::memory_order_relaxed);
+    }
+    return true;
+}
+
+void MidiService::outputLoop()
+{
+    OutputEvent event;
+    OutputEvent lsb;
+    // Mensajes ya extraídos del coalescer que no entraron en la ráfaga anterior.
+    /// @version 2.8: Hasta dos (un par de 14 bits), que entran juntos o esperan juntos.
+    std::array<MidiMessage, CcCoalescer::MAX_POP> carry;
+    std::size_t carryCount = 0;
+
+    while (m_running.load(std::memory_order_acquire))
+    {
+        if (m_resetCoalescer.exchange(false))
+        {
+            m_coalescer.reset();
+            m_nrpnEncoder.reset(); /// @version 2.9
+        }
+
+        /// @version 2.9: Canales donde el thru cambió el parámetro seleccionado.
+        for (unsigned int changed = m_thruSelectionChanged.exchange(0, std::memory_order_acquire); changed != 0; changed &= changed - 1)
+        {
+            m_nrpnEncoder.invalidate(static_cast<unsigned char>(__builtin_ctz(changed)));
+        }
+
+        /// @version 3.0: Un SysEx tiene el puerto para él solo. Arranca cuando no quedan CC ni
+        /// NRPN pendientes; mientras dura, las colas esperan.
+        const bool idle = carryCount == 0 && !m_coalescer.hasPending() && m_parameterHead == m_pendingParameters.size();
+        if ((m_sysExCurrent.data || (idle && m_sysExBusy.load(std::memory_order_acquire))) && streamSysEx())
+        {
+            continue;
+        }
+
+        /// @version 1.1: Aplicar los límites pedidos desde la GUI y abrir una ráfaga nueva.
+        m_scheduler.setByteRate(m_bytesPerSecond.load(std::memory_order_relaxed));
+        m_scheduler.setMaxMessagesPerMs(m_maxMessagesPerMs.load(std::memory_order_relaxed));
+        m_scheduler.beginBurst(std::chrono::steady_clock::now());
+        std::size_t length = 0;
+
+        // 1. Vaciar las colas en la etapa de coalescencia. Lo que no es CC entra directo en la ráfaga.
+        //    Se acota a la capacidad de cada cola para que un productor rápido no lo vuelva infinito.
+        for (auto& queue : m_outputQueues)
+        {
+            for (std::size_t i = 0; i < OUTPUT_QUEUE_CAPACITY && queue.tryPop(event); ++i)
+            {
+                /// @version 2.8: El LSB se publicó con su MSB. Si lo que sigue no es su LSB (no debería
+                /// pasar, ver sendBatch()), el MSB sale solo y el evento desencolado se procesa normalmente.
+                bool paired = false;
+                while (event.pairedWithNext && queue.tryPop(lsb))
+                {
+                    ++i;
+                    if (!lsb.received && !lsb.parameter && MidiMessage::isHighResolutionPair(event.message, lsb.message))
+                    {
+                        m_coalescer.pushPair(event.message, lsb.message, event.force);
+                        paired = true;
+                        break;
+                    }
+                    processOutputEvent(event, length);
+                    event = lsb;
+                }
+                if (!paired)
+                {
+                    processOutputEvent(event, length);
+                }
+            }
+        }
+
+        // 2. @version 2.9: Los NRPN/RPN pendientes, en orden de llegada, mientras haya crédito.
+        //    Cada uno sale entero: el primer CC puede llevar su estado, el resto va con running status.
+        while (m_parameterHead < m_pendingParameters.size())
+        {
+            const NrpnMessage& parameter = m_pendingParameters[m_parameterHead];
+            if (!m_scheduler.canSend(MidiMessage::MAX_SIZE + 2 * (m_nrpnEncoder.messageCount(parameter) - 1)))
+            {
+                break;
+            }
+            MidiMessage encoded[NrpnEncoder::MAX_MESSAGES];
+            const std::size_t count = m_nrpnEncoder.encode(parameter, encoded);
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                length += m_scheduler.encode(encoded[i], m_burstBuffer.data() + length);
+                m_coalescer.noteDeviceValue(encoded[i]); // Un CC crudo 6/38/98-101 debe ver este valor.
+            }
+            ++m_parameterHead;
+        }
+        if (m_parameterHead == m_pendingParameters.size())
+        {
+            m_pendingParameters.clear();
+            m_parameterHead = 0;
+        }
+
+        // 3. Agregar los CC pendientes mientras haya crédito en el planificador.
+        while (carryCount > 0 || (carryCount = m_coalescer.pop(carry.data())) > 0)
+        {
+            // Los dos mensajes de un par comparten el byte de estado: el segundo va con running status.
+            const std::size_t bytes = m_scheduler.encodedSize(carry[0]) + (carryCount > 1 ? carry[1].size() - 1 : 0);
+            if (!m_scheduler.canSend(bytes))
+            {
+                break;
+            }
+            for (std::size_t i = 0; i < carryCount; ++i)
+            {
+                length += m_scheduler.encode(carry[i], m_burstBuffer.data() + length);
+                m_nrpnEncoder.observe(carry[i]); /// @version 2.9: Un CC 98-101 crudo cambia la selección.
+            }
+            carryCount = 0;
+        }
+
+        // 4. Una sola llamada a RtMidi (y un solo drain del secuenciador) por ráfaga.
+        if (length > 0)
+        {
+            transmit(m_burstBuffer.data(), length);
+        }
+
+        // 5. Si quedó trabajo, esperar una ventana completa; mientras tanto los valores nuevos se coalescen.
+        if (carryCount > 0 || m_coalescer.hasPending() || m_parameterHead < m_pendingParameters.size())
+        {
+            std::this_thread::sleep_until(m_scheduler.nextBurstTime());
+            continue;
+        }
+        if (!queuesEmpty())
+        {
+            continue;
+        }
+
+        // Cola vacía: dormir hasta que el productor avise. Se marca m_outputSleeping antes
+        // de volver a mirar la cola, así el productor nunca deja un aviso sin entregar.
+        std::unique_lock<std::mutex> lock(m_wakeMutex);
+        m_outputSleeping = true;
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        m_wakeCondition.wait_for(lock, std::chrono::milliseconds(100), [this]
+        {
+            return !m_running.load(std::memory_order_relaxed) || !queuesEmpty() || m_sysExBusy.load(std::memory_order_acquire);
+        });
+        m_outputSleeping = false;
+    }
+}
+
+void MidiService::transmit(const unsigned char* bytes, std::size_t size)
+{
+    std::lock_guard<std::mutex> lock(m_portMutex);
+    if (!m_midiOut || !m_midiOut->isPortOpen())
+    {
+        return; // El puerto se cerró mientras los mensajes esperaban en la cola.
+    }
+
+    try
+    {
+        // El backend ALSA de RtMidi recorre el buffer evento por evento (acepta running status)
+        // y drena el secuenciador una sola vez al final.
+        const auto start = std::chrono::steady_clock::now();
+        m_midiOut->sendMessage(bytes, size);
+        m_encoderSize = std::max(m_encoderSize, size); /// @version 3.0: RtMidi agranda su buffer a lo que recibe.
+        const auto busy = std::chrono::steady_clock::now() - start;
+
+        m_transmitCalls.fetch_add(1, std::memory_order_relaxed);
+        m_transmitBytes.fetch_add(size, std::memory_order_relaxed);
+        m_transmitNanos.fetch_add(std::chrono::duration_cast<std::chrono::nanoseconds>(busy).count(), std::memory_order_relaxed);
     }
     catch (const RtMidiError& error)
     {
         // En una aplicación real, esto podría ir a un sistema de logging más sofisticado.
         std::cerr << "Error sending MIDI message: " << error.getMessage() << std::endl;
     }
-}
\ No newline at end of file
+}
@@ -0,0 +1,74 @@
+/**
+ * @file MidiSessionParser.cpp
+ * @author Gabriel Nicolás González Ferreira (gabrielinuz@fi.mdp.edu.ar)
+ * @brief Implementación del parser y guardador de archivos de sesión.
+ * @version 2.6
+ * @date 2026-10-16
+ */
+#include "MidiSessionParser.hpp"
+#include "MappedFile.hpp"
+#include "Utils.hpp"
+#include <fstream>
+#include <iostream>
+
+namespace MidiSessionParser
+{
+    bool load(const std::string& filename, std::vector<SessionDevice>& devices)
+    {
+        MappedFile file(filename);
+        if (!file.isOpen())
+        {
+            std::cerr << "Error: Could not open MIDI session file: " << filename << std::endl;
+            return false;
+        }
+        devices.clear();
+        parseBuffer(file.view(), Utils::getDirectoryFromPath(filename), devices);
+        return true;
+    }
+
+    void parseBuffer(std::string_view content, const std::string& baseDirectory, std::vector<SessionDevice>& devices)
+    {
+        Utils::nextLine(content); // Cabecera
+
+        while (!content.empty())
+        {
+            const std::string_view line = Utils::nextLine(content);
+            if (line.empty()) continue;
+
+            std::string_view rest = line;
+            int channel = 0;
+            if (!Utils::parseInt(Utils::nextField(rest, ';'), channel) || channel < 1 || channel > 16)
+            {
+                std::cerr << "Warning: Invalid channel in MIDI session line, skipping: " << line << std::endl;
+                continue;
+            }
+
+            SessionDevice device;
+            device.channel = channel - 1;
+            device.port_name = std::string(Utils::nextField(rest, ';'));
+            device.layout_path = std::string(rest); // El resto de la línea, aunque tenga ';'.
+            if (!device.layout_path.empty() && device.layout_path.front() != '/')
+            {
+                device.layout_path = baseDirectory + "/" + device.layout_path;
+            }
+            devices.push_back(std::move(device));
+        }
+    }
+
+    bool save(const std::string& filename, const std::vector<SessionDevice>& devices)
+    {
+        std::ofstream file(filename);
+        if (!file.is_open())
+        {
+            std::cerr << "Error: Could not create/open MIDI session file for writing: " << filename << std::endl;
+            return false;
+        }
+        file << "Channel;Port;Layout\n";
+        for (const auto& device : devices)
+        {
+            file << (device.channel + 1) << ";" << device.port_name << ";" << device.layout_path << "\n";
+        }
+        return static_cast<bool>(file);
+    }
+
+} // namespace MidiSessionParser
@@ -0,0 +1,35 @@
+/**
+ * @file MidiThruRouter.cpp
+ * @author Gabriel Nicolás González Ferreira (gabrielinuz@fi.mdp.edu.ar)
+ * @brief Implementación del reenvío MIDI thru y de su medición de latencia.
+ * @version 2.5
+ * @date 2026-10-16
+ */
+#include "MidiThruRouter.hpp"
+#include <chrono>
+
+MidiThruRouter::MidiThruRouter(std::shared_ptr<MidiService> output)
+    : m_output(output)
+{}
+
+void MidiThruRouter::forward_static(const MidiInputEvent& event, void* userdata)
+{
+    static_cast<MidiThruRouter*>(userdata)->forward(event);
+}
+
+void MidiThruRouter::forward(const MidiInputEvent& event)
+{
+    if (!isEnabled() || !m_output)
+    {
+        return;
+    }
+    if (!m_output->sendThru(event.message))
+    {
+        m_skippedCount.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    const std::int64_t now = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+    m_latency.record(now - event.timestampNs);
+    m_forwardedCount.fetch_add(1, std::memory_order_relaxed);
+}
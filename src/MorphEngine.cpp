@@ -0,0 +1,211 @@
+/**
+ * @file MorphEngine.cpp
+ * @author Gabriel Nicolás González Ferreira (gabrielinuz@fi.mdp.edu.ar)
+ * @brief Implementación del motor de transiciones entre presets.
+ * @version 2.8
+ * @date 2026-10-16
+ */
+#include "MorphEngine.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+    /// Pendiente de la curva exponencial: e^(K·t) normalizada a [0, 1].
+    constexpr double EXPONENTIAL_SLOPE = 4.0;
+}
+
+MorphEngine::MorphEngine(std::shared_ptr<MidiService> midiService, unsigned int tickRate)
+    : m_midiService(midiService),
+      m_tickPeriod(std::chrono::duration_cast<Clock::duration>(std::chrono::seconds(1)) / (tickRate ? tickRate : DEFAULT_TICK_RATE))
+{
+    for (auto& value : m_currentValues)
+    {
+        value.store(0, std::memory_order_relaxed);
+    }
+    m_thread = std::thread(&MorphEngine::run, this);
+}
+
+MorphEngine::~MorphEngine()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_quit = true;
+    }
+    m_condition.notify_one();
+    m_thread.join();
+}
+
+void MorphEngine::start(const PresetImage& from, const PresetImage& to, const ChannelMap& channels,
+                        std::chrono::milliseconds duration, Curve curve)
+{
+    Job job;
+    job.channels = channels;
+    job.duration = duration;
+    job.curve = curve;
+    for (int cc = 0; cc < static_cast<int>(PresetImage::CONTROLLERS); ++cc)
+    {
+        if (!to.has(cc) || !to.isActive(cc))
+        {
+            continue; // Los CC inactivos no se envían, igual que en un recall normal.
+        }
+        const std::uint16_t target = static_cast<std::uint16_t>(to.value(cc));
+        const std::uint16_t origin = from.has(cc) ? static_cast<std::uint16_t>(from.value(cc)) : target;
+        job.ccs[job.count++] = static_cast<unsigned char>(cc);
+        job.from[cc] = origin;
+        job.to[cc] = target;
+        job.highResolution[cc] = to.isHighResolution(cc); /// @version 2.8
+        job.known[cc] = from.has(cc) ? origin : -1; // Desconocido: se envía en el primer tick.
+        m_currentValues[cc].store(origin, std::memory_order_relaxed);
+    }
+    m_target = to;
+
+    /// @version 2.7: Los ticks salen agrupados por canal (y por CC# dentro de cada canal).
+    std::stable_sort(job.ccs.begin(), job.ccs.begin() + job.count, [&channels](unsigned char a, unsigned char b)
+    {
+        return channels[a] < channels[b];
+    });
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        job.start = Clock::now();
+        m_job = job;
+        m_hasJob = true;
+        ++m_generation;
+        m_running.store(true, std::memory_order_release);
+    }
+    m_condition.notify_one();
+}
+
+void MorphEngine::stop()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_hasJob = false;
+        ++m_generation;
+        m_running.store(false, std::memory_order_release);
+    }
+    m_condition.notify_one();
+}
+
+PresetImage MorphEngine::getCurrent() const
+{
+    PresetImage current = m_target;
+    for (int cc = 0; cc < static_cast<int>(PresetImage::CONTROLLERS); ++cc)
+    {
+        if (current.has(cc) && current.isActive(cc))
+        {
+            current.set(cc, m_currentValues[cc].load(std::memory_order_relaxed), true);
+        }
+    }
+    return current;
+}
+
+double MorphEngine::shape(Curve curve, double t)
+{
+    if (t <= 0.0) return 0.0;
+    if (t >= 1.0) return 1.0;
+    switch (curve)
+    {
+        case Curve::Exponential:
+            return std::expm1(EXPONENTIAL_SLOPE * t) / std::expm1(EXPONENTIAL_SLOPE);
+        case Curve::Linear:
+        default:
+            return t;
+    }
+}
+
+void MorphEngine::run()
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    unsigned long seen = m_generation;
+    const auto interrupted = [this, &seen] { return m_quit || m_generation != seen; };
+
+    while (true)
+    {
+        m_condition.wait(lock, interrupted);
+        if (m_quit)
+        {
+            return;
+        }
+        seen = m_generation;
+        if (!m_hasJob)
+        {
+            continue; // stop(): no hay nada que hacer.
+        }
+
+        const Job job = m_job;
+        std::array<short, PresetImage::CONTROLLERS> last;
+        for (std::size_t i = 0; i < job.count; ++i)
+        {
+            last[job.ccs[i]] = job.known[job.ccs[i]]; // El dispositivo ya tiene el valor de partida.
+        }
+
+        // Ticks a intervalos fijos desde el inicio, sin acumular el retraso de cada envío.
+        Clock::time_point next = job.start;
+        while (true)
+        {
+            lock.unlock();
+            const bool finished = tick(job, Clock::now(), last);
+            lock.lock();
+            if (finished)
+            {
+                if (m_generation == seen)
+                {
+                    m_running.store(false, std::memory_order_release);
+                }
+                break;
+            }
+            next += m_tickPeriod;
+            const Clock::time_point now = Clock::now();
+            while (next < now)
+            {
+                next += m_tickPeriod; // Si un tick se atrasó, no se recuperan los perdidos de golpe.
+            }
+            if (m_condition.wait_until(lock, next, interrupted))
+            {
+                break; // Reemplazada por otro start(), cancelada o cerrando.
+            }
+        }
+    }
+}
+
+bool MorphEngine::tick(const Job& job, Clock::time_point now, std::array<short, PresetImage::CONTROLLERS>& last)
+{
+    double t = 1.0;
+    if (job.duration > Clock::duration::zero())
+    {
+        t = std::chrono::duration<double>(now - job.start) / std::chrono::duration<double>(job.duration);
+    }
+    const double progress = shape(job.curve, t);
+
+    std::array<MidiMessage, 2 * PresetImage::CONTROLLERS> batch; /// @version 2.8: Hasta un par por CC#.
+    std::size_t count = 0;
+    for (std::size_t i = 0; i < job.count; ++i)
+    {
+        const unsigned char cc = job.ccs[i];
+        const double from = job.from[cc];
+        const int value = static_cast<int>(std::lround(from + (job.to[cc] - from) * progress));
+        if (value != last[cc])
+        {
+            // Solo se emiten los CC cuyo valor entero cambió desde el tick anterior.
+            last[cc] = static_cast<short>(value);
+            m_currentValues[cc].store(static_cast<std::uint16_t>(value), std::memory_order_relaxed);
+            if (job.highResolution[cc])
+            {
+                count += MidiMessage::controlChange14(job.channels[cc], cc, static_cast<unsigned int>(value), &batch[count]);
+            }
+            else
+            {
+                batch[count++] = MidiMessage::controlChange(job.channels[cc], cc, static_cast<unsigned char>(value));
+            }
+        }
+    }
+
+    if (count > 0 && m_midiService)
+    {
+        m_midiService->sendBatch(batch.data(), count, false, MidiService::Producer::Engine);
+        m_emittedCount.fetch_add(count, std::memory_order_relaxed);
+    }
+    return t >= 1.0;
+}
@@ -0,0 +1,64 @@
+/**
+ * @file NrpnEncoder.cpp
+ * @author Gabriel Nicolás González Ferreira (gabrielinuz@fi.mdp.edu.ar)
+ * @brief Implementación de la codificación NRPN/RPN con la dirección seleccionada por canal.
+ * @version 2.9
+ * @date 2026-10-16
+ */
+#include "NrpnEncoder.hpp"
+
+namespace
+{
+    // Números de CC de la especificación MIDI 1.0.
+    constexpr unsigned char DATA_ENTRY_MSB = 6;
+    constexpr unsigned char DATA_ENTRY_LSB = 38;
+    constexpr unsigned char NRPN_LSB = 98;
+    constexpr unsigned char NRPN_MSB = 99;
+    constexpr unsigned char RPN_LSB = 100;
+    constexpr unsigned char RPN_MSB = 101;
+}
+
+std::size_t NrpnEncoder::encode(const NrpnMessage& message, MidiMessage* out)
+{
+    const unsigned char channel = message.channel & 0x0F;
+    std::size_t count = 0;
+    if (m_selected[channel] != addressOf(message))
+    {
+        // Dirección: MSB y después LSB, como la esperan todos los receptores.
+        out[count++] = MidiMessage::controlChange(channel, message.registered ? RPN_MSB : NRPN_MSB,
+                                                  static_cast<unsigned char>(message.number >> 7));
+        out[count++] = MidiMessage::controlChange(channel, message.registered ? RPN_LSB : NRPN_LSB,
+                                                  static_cast<unsigned char>(message.number));
+        m_selected[channel] = addressOf(message);
+    }
+    else
+    {
+        m_omittedCount.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    if (message.highResolution)
+    {
+        out[count++] = MidiMessage::controlChange(channel, DATA_ENTRY_MSB, static_cast<unsigned char>(message.value >> 7));
+        out[count++] = MidiMessage::controlChange(channel, DATA_ENTRY_LSB, static_cast<unsigned char>(message.value));
+    }
+    else
+    {
+        out[count++] = MidiMessage::controlChange(channel, DATA_ENTRY_MSB, static_cast<unsigned char>(message.value));
+    }
+    return count;
+}
+
+std::size_t NrpnEncoder::messageCount(const NrpnMessage& message) const
+{
+    const std::size_t address = m_selected[message.channel & 0x0F] == addressOf(message) ? 0 : 2;
+    return address + (message.highResolution ? 2 : 1);
+}
+
+void NrpnEncoder::observe(const MidiMessage& message)
+{
+    if (message.size() == 3 && (message.status() & 0xF0) == 0xB0 &&
+        message.bytes[1] >= NRPN_LSB && message.bytes[1] <= RPN_MSB)
+    {
+        invalidate(message.status() & 0x0F);
+    }
+}
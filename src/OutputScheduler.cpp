@@ -0,0 +1,124 @@
+/**
+ * @file OutputScheduler.cpp
+ * @author Gabriel Nicolás González Ferreira (gabrielinuz@fi.mdp.edu.ar)
+ * @brief Implementación del planificador de salida por tasa de bytes.
+ * @version 1.1
+ * @date 2026-10-16
+ */
+#include "OutputScheduler.hpp"
+#include <algorithm> // Para std::min, std::max y std::copy
+
+OutputScheduler::OutputScheduler(unsigned int bytesPerSecond, unsigned int messagesPerMs)
+    : m_bytesPerSecond(bytesPerSecond),
+      m_messagesPerMs(messagesPerMs),
+      m_byteCredit(0.0),
+      m_messageCredit(0.0),
+      m_lastRefill(Clock::now()),
+      m_runningStatus(0)
+{
+    m_byteCredit = byteCapacity();
+    m_messageCredit = messageCapacity();
+}
+
+void OutputScheduler::setByteRate(unsigned int bytesPerSecond)
+{
+    m_bytesPerSecond = bytesPerSecond;
+    m_byteCredit = std::min(m_byteCredit, byteCapacity());
+}
+
+void OutputScheduler::setMaxMessagesPerMs(unsigned int messagesPerMs)
+{
+    m_messagesPerMs = messagesPerMs;
+    m_messageCredit = std::min(m_messageCredit, messageCapacity());
+}
+
+void OutputScheduler::beginBurst(Clock::time_point now)
+{
+    const double elapsed = std::chrono::duration<double>(now - m_lastRefill).count();
+    m_byteCredit = std::min(m_byteCredit + elapsed * m_bytesPerSecond, byteCapacity());
+    m_messageCredit = std::min(m_messageCredit + elapsed * 1000.0 * m_messagesPerMs, messageCapacity());
+    m_lastRefill = now;
+    m_runningStatus = 0; // Cada ráfaga es un buffer nuevo para RtMidi: el primer mensaje lleva su estado.
+}
+
+std::size_t OutputScheduler::encodedSize(const MidiMessage& message) const
+{
+    const bool runningStatus = message.status() < 0xF0 && message.status() == m_runningStatus;
+    return runningStatus ? message.size() - 1 : message.size();
+}
+
+bool OutputScheduler::canSend(std::size_t bytes) const
+{
+    const bool bytesOk = m_bytesPerSecond == 0 || m_byteCredit >= static_cast<double>(bytes);
+    const bool messagesOk = m_messagesPerMs == 0 || m_messageCredit >= 1.0;
+    return bytesOk && messagesOk;
+}
+
+std::size_t OutputScheduler::encode(const MidiMessage& message, unsigned char* out)
+{
+    const std::size_t size = encodedSize(message);
+    const unsigned char* first = message.data() + (message.size() - size); // Saltea el estado si se repite.
+    std::copy(first, message.data() + message.size(), out);
+
+    // Los mensajes de sistema (0xF0-0xFF) no participan del running status y lo cancelan.
+    m_runningStatus = message.status() < 0xF0 ? message.status() : 0;
+    m_byteCredit -= static_cast<double>(size);
+    m_messageCredit -= 1.0;
+    return size;
+}
+
+OutputScheduler::Clock::time_point OutputScheduler::nextBurstTime() const
+{
+    double wait = 0.0; // Segundos hasta que ambos créditos estén completos.
+    if (m_bytesPerSecond > 0)
+    {
+        wait = std::max(wait, (byteCapacity() - m_byteCredit) / m_bytesPerSecond);
+    }
+    if (m_messagesPerMs > 0)
+    {
+        wait = std::max(wait, (messageCapacity() - m_messageCredit) / (1000.0 * m_messagesPerMs));
+    }
+    return m_lastRefill + std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(wait));
+}
+
+std::size_t OutputScheduler::estimateBytes(const MidiMessage* messages, std::size_t count)
+{
+    std::size_t bytes = 0;
+    unsigned char runningStatus = 0;
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        const unsigned char status = messages[i].status();
+        bytes += (status < 0xF0 && status == runningStatus) ? messages[i].size() - 1 : messages[i].size();
+        runningStatus = status < 0xF0 ? status : 0;
+    }
+    return bytes;
+}
+
+std::chrono::microseconds OutputScheduler::estimateDuration(std::size_t bytes, std::size_t messages,
+                                                            unsigned int bytesPerSecond, unsigned int messagesPerMs)
+{
+    long long micros = 0;
+    if (bytesPerSecond > 0)
+    {
+        micros = std::max(micros, static_cast<long long>(bytes) * 1000000LL / bytesPerSecond);
+    }
+    if (messagesPerMs > 0)
+    {
+        micros = std::max(micros, static_cast<long long>(messages) * 1000LL / messagesPerMs);
+    }
+    return std::chrono::microseconds(micros);
+}
+
+double OutputScheduler::byteCapacity() const
+{
+    const double window = std::chrono::duration<double>(BURST_WINDOW).count();
+    // @version 2.8: Nunca menos que un par de 14 bits (dos mensajes), que se transmite entero.
+    // @version 2.9: Ni que un NRPN completo (cuatro CC: dirección y dato de 14 bits).
+    return std::max(m_bytesPerSecond * window, static_cast<double>(4 * MidiMessage::MAX_SIZE));
+}
+
+double OutputScheduler::messageCapacity() const
+{
+    const double windowMs = std::chrono::duration<double, std::milli>(BURST_WINDOW).count();
+    return std::max(m_messagesPerMs * windowMs, 1.0);
+}
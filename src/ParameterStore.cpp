@@ -0,0 +1,176 @@
+/**
+ * @file ParameterStore.cpp
+ * @author Gabriel Nicolás González Ferreira (gabrielinuz@fi.mdp.edu.ar)
+ * @brief Implementación del almacén struct-of-arrays de parámetros MIDI.
+ * @version 2.9
+ * @date 2026-10-16
+ */
+#include "ParameterStore.hpp"
+
+std::size_t ParameterStore::add(const SliderConfig& config)
+{
+    /// @version 2.9: Los NRPN/RPN no tienen CC# y quedan fuera de las tablas por CC#.
+    const bool isCc = config.type == ParameterType::ControlChange;
+    m_cc.push_back(isCc ? static_cast<unsigned char>(config.cc_number) : NOT_A_CC);
+    m_type.push_back(config.type);
+    m_parameterNumber.push_back(isCc ? 0 : static_cast<std::uint16_t>(config.parameter_number));
+    m_parameterRows += isCc ? 0 : 1;
+    m_min.push_back(static_cast<std::uint16_t>(config.min_value));
+    m_max.push_back(static_cast<std::uint16_t>(config.max_value));
+    m_value.push_back(static_cast<std::uint16_t>(config.min_value));
+    m_active.push_back(1);
+    m_highResolution.push_back(config.high_resolution ? 1 : 0); /// @version 2.8
+    m_description.push_back(config.description);
+
+    /// @version 2.7: Canal propio opcional.
+    const bool hasChannel = config.channel >= 0 && config.channel <= 15;
+    m_channel.push_back(static_cast<signed char>(hasChannel ? config.channel : NO_CHANNEL));
+    m_channelOverrides += hasChannel ? 1 : 0;
+
+    const std::size_t row = m_cc.size() - 1;
+    if (!isCc)
+    {
+        m_nextRowSameCc.push_back(NO_ROW);
+        return row;
+    }
+    m_highResolutionByCc[m_cc[row]] = m_highResolution.back();
+    m_channelByCc[m_cc[row]] = m_channel.back();
+
+    /// @version 2.3: La fila nueva encabeza la cadena de su CC# (el orden no importa).
+    m_nextRowSameCc.push_back(m_firstRowByCc[m_cc[row] & 0x7F]);
+    m_firstRowByCc[m_cc[row] & 0x7F] = static_cast<int>(row);
+    return row;
+}
+
+void ParameterStore::clear()
+{
+    m_cc.clear();
+    m_type.clear();
+    m_parameterNumber.clear();
+    m_parameterRows = 0;
+    m_value.clear();
+    m_min.clear();
+    m_max.clear();
+    m_active.clear();
+    m_highResolution.clear();
+    m_highResolutionByCc.fill(0);
+    m_description.clear();
+    m_nextRowSameCc.clear();
+    m_firstRowByCc.fill(NO_ROW);
+    m_channel.clear();
+    m_channelByCc.fill(NO_CHANNEL);
+    m_channelOverrides = 0;
+}
+
+void ParameterStore::setValue(std::size_t index, int value)
+{
+    // Asegurarse de que el valor esté dentro del rango del parámetro.
+    if (value < m_min[index]) value = m_min[index];
+    if (value > m_max[index]) value = m_max[index];
+    m_value[index] = static_cast<std::uint16_t>(value);
+}
+
+std::size_t ParameterStore::resetActive()
+{
+    std::size_t count = 0;
+    for (std::size_t i = 0; i < m_value.size(); ++i)
+    {
+        if (m_active[i])
+        {
+            m_value[i] = m_min[i];
+            ++count;
+        }
+    }
+    return count;
+}
+
+std::size_t ParameterStore::applyPreset(const PresetImage& preset)
+{
+    std::size_t count = 0;
+    for (std::size_t i = 0; i < m_cc.size(); ++i)
+    {
+        const int cc = m_cc[i];
+        if (cc != NOT_A_CC && preset.has(cc))
+        {
+            setValue(i, preset.value(cc));
+            m_active[i] = preset.isActive(cc) ? 1 : 0;
+            ++count;
+        }
+    }
+    return count;
+}
+
+PresetImage ParameterStore::snapshot() const
+{
+    PresetImage image;
+    for (std::size_t i = 0; i < m_cc.size(); ++i)
+    {
+        if (m_cc[i] == NOT_A_CC)
+        {
+            continue; /// @version 2.9: Los NRPN/RPN no van en el preset.
+        }
+        image.set(m_cc[i], m_value[i], m_active[i] != 0);
+        image.setHighResolution(m_cc[i], m_highResolution[i] != 0); /// @version 2.8
+    }
+    return image;
+}
+
+std::size_t ParameterStore::appendActiveBatch(unsigned char channel, std::vector<MidiMessage>& out) const
+{
+    const std::size_t before = out.size();
+    if (m_channelOverrides == 0)
+    {
+        for (std::size_t i = 0; i < m_cc.size(); ++i)
+        {
+            if (m_active[i] && m_cc[i] != NOT_A_CC)
+            {
+                /// @version 2.8: Uno o dos mensajes por fila (par de 14 bits).
+                MidiMessage messages[MAX_MESSAGES_PER_ROW];
+                out.insert(out.end(), messages, messages + appendRowMessages(i, channel, messages));
+            }
+        }
+        return out.size() - before;
+    }
+
+    /// @version 2.7: Agrupar por canal con un conteo (estable, O(n), sin ordenar).
+    std::array<std::size_t, 16> offset{};
+    for (std::size_t i = 0; i < m_cc.size(); ++i)
+    {
+        const unsigned isCc = m_cc[i] != NOT_A_CC ? 1u : 0u; /// @version 2.9
+        offset[channelFor(i, channel)] += m_active[i] * isCc * (1u + m_highResolution[i]);
+    }
+    std::size_t next = before;
+    for (std::size_t& slot : offset)
+    {
+        const std::size_t count = slot;
+        slot = next;
+        next += count;
+    }
+    out.resize(next);
+    for (std::size_t i = 0; i < m_cc.size(); ++i)
+    {
+        if (m_active[i] && m_cc[i] != NOT_A_CC)
+        {
+            const unsigned char target = channelFor(i, channel);
+            offset[target] += appendRowMessages(i, target, &out[offset[target]]);
+        }
+    }
+    return next - before;
+}
+
+std::size_t ParameterStore::appendActiveParameters(unsigned char channel, std::vector<NrpnMessage>& out) const
+{
+    if (m_parameterRows == 0)
+    {
+        return 0;
+    }
+    const std::size_t before = out.size();
+    for (std::size_t i = 0; i < m_cc.size(); ++i)
+    {
+        if (m_active[i] && m_cc[i] == NOT_A_CC)
+        {
+            out.push_back(parameterMessage(i, channelFor(i, channel)));
+        }
+    }
+    return out.size() - before;
+}
@@ -0,0 +1,155 @@
+/**
+ * @file ParameterSync.cpp
+ * @author Gabriel Nicolás González Ferreira (gabrielinuz@fi.mdp.edu.ar)
+ * @brief Implementación de ParameterSync: búsqueda por CC#, supresión de ecos y filas a redibujar.
+ * @version 2.9
+ * @date 2026-10-16
+ */
+#include "ParameterSync.hpp"
+
+ParameterSync::ParameterSync(std::shared_ptr<ParameterStore> store, std::shared_ptr<MidiService> midiService)
+    : m_store(store),
+      m_midiService(midiService)
+{}
+
+std::size_t ParameterSync::apply(const MidiInputEvent* events, std::size_t count, unsigned char channel)
+{
+    if (m_dirty.size() != m_store->size())
+    {
+        reset(); // El layout cambió desde el último lote.
+        m_dirty.assign(m_store->size(), 0);
+    }
+
+    std::size_t updated = 0;
+    m_outBatch.clear();
+    m_outParameters.clear();
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        const MidiMessage& message = events[i].message;
+        if (message.size() != 3 || (message.status() & 0xF0) != 0xB0)
+        {
+            continue; // Solo Control Change.
+        }
+        const unsigned char cc = message.bytes[1];
+        const unsigned char value = message.bytes[2];
+        const unsigned char received = message.status() & 0x0F;
+
+        /// @version 2.4: MIDI Learn: un acceso a la tabla 16x128, sin buscar en los controles.
+        const int routed = m_learnMap ? m_learnMap->route(received, cc) : MidiLearnMap::NO_ROW;
+        if (routed != MidiLearnMap::NO_ROW && static_cast<std::size_t>(routed) < m_store->size())
+        {
+            const std::size_t target = static_cast<std::size_t>(routed);
+            /// @version 2.8: Una perilla de 7 bits recorre todo el rango de una fila de 14 bits.
+            m_store->setValue(target, m_store->isHighResolution(target) ? (value << 7) | value : value);
+            markDirty(target);
+            if (m_store->isActive(target) && m_store->getType(target) != ParameterType::ControlChange)
+            {
+                m_outParameters.push_back(m_store->parameterMessage(target, m_store->channelFor(target, channel))); /// @version 2.9
+            }
+            else if (m_store->isActive(target))
+            {
+                MidiMessage messages[ParameterStore::MAX_MESSAGES_PER_ROW];
+                const std::size_t written = m_store->appendRowMessages(target, m_store->channelFor(target, channel), messages);
+                m_outBatch.insert(m_outBatch.end(), messages, messages + written);
+            }
+            ++updated;
+            ++m_routedCount;
+            continue;
+        }
+
+        if (!m_store->hasChannelOverrides() && received != (channel & 0x0F))
+        {
+            continue; // Sin binding, solo cuenta el canal seleccionado.
+        }
+
+        /// @version 2.8: El CC n+32 es el LSB de las filas de 14 bits con CC n; solo a esas se aplica.
+        const bool lsb = cc >= MidiMessage::HIGH_RESOLUTION_LSB_OFFSET && cc < 2 * MidiMessage::HIGH_RESOLUTION_LSB_OFFSET &&
+                         m_store->isHighResolutionCc(cc - MidiMessage::HIGH_RESOLUTION_LSB_OFFSET);
+        const auto matches = [this, lsb, channel, received](int candidate)
+        {
+            const std::size_t index = static_cast<std::size_t>(candidate);
+            return m_store->channelFor(index, channel) == received && (!lsb || m_store->isHighResolution(index));
+        };
+
+        /// @version 2.7: Primera fila con este CC que sale por el canal recibido (el propio o el de la ventana).
+        int row = m_store->firstRowForCc(lsb ? cc - MidiMessage::HIGH_RESOLUTION_LSB_OFFSET : cc);
+        while (row != ParameterStore::NO_ROW && !matches(row))
+        {
+            row = m_store->nextRowForCc(static_cast<std::size_t>(row));
+        }
+        if (row == ParameterStore::NO_ROW)
+        {
+            continue; // El layout no usa este CC en este canal.
+        }
+
+        if (m_midiService)
+        {
+            // Eco exacto de lo que enviamos, o eco atrasado mientras seguimos enviando ese CC.
+            const bool sameAsSent = m_midiService->getLastSentValue(received, cc) == value;
+            const std::int64_t sentAt = m_midiService->getLastSentTime(received, cc);
+            if (sameAsSent || (sentAt != 0 && events[i].timestampNs - sentAt < ECHO_WINDOW_NS))
+            {
+                ++m_echoCount;
+                continue;
+            }
+            m_midiService->noteReceived(message);
+        }
+
+        for (; row != ParameterStore::NO_ROW; row = m_store->nextRowForCc(static_cast<std::size_t>(row)))
+        {
+            if (!matches(row))
+            {
+                continue;
+            }
+            const std::size_t index = static_cast<std::size_t>(row);
+            int newValue = value;
+            if (lsb)
+            {
+                newValue = (m_store->getValue(index) & ~0x7F) | value; // Ajuste fino: solo los 7 bits bajos.
+            }
+            else if (m_store->isHighResolution(index))
+            {
+                newValue = value << 7; // Un MSB nuevo lleva el LSB a 0, como en el receptor.
+            }
+            m_store->setValue(index, newValue);
+            markDirty(index);
+            ++updated;
+        }
+        ++m_appliedCount;
+    }
+
+    if (!m_outBatch.empty() && m_midiService)
+    {
+        m_midiService->sendBatch(m_outBatch.data(), m_outBatch.size(), false);
+    }
+    if (!m_outParameters.empty() && m_midiService)
+    {
+        m_midiService->sendParameters(m_outParameters);
+    }
+    return updated;
+}
+
+void ParameterSync::takeDirtyRows(std::vector<std::size_t>& rows)
+{
+    rows.clear();
+    rows.swap(m_dirtyRows); // Sin copias: los dos vectores conservan su capacidad.
+    for (std::size_t row : rows)
+    {
+        m_dirty[row] = 0;
+    }
+}
+
+void ParameterSync::reset()
+{
+    m_dirtyRows.clear();
+    m_dirty.assign(m_dirty.size(), 0);
+}
+
+void ParameterSync::markDirty(std::size_t row)
+{
+    if (!m_dirty[row])
+    {
+        m_dirty[row] = 1;
+        m_dirtyRows.push_back(row);
+    }
+}
@@ -0,0 +1,181 @@
+/**
+ * @file PresetBank.cpp
+ * @author Gabriel Nicolás González Ferreira (gabrielinuz@fi.mdp.edu.ar)
+ * @brief Implementación del banco binario de presets y su importación/exportación CSV.
+ * @version 2.8
+ * @date 2026-10-16
+ */
+#include "PresetBank.hpp"
+#include "MidiPresetParser.hpp"
+#include "Utils.hpp"
+#include <algorithm> // Para std::min y std::copy
+#include <cstring>
+#include <fstream>
+#include <iostream>
+
+namespace
+{
+    constexpr char BANK_MAGIC[8] = {'M', 'C', 'C', 'B', 'A', 'N', 'K', '\0'};
+}
+
+bool PresetBank::open(const std::string& filename)
+{
+    close();
+
+    auto file = std::make_unique<MappedFile>(filename);
+    if (!file->isOpen())
+    {
+        std::cerr << "Error: Could not open preset bank: " << filename << std::endl;
+        return false;
+    }
+
+    const std::string_view data = file->view();
+    Header header;
+    if (data.size() < sizeof(Header))
+    {
+        std::cerr << "Error: Preset bank is too small: " << filename << std::endl;
+        return false;
+    }
+    std::memcpy(&header, data.data(), sizeof(Header));
+
+    /// @version 2.8: El formato 1 se acepta y se convierte (ver más abajo).
+    const bool legacy = header.version == 1 && header.recordSize == sizeof(RecordV1);
+    if (std::memcmp(header.magic, BANK_MAGIC, sizeof(BANK_MAGIC)) != 0 ||
+        (!legacy && (header.version != FORMAT_VERSION || header.recordSize != sizeof(PresetImage))) ||
+        header.nameSize != NAME_SIZE)
+    {
+        std::cerr << "Error: Not a supported preset bank: " << filename << std::endl;
+        return false;
+    }
+
+    const std::size_t namesOffset = sizeof(Header);
+    const std::size_t recordsOffset = namesOffset + std::size_t(header.count) * NAME_SIZE;
+    const std::size_t expectedSize = recordsOffset + std::size_t(header.count) * header.recordSize;
+    if (data.size() < expectedSize)
+    {
+        std::cerr << "Error: Preset bank is truncated: " << filename << std::endl;
+        return false;
+    }
+
+    // El mapeo empieza en un límite de página y los desplazamientos respetan alignof(PresetImage).
+    m_names = data.data() + namesOffset;
+    m_records = reinterpret_cast<const PresetImage*>(data.data() + recordsOffset);
+    m_count = header.count;
+
+    if (legacy)
+    {
+        // Formato 1: valores de 8 bits. Se convierten una sola vez; get() sigue siendo un índice.
+        m_converted.resize(m_count);
+        for (std::size_t i = 0; i < m_count; ++i)
+        {
+            RecordV1 record;
+            std::memcpy(&record, data.data() + recordsOffset + i * sizeof(RecordV1), sizeof(RecordV1));
+            std::copy(record.values.begin(), record.values.end(), m_converted[i].values.begin());
+            m_converted[i].present = record.present;
+            m_converted[i].active = record.active;
+        }
+        m_records = m_converted.data();
+    }
+    m_file = std::move(file);
+    return true;
+}
+
+void PresetBank::close()
+{
+    m_file.reset();
+    m_converted.clear();
+    m_names = nullptr;
+    m_records = nullptr;
+    m_count = 0;
+}
+
+std::string_view PresetBank::getName(std::size_t index) const
+{
+    const char* name = m_names + index * NAME_SIZE;
+    const void* end = std::memchr(name, '\0', NAME_SIZE);
+    const std::size_t length = end ? static_cast<std::size_t>(static_cast<const char*>(end) - name) : NAME_SIZE;
+    return std::string_view(name, length);
+}
+
+int PresetBank::find(std::string_view name) const
+{
+    for (std::size_t i = 0; i < m_count; ++i)
+    {
+        if (getName(i) == name)
+        {
+            return static_cast<int>(i);
+        }
+    }
+    return -1;
+}
+
+bool PresetBank::write(const std::string& filename, const std::vector<Entry>& entries)
+{
+    std::ofstream file(filename, std::ios::binary | std::ios::trunc);
+    if (!file.is_open())
+    {
+        std::cerr << "Error: Could not create preset bank: " << filename << std::endl;
+        return false;
+    }
+
+    Header header{};
+    std::memcpy(header.magic, BANK_MAGIC, sizeof(BANK_MAGIC));
+    header.version = FORMAT_VERSION;
+    header.count = static_cast<std::uint32_t>(entries.size());
+    header.nameSize = NAME_SIZE;
+    header.recordSize = sizeof(PresetImage);
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+    // Índice de nombres: entradas fijas, rellenas con '\0'.
+    for (const auto& entry : entries)
+    {
+        char name[NAME_SIZE] = {};
+        std::memcpy(name, entry.name.data(), std::min(entry.name.size(), NAME_SIZE - 1));
+        file.write(name, NAME_SIZE);
+    }
+
+    // Registros: la PresetImage tal como está en memoria.
+    for (const auto& entry : entries)
+    {
+        file.write(reinterpret_cast<const char*>(&entry.image), sizeof(PresetImage));
+    }
+
+    file.close();
+    return !file.fail();
+}
+
+std::size_t PresetBank::importCsv(const std::vector<std::string>& csvFiles, const std::string& bankFile)
+{
+    std::vector<Entry> entries;
+    entries.reserve(csvFiles.size());
+    for (const auto& path : csvFiles)
+    {
+        Entry entry;
+        if (!MidiPresetParser::load(path, entry.image))
+        {
+            continue; // load() ya informó el error.
+        }
+        entry.name = Utils::getFileNameFromPath(path);
+        const std::size_t dot = entry.name.rfind('.');
+        if (dot != std::string::npos && dot > 0)
+        {
+            entry.name.erase(dot); // Sin extensión.
+        }
+        entries.push_back(std::move(entry));
+    }
+    return write(bankFile, entries) ? entries.size() : 0;
+}
+
+std::size_t PresetBank::exportCsv(const std::string& directory) const
+{
+    std::size_t written = 0;
+    for (std::size_t i = 0; i < m_count; ++i)
+    {
+        const std::string path = directory + "/" + std::string(getName(i)) + ".csv";
+        if (MidiPresetParser::save(path, get(i)))
+        {
+            ++written;
+        }
+    }
+    return written;
+}
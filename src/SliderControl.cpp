@@ -3,8 +3,8 @@
  * @author Gabriel Nicolás González Ferreira (gabrielinuz@fi.mdp.edu.ar)
  * @brief Implementación de la clase SliderControl. 
  * \\Creación de widgets y el manejo de eventos para los sliders MIDI.
- * @version 0.6
- * @date 2025-06-17
+ * @version 2.9
+ * @date 2026-10-16
  * @copyright Copyright (c) 2025. This project is released under the Apache License.
  * @link http://www.apache.org/licenses/LICENSE-2.0
  */
@@ -12,11 +12,11 @@
 #include <string>
 #include <sstream> // Para std::stringstream
 
-SliderControl::SliderControl(const SliderConfig& config, std::shared_ptr<MidiService> midiService)
-    : m_config(config),
+SliderControl::SliderControl(std::shared_ptr<ParameterStore> store, std::size_t index, std::shared_ptr<MidiService> midiService)
+    : m_store(store),
+      m_index(index),
       m_midiService(midiService),
       m_currentMidiChannel(nullptr),
-      m_isActive(true), /** @version 0.6: Por defecto, un control está activo.*/
       m_group(nullptr),
       m_checkButton(nullptr),/** @version 0.6: Inicializar el puntero del checkbox*/
       m_label(nullptr),
@@ -33,11 +33,13 @@ void SliderControl::createWidgets(int x, int y, int w, int h, unsigned char* cur
 
     /// @version 0.6: Checkbox a la izquierda del todo.
     m_checkButton = new Fl_Check_Button(x + 5, y + 5, 20, 20);
-    m_checkButton->value(m_isActive ? 1 : 0); /** @version 0.6:  Establecer su estado inicial*/
+    m_checkButton->value(m_store->isActive(m_index) ? 1 : 0); /** @version 0.6:  Establecer su estado inicial*/
     m_checkButton->callback(onCheckboxClicked_static, this);    
 
     /// @version 0.6: Ajustar la posición y el ancho de los otros widgets para hacer espacio.
-    m_label = new Fl_Box(x + 30, y, 100, 25, m_config.description.c_str());
+    /// @version 1.4: copy_label, el texto del almacén puede moverse en memoria al agregar filas.
+    m_label = new Fl_Box(x + 30, y, 100, 25);
+    m_label->copy_label(m_store->getDescription(m_index).c_str());
     m_label->align(FL_ALIGN_LEFT | FL_ALIGN_INSIDE | FL_ALIGN_WRAP);
     
     // CORRECCIÓN DEL TOOLTIP:
@@ -45,7 +47,7 @@ void SliderControl::createWidgets(int x, int y, int w, int h, unsigned char* cur
     //    para garantizar que el puntero de c_str() sea válido durante toda la vida del widget.
     // 2. El tooltip se asigna al grupo (m_group) en lugar de solo a la etiqueta.
     //    Esto hace que el tooltip aparezca al pasar el ratón sobre cualquier parte del control (etiqueta o slider).
-    m_tooltipText = "CC# " + std::to_string(m_config.cc_number);
+    m_tooltipText = tooltipFor(m_index);
     m_group->tooltip(m_tooltipText.c_str());
 
     // El slider
@@ -53,10 +55,11 @@ void SliderControl::createWidgets(int x, int y, int w, int h, unsigned char* cur
     // ¡Línea corregida aquí! Se añadió 'nullptr' como sexto argumento para la etiqueta.
     /// @version 0.6: Ajustar la posición del slider y su ancho
     m_slider = new Fl_Slider(FL_HORIZONTAL, x + 135, y, w - 195, 25, nullptr);
-    m_slider->bounds(m_config.min_value, m_config.max_value);
-    m_slider->value(m_config.min_value); // Set initial value to min
+    m_slider->bounds(m_store->getMinValue(m_index), m_store->getMaxValue(m_index));
+    m_slider->value(m_store->getValue(m_index)); /// @version 1.4: Valor inicial desde el almacén
     m_slider->step(1); // Para asegurar pasos enteros si los valores son enteros
     m_slider->callback(sliderCallback_static, this);
+    m_slider->when(FL_WHEN_CHANGED | FL_WHEN_RELEASE_ALWAYS); /// @version 2.4: Un clic sin mover también avisa (MIDI Learn).
     m_slider->tooltip(m_tooltipText.c_str()); // El slider también puede tener el tooltip
 
     /// @version 0.5: Widget Fl_Value_Output para mostrar el valor
@@ -71,7 +74,7 @@ void SliderControl::createWidgets(int x, int y, int w, int h, unsigned char* cur
     m_group->resizable(m_slider); // Hacer el slider y su grupo redimensionables
 
     ///@version 0.6: Aplicar el estado de activación inicial a los widgets visuales
-    setActive(m_isActive);
+    applyActiveState();
 }
 
 Fl_Widget* SliderControl::getWidgetGroup()
@@ -89,38 +92,54 @@ int SliderControl::getHeight() const
 // --- Implementación de los nuevos métodos de la interfaz ---
 int SliderControl::getCcNumber() const 
 {
-    return m_config.cc_number;
+    return m_store->getCc(m_index);
 }
 
 std::string SliderControl::getDescription() const 
 {
-    return m_config.description;
+    return m_store->getDescription(m_index);
 }
 
 std::string SliderControl::getRange() const 
 {
     // Usar stringstream para formatear el rango de manera eficiente.
     std::stringstream ss;
-    ss << m_config.min_value << "-" << m_config.max_value;
+    ss << m_store->getMinValue(m_index) << "-" << m_store->getMaxValue(m_index);
     return ss.str();
 }
 
 int SliderControl::getCurrentValue() const 
 {
-    if (m_slider) 
-    {
-        return static_cast<int>(m_slider->value());
-    }
-    return 0; // Valor por defecto si el widget no está creado
+    /// @version 1.4: El valor se lee del almacén, no del widget.
+    return m_store->getValue(m_index);
 }
 
 void SliderControl::setCurrentValue(int value) 
+{
+    m_store->setValue(m_index, value); // El almacén recorta el valor a su rango.
+    refresh();
+}
+
+/// --- @version 0.6: Implementación de los métodos de activación ---
+
+void SliderControl::setActive(bool active)
+{
+    m_store->setActive(m_index, active);
+    applyActiveState();
+}
+
+bool SliderControl::isActive() const
+{
+    return m_store->isActive(m_index);
+}
+
+/// --- @version 1.4: Sincronización con el almacén ---
+
+void SliderControl::refresh()
 {
     if (m_slider) 
     {
-        // Asegurarse de que el valor esté dentro de los límites del slider.
-        if (value < m_slider->minimum()) value = m_slider->minimum();
-        if (value > m_slider->maximum()) value = m_slider->maximum();
+        const int value = m_store->getValue(m_index);
         m_slider->value(value);
         m_slider->redraw(); // Forzar redibujado para que el cambio sea visible.
         if (m_valueOutput) 
@@ -128,21 +147,72 @@ void SliderControl::setCurrentValue(int value)
             m_valueOutput->value(value);
             m_valueOutput->redraw();
         }
+        /// @version 2.4: La fila armada para MIDI Learn se resalta.
+        const bool armed = m_learnMap && m_learnMap->getArmedRow() == static_cast<int>(m_index);
+        m_label->labelcolor(armed ? FL_RED : FL_FOREGROUND_COLOR);
+        m_label->redraw();
     }
+    applyActiveState();
 }
 
-/// --- @version 0.6: Implementación de los métodos de activación ---
+/// --- @version 1.5: Reciclaje de widgets ---
 
-void SliderControl::setActive(bool active)
+/** @brief @version 2.7: "CC# 7", o "CC# 7 (Ch 3)" si la fila tiene canal propio.
+ *  @version 2.8: "CC# 1/33 (14-bit)" para un control de 14 bits.
+ *  @version 2.9: "NRPN 1234" o "RPN 0", con " (14-bit)" si el dato lleva LSB. */
+std::string SliderControl::tooltipFor(std::size_t index) const
 {
-    m_isActive = active;
+    std::string text;
+    const ParameterType type = m_store->getType(index);
+    if (type != ParameterType::ControlChange)
+    {
+        text = (type == ParameterType::Rpn ? "RPN " : "NRPN ") + std::to_string(m_store->getParameterNumber(index));
+        if (m_store->isHighResolution(index))
+        {
+            text += " (14-bit)";
+        }
+    }
+    else
+    {
+        text = "CC# " + std::to_string(m_store->getCc(index));
+        if (m_store->isHighResolution(index))
+        {
+            text += "/" + std::to_string(m_store->getCc(index) + MidiMessage::HIGH_RESOLUTION_LSB_OFFSET) + " (14-bit)";
+        }
+    }
+    if (m_store->getChannel(index) != ParameterStore::NO_CHANNEL)
+    {
+        text += " (Ch " + std::to_string(m_store->getChannel(index) + 1) + ")";
+    }
+    return text;
+}
+
+void SliderControl::bind(std::size_t index)
+{
+    m_index = index;
+    if (!m_slider)
+    {
+        return; // Sin widgets todavía; createWidgets() leerá la nueva fila.
+    }
+
+    m_label->copy_label(m_store->getDescription(m_index).c_str());
+    m_tooltipText = tooltipFor(m_index);
+    m_group->tooltip(m_tooltipText.c_str());
+    m_slider->tooltip(m_tooltipText.c_str());
+    m_slider->bounds(m_store->getMinValue(m_index), m_store->getMaxValue(m_index));
+    refresh();
+}
+
+void SliderControl::applyActiveState()
+{
+    const bool active = m_store->isActive(m_index);
     if (m_checkButton)
     {
-        m_checkButton->value(m_isActive ? 1 : 0);
+        m_checkButton->value(active ? 1 : 0);
     }
     if (m_slider) 
     {
-        if (m_isActive) 
+        if (active) 
         {
             m_slider->activate();
             m_valueOutput->activate();
@@ -160,11 +230,6 @@ void SliderControl::setActive(bool active)
     }
 }
 
-bool SliderControl::isActive() const
-{
-    return m_isActive;
-}
-
 
 // --- Lógica de Callbacks ---
 
@@ -192,17 +257,40 @@ void SliderControl::sliderCallback_static(Fl_Widget* w, void* userdata)
 
 void SliderControl::sliderCallback()
 {
+    /// @version 2.4: En modo Learn el slider solo se elige como destino; no envía.
+    if (m_learnMap && m_learnMap->isLearning())
+    {
+        m_slider->value(m_store->getValue(m_index)); // Deshacer el movimiento del clic.
+        m_learnMap->arm(m_index);
+        return;
+    }
+
     /// --- @version 0.6: Solo enviar MIDI si el control está activo.
-    if (!m_midiService || !m_currentMidiChannel || !m_isActive)
+    if (!m_midiService || !m_currentMidiChannel || !m_store->isActive(m_index))
     {
         return;
     }
 
-    unsigned char cc_num = static_cast<unsigned char>(m_config.cc_number);
-    unsigned char value = static_cast<unsigned char>(m_slider->value());
-    unsigned char channel = *m_currentMidiChannel; // Usar el canal actual de MainWindow
+    /// @version 1.4: El movimiento del slider se registra primero en el almacén.
+    m_store->setValue(m_index, static_cast<int>(m_slider->value()));
+
+    const int value = m_store->getValue(m_index);
+    /// @version 2.7: El canal propio del control, si el layout lo define; si no, el de MainWindow.
+    unsigned char channel = m_store->channelFor(m_index, *m_currentMidiChannel);
 
-    m_midiService->sendCcMessage(channel, cc_num, value);
+    /// @version 0.8: Envío sin reservas de memoria a través de MidiMessage.
+    /// @version 2.8: Un control de 14 bits sale como par MSB/LSB en un solo lote (no forzado,
+    /// así MidiService omite el MSB cuando el arrastre solo cambió el LSB).
+    /// @version 2.9: Un NRPN/RPN sale como parámetro; MidiService omite la dirección si ya está seleccionada.
+    if (m_store->getType(m_index) != ParameterType::ControlChange)
+    {
+        m_midiService->sendParameter(m_store->parameterMessage(m_index, channel));
+    }
+    else
+    {
+        MidiMessage messages[ParameterStore::MAX_MESSAGES_PER_ROW];
+        m_midiService->sendBatch(messages, m_store->appendRowMessages(m_index, channel, messages), false);
+    }
 
     if (m_valueOutput) 
     { 
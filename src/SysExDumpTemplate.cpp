@@ -0,0 +1,187 @@
+/**
+ * @file SysExDumpTemplate.cpp
+ * @author Gabriel Nicolás González Ferreira (gabrielinuz@fi.mdp.edu.ar)
+ * @brief Implementación del parseo de las plantillas de volcado y de la decodificación de respuestas.
+ * @version 3.1
+ * @date 2026-10-16
+ */
+#include "SysExDumpTemplate.hpp"
+#include "MappedFile.hpp"
+#include "Utils.hpp"
+#include <charconv>
+#include <iostream>
+
+std::string SysExDumpTemplate::pathFor(const std::string& layoutPath)
+{
+    return Utils::replaceExtension(layoutPath, ".dump.csv");
+}
+
+void SysExDumpTemplate::clear()
+{
+    m_request.clear();
+    m_response.clear();
+    m_expectedSize = 0;
+    m_timeout = DEFAULT_TIMEOUT;
+    m_retries = DEFAULT_RETRIES;
+    m_offset.fill(NO_OFFSET);
+    m_lsbOffset.fill(NO_OFFSET);
+    m_mappedCount = 0;
+    m_valid = false;
+}
+
+bool SysExDumpTemplate::load(const std::string& filename)
+{
+    clear();
+    MappedFile file(filename);
+    if (!file.isOpen())
+    {
+        return false; // Es normal: no todos los layouts saben pedir un volcado.
+    }
+    return parseBuffer(file.view());
+}
+
+bool SysExDumpTemplate::parseHex(std::string_view text, std::vector<std::uint16_t>& out)
+{
+    out.clear();
+    while (!text.empty())
+    {
+        const std::string_view token = Utils::nextField(text, ' ');
+        if (token.empty())
+        {
+            continue; // Varios espacios seguidos.
+        }
+        if (token == "CH")
+        {
+            out.push_back(CHANNEL_TOKEN);
+            continue;
+        }
+        unsigned int byte = 0;
+        const auto result = std::from_chars(token.data(), token.data() + token.size(), byte, 16);
+        if (result.ec != std::errc() || result.ptr != token.data() + token.size() || byte > 0xFF)
+        {
+            return false;
+        }
+        out.push_back(static_cast<std::uint16_t>(byte));
+    }
+    return !out.empty();
+}
+
+bool SysExDumpTemplate::parseBuffer(std::string_view content)
+{
+    clear();
+    while (!content.empty())
+    {
+        const std::string_view line = Utils::nextLine(content);
+        if (line.empty() || line.compare(0, 3, "Key") == 0) continue; // Saltar líneas vacías o la cabecera
+
+        std::string_view rest = line;
+        const std::string_view key = Utils::nextField(rest, ';');
+        const std::string_view value = Utils::nextField(rest, ';');
+        int number = 0;
+        if (key == "Request" || key == "Response")
+        {
+            if (!parseHex(value, key == "Request" ? m_request : m_response))
+            {
+                std::cerr << "Error parsing SysEx dump line: '" << line << "'. Reason: Invalid hex bytes" << std::endl;
+            }
+        }
+        else if (key == "Size" || key == "Timeout" || key == "Retries")
+        {
+            if (!Utils::parseInt(value, number) || number < 0)
+            {
+                std::cerr << "Error parsing SysEx dump line: '" << line << "'. Reason: Invalid number" << std::endl;
+                continue;
+            }
+            if (key == "Size") m_expectedSize = static_cast<std::size_t>(number);
+            else if (key == "Timeout") m_timeout = std::chrono::milliseconds(number);
+            else m_retries = static_cast<unsigned int>(number);
+        }
+        else
+        {
+            // CC#;posición[;posición del LSB]
+            int cc = 0;
+            int offset = 0;
+            int lsbOffset = NO_OFFSET;
+            const std::string_view lsb = Utils::nextField(rest, ';');
+            if (!Utils::parseInt(key, cc) || !Utils::parseInt(value, offset) || (!lsb.empty() && !Utils::parseInt(lsb, lsbOffset)))
+            {
+                std::cerr << "Error parsing SysEx dump line: '" << line << "'. Reason: Invalid number" << std::endl;
+                continue;
+            }
+            if (cc < 0 || cc > 127 || offset < 0 || (!lsb.empty() && lsbOffset < 0))
+            {
+                std::cerr << "Warning: Invalid data in SysEx dump line, skipping: " << line << std::endl;
+                continue;
+            }
+            if (m_offset[cc] == NO_OFFSET)
+            {
+                ++m_mappedCount;
+            }
+            m_offset[cc] = offset;
+            m_lsbOffset[cc] = lsbOffset;
+        }
+    }
+
+    // El pedido es un único SysEx completo; el canal cuenta como un byte de datos.
+    bool requestOk = m_request.size() >= 2 && m_request.front() == 0xF0 && m_request.back() == 0xF7;
+    for (std::size_t i = 1; requestOk && i + 1 < m_request.size(); ++i)
+    {
+        requestOk = m_request[i] < 0x80 || m_request[i] == CHANNEL_TOKEN;
+    }
+    if (!requestOk)
+    {
+        std::cerr << "Error: SysEx dump template has no valid Request (F0 ... F7)." << std::endl;
+    }
+    m_valid = requestOk && !m_response.empty() && m_mappedCount > 0;
+    return m_valid;
+}
+
+std::vector<unsigned char> SysExDumpTemplate::buildRequest(unsigned char channel) const
+{
+    std::vector<unsigned char> request;
+    request.reserve(m_request.size());
+    for (std::uint16_t byte : m_request)
+    {
+        request.push_back(byte == CHANNEL_TOKEN ? static_cast<unsigned char>(channel & 0x0F) : static_cast<unsigned char>(byte));
+    }
+    return request;
+}
+
+bool SysExDumpTemplate::matches(const unsigned char* data, std::size_t size) const
+{
+    if (!m_valid || size < m_response.size() || (m_expectedSize > 0 && size != m_expectedSize))
+    {
+        return false;
+    }
+    for (std::size_t i = 0; i < m_response.size(); ++i)
+    {
+        if (m_response[i] != CHANNEL_TOKEN && m_response[i] != data[i])
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+std::size_t SysExDumpTemplate::decode(const unsigned char* data, std::size_t size, PresetImage& image) const
+{
+    std::size_t decoded = 0;
+    for (int cc = 0; cc < static_cast<int>(PresetImage::CONTROLLERS); ++cc)
+    {
+        const std::int32_t offset = m_offset[cc];
+        const std::int32_t lsbOffset = m_lsbOffset[cc];
+        if (offset == NO_OFFSET || static_cast<std::size_t>(offset) >= size ||
+            (lsbOffset != NO_OFFSET && static_cast<std::size_t>(lsbOffset) >= size))
+        {
+            continue;
+        }
+        int value = data[offset] & 0x7F;
+        if (lsbOffset != NO_OFFSET)
+        {
+            value = (value << 7) | (data[lsbOffset] & 0x7F);
+        }
+        image.set(cc, value, image.has(cc) ? image.isActive(cc) : true);
+        ++decoded;
+    }
+    return decoded;
+}
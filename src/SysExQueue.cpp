@@ -0,0 +1,56 @@
+/**
+ * @file SysExQueue.cpp
+ * @author Gabriel Nicolás González Ferreira (gabrielinuz@fi.mdp.edu.ar)
+ * @brief Implementación de la cola de SysEx recibidos sobre un buffer circular de bytes.
+ * @version 3.0
+ * @date 2026-10-16
+ */
+#include "SysExQueue.hpp"
+#include <algorithm>
+#include <cstring>
+
+bool SysExQueue::tryPush(const unsigned char* data, std::size_t size, std::int64_t timestampNs)
+{
+    const std::size_t used = m_writePosition - m_readPosition.load(std::memory_order_acquire);
+    if (size == 0 || size > CAPACITY - used)
+    {
+        return false;
+    }
+
+    // Copia en dos tramos si el mensaje cruza el final del buffer.
+    const std::size_t offset = m_writePosition & (CAPACITY - 1);
+    const std::size_t first = std::min(size, CAPACITY - offset);
+    std::memcpy(m_bytes.get() + offset, data, first);
+    std::memcpy(m_bytes.get(), data + first, size - first);
+
+    // El registro se publica después de los bytes (release en tryPush()).
+    if (!m_records.tryPush({m_writePosition, size, timestampNs}))
+    {
+        return false;
+    }
+    m_writePosition += size;
+    return true;
+}
+
+bool SysExQueue::tryPop(std::vector<unsigned char>& out, std::int64_t* timestampNs)
+{
+    Record record;
+    if (!m_records.tryPop(record))
+    {
+        return false;
+    }
+
+    const std::size_t offset = record.begin & (CAPACITY - 1);
+    const std::size_t first = std::min(record.size, CAPACITY - offset);
+    out.resize(record.size);
+    std::memcpy(out.data(), m_bytes.get() + offset, first);
+    std::memcpy(out.data() + first, m_bytes.get(), record.size - first);
+    if (timestampNs)
+    {
+        *timestampNs = record.timestampNs;
+    }
+
+    // Recién ahora el productor puede reutilizar esos bytes.
+    m_readPosition.store(record.begin + record.size, std::memory_order_release);
+    return true;
+}
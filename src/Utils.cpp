@@ -7,6 +7,7 @@
  */
 #include "Utils.hpp"
 #include <algorithm> // Para std::max
+#include <charconv>  // @version 1.7: std::from_chars
 
 namespace Utils
 {
@@ -53,4 +54,50 @@ namespace Utils
         }
         return "."; // Devuelve el directorio actual si no se encuentra una barra.
     }
-} // namespace Utils
\ No newline at end of file
+
+    std::string replaceExtension(const std::string& filePath, const std::string& suffix)
+    {
+        const size_t slash = filePath.find_last_of("/\\");
+        const size_t dot = filePath.find_last_of('.');
+        const bool hasExtension = dot != std::string::npos && (slash == std::string::npos || dot > slash);
+        return (hasExtension ? filePath.substr(0, dot) : filePath) + suffix;
+    }
+
+    /// --- @version 1.7: Utilidades de parseo sin excepciones para los CSV ---
+
+    bool parseInt(std::string_view text, int& value)
+    {
+        std::size_t pos = 0;
+        while (pos < text.size() && (text[pos] == ' ' || text[pos] == '\t'))
+        {
+            ++pos; // std::stoi ignoraba los espacios iniciales.
+        }
+        if (pos < text.size() && text[pos] == '+')
+        {
+            ++pos; // from_chars no acepta '+', std::stoi sí.
+        }
+        const char* first = text.data() + pos;
+        const char* last = text.data() + text.size();
+        return std::from_chars(first, last, value).ec == std::errc();
+    }
+
+    std::string_view nextField(std::string_view& text, char delimiter)
+    {
+        const std::size_t pos = text.find(delimiter);
+        std::string_view field = text.substr(0, pos);
+        text = (pos == std::string_view::npos) ? std::string_view() : text.substr(pos + 1);
+        return field;
+    }
+
+    std::string_view nextLine(std::string_view& text)
+    {
+        const std::size_t pos = text.find('\n');
+        std::string_view line = text.substr(0, pos);
+        text = (pos == std::string_view::npos) ? std::string_view() : text.substr(pos + 1);
+        while (!line.empty() && line.back() == '\r')
+        {
+            line.remove_suffix(1); // Archivos con fin de línea de Windows.
+        }
+        return line;
+    }
+} // namespace Utils
@@ -0,0 +1,182 @@
+/**
+ * @file VirtualControlList.cpp
+ * @author Gabriel Nicolás González Ferreira (gabrielinuz@fi.mdp.edu.ar)
+ * @brief Implementación de la lista virtualizada de sliders.
+ * @version 2.4
+ * @date 2026-10-16
+ */
+#include "VirtualControlList.hpp"
+#include <FL/Fl.H>
+#include <algorithm>
+
+namespace
+{
+    constexpr int SCROLLBAR_WIDTH = 15;
+    constexpr int ROW_HEIGHT = 45; // Coincide con SliderControl::getHeight().
+}
+
+VirtualControlList::VirtualControlList(int x, int y, int w, int h,
+                                       std::shared_ptr<ParameterStore> store,
+                                       std::shared_ptr<MidiService> midiService,
+                                       unsigned char* currentMidiChannel)
+    : Fl_Group(x, y, w, h),
+      m_store(store),
+      m_midiService(midiService),
+      m_currentMidiChannel(currentMidiChannel),
+      m_scrollbar(nullptr),
+      m_firstRow(0)
+{
+    // Fondo opaco: al reasociar filas se redibuja todo el área sin restos de la anterior.
+    box(FL_FLAT_BOX);
+
+    m_scrollbar = new Fl_Scrollbar(x + w - SCROLLBAR_WIDTH, y, SCROLLBAR_WIDTH, h);
+    m_scrollbar->type(FL_VERTICAL);
+    m_scrollbar->linesize(1); // Una fila por paso.
+    m_scrollbar->callback(onScroll_static, this);
+    end();
+
+    updateScrollbar();
+}
+
+void VirtualControlList::reload()
+{
+    m_firstRow = 0;
+    rebuildPool();
+}
+
+void VirtualControlList::clearRows()
+{
+    for (auto& row : m_rows)
+    {
+        Fl_Widget* group = row->getWidgetGroup();
+        remove(group);
+        delete group;
+    }
+    m_rows.clear();
+    m_firstRow = 0;
+    updateScrollbar();
+    redraw();
+}
+
+void VirtualControlList::refresh()
+{
+    for (auto& row : m_rows)
+    {
+        row->refresh();
+    }
+}
+
+void VirtualControlList::resize(int x, int y, int w, int h)
+{
+    // No se usa Fl_Group::resize(): las filas no se escalan, se ubican a paso fijo.
+    Fl_Widget::resize(x, y, w, h);
+    m_scrollbar->resize(x + w - SCROLLBAR_WIDTH, y, SCROLLBAR_WIDTH, h);
+    for (std::size_t i = 0; i < m_rows.size(); ++i)
+    {
+        m_rows[i]->getWidgetGroup()->resize(x, y + static_cast<int>(i) * ROW_PITCH,
+                                            w - SCROLLBAR_WIDTH - 5, ROW_HEIGHT);
+    }
+    if (visible())
+    {
+        rebuildPool(); // Entran más o menos filas que antes. Oculta, reload() lo hará al mostrarse.
+    }
+}
+
+int VirtualControlList::handle(int event)
+{
+    if (event == FL_MOUSEWHEEL && Fl::event_dy() != 0 && m_store->size() > m_rows.size())
+    {
+        const long target = static_cast<long>(m_firstRow) + Fl::event_dy();
+        scrollTo(target < 0 ? 0 : static_cast<std::size_t>(target));
+        return 1;
+    }
+    return Fl_Group::handle(event);
+}
+
+void VirtualControlList::onScroll_static(Fl_Widget* w, void* userdata)
+{
+    auto* self = static_cast<VirtualControlList*>(userdata);
+    self->scrollTo(static_cast<std::size_t>(self->m_scrollbar->value()));
+}
+
+std::size_t VirtualControlList::visibleRows() const
+{
+    const int rows = h() / ROW_PITCH;
+    return rows > 0 ? static_cast<std::size_t>(rows) : 1;
+}
+
+void VirtualControlList::rebuildPool()
+{
+    const std::size_t target = std::min(visibleRows(), m_store->size());
+
+    while (m_rows.size() > target)
+    {
+        Fl_Widget* group = m_rows.back()->getWidgetGroup();
+        remove(group);
+        delete group;
+        m_rows.pop_back();
+    }
+
+    if (m_rows.size() < target)
+    {
+        // Las filas nuevas leen el almacén al crearse: al agrandar la ventana con la lista al
+        // final, primero se retrocede para que m_firstRow + slot siga dentro del almacén.
+        m_firstRow = std::min(m_firstRow, m_store->size() - target);
+        begin();
+        while (m_rows.size() < target)
+        {
+            const std::size_t slot = m_rows.size();
+            auto row = std::make_unique<SliderControl>(m_store, m_firstRow + slot, m_midiService);
+            row->setLearnMap(m_learnMap); /// @version 2.4
+            row->createWidgets(x(), y() + static_cast<int>(slot) * ROW_PITCH,
+                               w() - SCROLLBAR_WIDTH - 5, ROW_HEIGHT, m_currentMidiChannel);
+            m_rows.push_back(std::move(row));
+        }
+        end();
+    }
+
+    scrollTo(m_firstRow);
+}
+
+void VirtualControlList::scrollTo(std::size_t first)
+{
+    const std::size_t maxFirst = m_store->size() - m_rows.size();
+    m_firstRow = first < maxFirst ? first : maxFirst;
+
+    // Solo se reasocian las filas que cambiaron (ninguna si la posición es la misma).
+    for (std::size_t i = 0; i < m_rows.size(); ++i)
+    {
+        if (m_rows[i]->getIndex() != m_firstRow + i)
+        {
+            m_rows[i]->bind(m_firstRow + i);
+        }
+    }
+    updateScrollbar();
+    redraw();
+}
+
+void VirtualControlList::updateScrollbar()
+{
+    const int total = static_cast<int>(m_store->size());
+    const int window = static_cast<int>(m_rows.size());
+    m_scrollbar->value(static_cast<int>(m_firstRow), window, 0, total);
+    if (total > window)
+    {
+        m_scrollbar->activate();
+    }
+    else
+    {
+        m_scrollbar->deactivate();
+    }
+}
+
+/// --- @version 2.4: MIDI Learn ---
+
+void VirtualControlList::setLearnMap(std::shared_ptr<MidiLearnMap> learnMap)
+{
+    m_learnMap = learnMap;
+    for (auto& row : m_rows)
+    {
+        row->setLearnMap(learnMap);
+    }
+}
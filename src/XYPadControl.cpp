@@ -0,0 +1,313 @@
+/**
+ * @file XYPadControl.cpp
+ * @author Gabriel Nicolás González Ferreira (gabrielinuz@fi.mdp.edu.ar)
+ * @brief Implementación del pad XY: mezcla bilineal vectorizable y envío de los CC que cambiaron.
+ * @version 2.8
+ * @date 2026-10-16
+ */
+#include "XYPadControl.hpp"
+#include <cmath>
+
+namespace
+{
+    /// Resolución de cada eje en punto fijo: los pesos de las cuatro esquinas suman AXIS_ONE².
+    constexpr std::uint32_t AXIS_ONE = 256;
+    constexpr std::uint32_t WEIGHT_SHIFT = 16; // log2(AXIS_ONE * AXIS_ONE)
+    constexpr std::uint32_t WEIGHT_HALF = 1u << (WEIGHT_SHIFT - 1);
+
+    constexpr int BUTTON_HEIGHT = 25;
+    constexpr int BUTTON_WIDTH = 60;
+
+    const char* const CORNER_LABELS[XYPadControl::CORNERS] = {"Set A", "Set B", "Set C", "Set D"};
+
+    /** @brief Lleva una posición en [0, 1] a punto fijo en [0, AXIS_ONE]. */
+    std::uint32_t toFixed(double t)
+    {
+        if (!(t > 0.0)) return 0; // También descarta NaN.
+        if (t >= 1.0) return AXIS_ONE;
+        return static_cast<std::uint32_t>(std::lround(t * AXIS_ONE));
+    }
+}
+
+XYPadControl::XYPadControl(std::shared_ptr<ParameterStore> store, std::shared_ptr<MidiService> midiService)
+    : m_store(store),
+      m_midiService(midiService),
+      m_currentMidiChannel(nullptr),
+      m_active(true),
+      m_corners{},
+      m_assigned{},
+      m_maskBits{},
+      m_mask{},
+      m_blended{},
+      m_changed{},
+      m_lastSentCount(0),
+      m_group(nullptr),
+      m_pad(nullptr),
+      m_cornerButtons{}
+{
+    m_lastSent.fill(UNKNOWN_VALUE);
+}
+
+void XYPadControl::createWidgets(int x, int y, int w, int h, unsigned char* currentMidiChannel)
+{
+    m_currentMidiChannel = currentMidiChannel;
+
+    m_group = new Fl_Group(x, y, w, h);
+    m_group->begin();
+
+    // Botones de asignación en las esquinas correspondientes: A y B arriba, C y D abajo.
+    const int bottom_y = y + h - BUTTON_HEIGHT;
+    const int right_x = x + w - BUTTON_WIDTH;
+    const int positions[CORNERS][2] = {{x, y}, {right_x, y}, {x, bottom_y}, {right_x, bottom_y}};
+    for (int corner = 0; corner < CORNERS; ++corner)
+    {
+        m_cornerButtons[corner] = new Fl_Button(positions[corner][0], positions[corner][1],
+                                                BUTTON_WIDTH, BUTTON_HEIGHT, CORNER_LABELS[corner]);
+        m_cornerButtons[corner]->callback(onAssignCorner_static, this);
+        m_cornerButtons[corner]->tooltip("Assign the current control values to this corner");
+    }
+
+    m_pad = new Fl_Positioner(x, y + BUTTON_HEIGHT + 5, w, h - 2 * (BUTTON_HEIGHT + 5));
+    m_pad->xbounds(0.0, 1.0);
+    m_pad->ybounds(0.0, 1.0); // 0 arriba, 1 abajo, como las coordenadas de FLTK.
+    m_pad->value(0.0, 0.0);   // Arranca en la esquina A.
+    m_pad->callback(onPadMoved_static, this);
+    m_pad->tooltip("Assign the four corners, then drag to blend them");
+
+    m_group->end();
+    m_group->resizable(m_pad);
+
+    refresh();
+}
+
+Fl_Widget* XYPadControl::getWidgetGroup()
+{
+    return m_group;
+}
+
+int XYPadControl::getHeight() const
+{
+    return m_group ? m_group->h() : 0;
+}
+
+int XYPadControl::getCcNumber() const
+{
+    return -1;
+}
+
+std::string XYPadControl::getDescription() const
+{
+    return "XY Morph Pad";
+}
+
+std::string XYPadControl::getRange() const
+{
+    return "0-127";
+}
+
+int XYPadControl::getCurrentValue() const
+{
+    return m_pad ? static_cast<int>(std::lround(m_pad->xvalue() * 127.0)) : 0;
+}
+
+void XYPadControl::setCurrentValue(int value)
+{
+    if (m_pad)
+    {
+        m_pad->xvalue(value / 127.0);
+    }
+}
+
+void XYPadControl::setActive(bool active)
+{
+    m_active = active;
+    refresh();
+}
+
+bool XYPadControl::isActive() const
+{
+    return m_active;
+}
+
+void XYPadControl::refresh()
+{
+    if (!m_pad)
+    {
+        return;
+    }
+    // El cursor solo se habilita cuando hay algo para mezclar.
+    if (m_active && isReady())
+    {
+        m_pad->activate();
+    }
+    else
+    {
+        m_pad->deactivate();
+    }
+    for (int corner = 0; corner < CORNERS; ++corner)
+    {
+        m_cornerButtons[corner]->labelfont(m_assigned[corner] ? FL_HELVETICA_BOLD : FL_HELVETICA);
+        m_cornerButtons[corner]->redraw();
+    }
+    m_pad->redraw();
+}
+
+void XYPadControl::assignCorner(int corner, const PresetImage& preset)
+{
+    if (corner < 0 || corner >= CORNERS)
+    {
+        return;
+    }
+    m_corners[corner] = preset;
+    m_assigned[corner] = true;
+    updateMask();
+    m_lastSent.fill(UNKNOWN_VALUE);
+}
+
+bool XYPadControl::isReady() const
+{
+    for (bool assigned : m_assigned)
+    {
+        if (!assigned) return false;
+    }
+    return true;
+}
+
+void XYPadControl::updateMask()
+{
+    // Intersección de los bitmaps de presencia y activación de las cuatro esquinas.
+    for (std::size_t word = 0; word < m_maskBits.size(); ++word)
+    {
+        std::uint64_t bits = ~std::uint64_t(0);
+        for (const PresetImage& corner : m_corners)
+        {
+            bits &= corner.present[word] & corner.active[word];
+        }
+        m_maskBits[word] = bits;
+    }
+    // Expandido a un byte por CC para que los bucles de moveTo() no tengan ramas.
+    for (std::size_t cc = 0; cc < PresetImage::CONTROLLERS; ++cc)
+    {
+        m_mask[cc] = static_cast<unsigned char>((m_maskBits[cc >> 6] >> (cc & 63)) & 1u);
+    }
+}
+
+std::size_t XYPadControl::moveTo(double x, double y)
+{
+    m_lastSentCount = 0;
+    if (!isReady())
+    {
+        return 0;
+    }
+
+    // Pesos bilineales en punto fijo; suman exactamente AXIS_ONE².
+    const std::uint32_t xi = toFixed(x);
+    const std::uint32_t yi = toFixed(y);
+    const std::uint32_t weightA = (AXIS_ONE - xi) * (AXIS_ONE - yi);
+    const std::uint32_t weightB = xi * (AXIS_ONE - yi);
+    const std::uint32_t weightC = (AXIS_ONE - xi) * yi;
+    const std::uint32_t weightD = xi * yi;
+
+    // 1. Mezcla: un bucle de longitud fija, sin ramas, sobre arreglos contiguos (vectorizable).
+    //    Es una combinación convexa, así que el resultado queda dentro del rango de las esquinas.
+    const auto& a = m_corners[0].values;
+    const auto& b = m_corners[1].values;
+    const auto& c = m_corners[2].values;
+    const auto& d = m_corners[3].values;
+    for (std::size_t cc = 0; cc < PresetImage::CONTROLLERS; ++cc)
+    {
+        m_blended[cc] = static_cast<std::uint16_t>(
+            (a[cc] * weightA + b[cc] * weightB + c[cc] * weightC + d[cc] * weightD + WEIGHT_HALF) >> WEIGHT_SHIFT);
+    }
+
+    // 2. Qué CC cambiaron desde el último envío (también sin ramas).
+    for (std::size_t cc = 0; cc < PresetImage::CONTROLLERS; ++cc)
+    {
+        m_changed[cc] = static_cast<unsigned char>((m_blended[cc] != m_lastSent[cc]) & m_mask[cc]);
+    }
+
+    // 3. Armar el lote y el preset parcial con lo que cambió.
+    //    @version 2.7: Cada CC# sale por el canal de su control, agrupado por canal (running status).
+    const unsigned char channel = m_currentMidiChannel ? *m_currentMidiChannel : 0;
+    std::array<std::size_t, 16> offset{};
+    std::size_t count = 0;
+    for (std::size_t cc = 0; cc < PresetImage::CONTROLLERS; ++cc)
+    {
+        offset[m_store->channelForCc(static_cast<int>(cc), channel)] += m_changed[cc] * (1u + m_store->isHighResolutionCc(static_cast<int>(cc)));
+    }
+    for (std::size_t& slot : offset)
+    {
+        const std::size_t channelCount = slot;
+        slot = count;
+        count += channelCount;
+    }
+    if (count == 0)
+    {
+        return 0;
+    }
+
+    PresetImage changed;
+    for (std::size_t cc = 0; cc < PresetImage::CONTROLLERS; ++cc)
+    {
+        if (m_changed[cc])
+        {
+            const std::uint16_t value = m_blended[cc];
+            const unsigned char target = m_store->channelForCc(static_cast<int>(cc), channel);
+            if (m_store->isHighResolutionCc(static_cast<int>(cc)))
+            {
+                /// @version 2.8: Par MSB/LSB; MidiService omite el MSB si no cambió.
+                offset[target] += MidiMessage::controlChange14(target, static_cast<unsigned char>(cc), value, &m_batch[offset[target]]);
+            }
+            else
+            {
+                m_batch[offset[target]++] = MidiMessage::controlChange(target, static_cast<unsigned char>(cc), static_cast<unsigned char>(value));
+            }
+            changed.set(static_cast<int>(cc), value, true);
+            m_lastSent[cc] = value;
+        }
+    }
+
+    m_store->applyPreset(changed);
+    if (m_midiService)
+    {
+        m_midiService->sendBatch(m_batch.data(), count);
+    }
+    m_lastSentCount = count;
+    return count;
+}
+
+// --- Lógica de Callbacks ---
+
+void XYPadControl::onPadMoved_static(Fl_Widget* w, void* userdata)
+{
+    static_cast<XYPadControl*>(userdata)->onPadMoved();
+}
+
+void XYPadControl::onPadMoved()
+{
+    if (!m_active)
+    {
+        return;
+    }
+    if (moveTo(m_pad->xvalue(), m_pad->yvalue()) > 0)
+    {
+        m_group->do_callback(); // Avisar a la ventana para que refresque los sliders.
+    }
+}
+
+void XYPadControl::onAssignCorner_static(Fl_Widget* w, void* userdata)
+{
+    static_cast<XYPadControl*>(userdata)->onAssignCorner(w);
+}
+
+void XYPadControl::onAssignCorner(Fl_Widget* button)
+{
+    for (int corner = 0; corner < CORNERS; ++corner)
+    {
+        if (m_cornerButtons[corner] == button)
+        {
+            assignCorner(corner, m_store->snapshot());
+        }
+    }
+    refresh();
+}
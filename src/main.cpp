@@ -8,10 +8,23 @@
  * * @link http://www.apache.org/licenses/LICENSE-2.0
  * */
 
+#include "HeadlessRunner.hpp" // @version 3.2: Recall de presets sin ventana
+#ifndef MCCC_HEADLESS_ONLY
 #include "Application.hpp"
+#endif
 
 int main(int argc, char** argv) 
 {
+    /// @version 3.2: Con --headless no se crea la GUI (ni se inicializa FLTK); ver HeadlessRunner.
+    /// El binario mccc-headless (build.sh, -DMCCC_HEADLESS_ONLY) no enlaza FLTK en absoluto.
+#ifdef MCCC_HEADLESS_ONLY
+    return HeadlessRunner::run(argc, argv);
+#else
+    if (HeadlessRunner::isRequested(argc, argv))
+    {
+        return HeadlessRunner::run(argc, argv);
+    }
     auto app = std::make_unique<Application>();
     return app->run(argc, argv);
+#endif
 }
\ No newline at end of file